@@ -0,0 +1,105 @@
+/**
+ *  file: DAQNodeTable.hh
+ *  date: 2026.10.17
+ *
+ */
+
+#ifndef DAQ_NODE_TABLE_HH
+#define DAQ_NODE_TABLE_HH
+
+#include <string>
+#include <vector>
+
+#include <DAQNode.hh>
+
+//______________________________________________________________________________
+// Front-end nodes of the event builder classified by type from their
+// names, once per run instead of once per event.
+//
+//   DAQNodeTable& table = DAQNodeTable::GetInstance();
+//   table.Update();                  // or table.Update( snapshot )
+//   table.FillDataSize( gUnpacker, DAQNodeTable::kVME, h );
+//
+// Update() only compares the node IDs with the last event and classifies
+// the names again if they differ. FillDataSize() fills (index in the
+// type, data size) of each node of the type, the index as it used to be
+// in the per-event vectors, i.e. in the order of the child list.
+// A node may have several types, e.g. "vmeeasiroc" is kVME and kEASIROC.
+// One table per thread, so the workers of EventPipeline may use it on
+// their own snapshots.
+class DAQNodeTable
+{
+public:
+  static DAQNodeTable& GetInstance( void );
+  ~DAQNodeTable( void );
+
+private:
+  DAQNodeTable( void );
+  DAQNodeTable( const DAQNodeTable& );
+  DAQNodeTable& operator =( const DAQNodeTable& );
+
+public:
+  enum ENodeType { kVME, kHUL, kEASIROC, kCoBo, kAFT, kNNodeType };
+
+private:
+  std::vector<int> m_node_id;              // children of the root node
+  std::vector<int> m_type_id[kNNodeType];
+  int              m_n_update;             // classifications done
+
+public:
+  const std::vector<int>& GetNodeList( ENodeType type ) const
+  { return m_type_id[type]; }
+  int  GetNumOfUpdate( void ) const { return m_n_update; }
+  // from GUnpacker
+  bool Update( void );
+  // from an EventSnapshot, node 0 is the root node
+  template <typename Event>
+  bool Update( const Event& event );
+  // Event is GUnpacker or EventSnapshot, Hist is a TH2 or a HistShard
+  // of one, returns the sum of the sizes
+  template <typename Event, typename Hist>
+  unsigned int FillDataSize( const Event& event, ENodeType type,
+			     Hist* h ) const;
+
+private:
+  void Classify( int id, const std::string& name );
+  void Clear( void );
+};
+
+//______________________________________________________________________________
+template <typename Event>
+bool
+DAQNodeTable::Update( const Event& event )
+{
+  const int n = event.get_n_node()-1;
+  bool is_same = ( n==static_cast<int>(m_node_id.size()) );
+  for( int i=0; is_same && i<n; ++i )
+    is_same = ( m_node_id[i]==event.get_node_id(i+1) );
+  if( is_same )
+    return false;
+
+  Clear();
+  for( int i=0; i<n; ++i )
+    Classify( event.get_node_id(i+1), event.get_node_name(i+1) );
+  ++m_n_update;
+  return true;
+}
+
+//______________________________________________________________________________
+template <typename Event, typename Hist>
+unsigned int
+DAQNodeTable::FillDataSize( const Event& event, ENodeType type,
+			    Hist* h ) const
+{
+  const std::vector<int>& id = m_type_id[type];
+  unsigned int sum = 0;
+  for( int i=0, n=id.size(); i<n; ++i ){
+    const unsigned int data_size
+      = event.get_node_header( id[i], hddaq::unpacker::DAQNode::k_data_size );
+    h->Fill( i, data_size );
+    sum += data_size;
+  }
+  return sum;
+}
+
+#endif
@@ -8,6 +8,7 @@
 #define DC_ANALYZER_HH
 
 #include "DetectorID.hh"
+#include "EventArena.hh"
 #include "ThreeVector.hh"
 #include <vector>
 
@@ -42,6 +43,8 @@ typedef std::vector<FiberCluster*> CFTFiberClusterContainer;
 class DCAnalyzer
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   DCAnalyzer( void );
   ~DCAnalyzer( void );
 
@@ -7,19 +7,20 @@
 #ifndef DC_DRIFT_PARAM_MAN_HH
 #define DC_DRIFT_PARAM_MAN_HH
 
-#include <map>
 #include <string>
 #include <vector>
 
+#include "DenseParamTable.hh"
+
 struct DCDriftParamRecord;
 
 //______________________________________________________________________________
 struct DCDriftParamRecord
 {
-  int type, np;
+  int plane, type, np;
   std::vector<double> param;
-  DCDriftParamRecord( int t, int n, std::vector<double> p )
-    : type(t), np(n), param(p)
+  DCDriftParamRecord( int pl, int t, int n, std::vector<double> p )
+    : plane(pl), type(t), np(n), param(p)
   {}
 };
 
@@ -37,14 +38,16 @@ private:
   DCDriftParamMan& operator =( const DCDriftParamMan& );
 
 private:
-  typedef std::map<unsigned int, DCDriftParamRecord*> DCDriftContainer;
-  typedef DCDriftContainer::const_iterator DCDriftIterator;
+  typedef DenseParamTable<DCDriftParamRecord> DCDriftContainer;
   bool             m_is_ready;
   std::string      m_file_name;
   DCDriftContainer m_container;
 
 public:
   bool CalcDrift( int PlaneId, double WireId, double ctime, double & dt, double & dl ) const;
+  // record index for CalcDrift( index, ... ), -1 (reported) if no record
+  int  GetIndex( int PlaneId, double WireId ) const;
+  bool CalcDrift( int index, double ctime, double & dt, double & dl ) const;
   bool Initialize( void );
   bool Initialize( const std::string& file_name );
   bool IsReady( void ) const { return m_is_ready; }
@@ -65,7 +68,9 @@ private:
   static double       DriftLength7( int PlaneId,
 				    double dt, double p1, double p2, double p3,
 				    double p4, double p5, double p6 );
-  DCDriftParamRecord* GetParameter( int PlaneId, double WireId ) const;
+  const DCDriftParamRecord* GetParameter( int PlaneId, double WireId ) const;
+  bool                CalcDrift( const DCDriftParamRecord& record,
+				 double ctime, double & dt, double & dl ) const;
 };
 
 //______________________________________________________________________________
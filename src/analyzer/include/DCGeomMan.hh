@@ -32,9 +32,11 @@ private:
   typedef DCGeomContainer::const_iterator DCGeomIterator;
   typedef std::map <std::string, int>     IntList;
   typedef std::map <std::string, double>  DoubleList;
+  typedef std::vector<DCGeomRecord*>      DCGeomTable;
   bool            m_is_ready;
   std::string     m_file_name;
   DCGeomContainer m_container;
+  DCGeomTable     m_table;   // m_container indexed by layer id
   IntList         m_detector_id_map;
   DoubleList      m_global_z_map;
   DoubleList      m_local_z_map;
@@ -42,6 +42,10 @@ private:
   double      m_w0;
   double      m_dd;
   double      m_offset;
+  // for the local track fit
+  double      m_cos_tilt;
+  double      m_sin_tilt;
+  double      m_weight;   // 1/resolution^2
 
   double m_dxds, m_dxdt, m_dxdu;
   double m_dyds, m_dydt, m_dydu;
@@ -63,7 +67,11 @@ public:
   double             RotationAngle2( void ) const { return m_rot_angle2; }
   double             Length( void )         const { return m_length;     }
   double             Resolution( void )     const { return m_resolution; }
-  void               SetResolution( double res )  { m_resolution = res;  }
+  double             CosTilt( void )        const { return m_cos_tilt;   }
+  double             SinTilt( void )        const { return m_sin_tilt;   }
+  double             Weight( void )         const { return m_weight;     }
+  void               SetResolution( double res )
+  { m_resolution = res; m_weight = 1./(res*res); }
 
   double dsdx( void ) const { return m_dsdx; }
   double dsdy( void ) const { return m_dsdy; }
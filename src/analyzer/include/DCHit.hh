@@ -19,6 +19,7 @@
 #include <std_ostream.hh>
 
 #include "DebugCounter.hh"
+#include "EventArena.hh"
 
 //typedef std::vector<bool>   BoolVec;
 typedef std::deque<bool>    BoolVec;
@@ -31,6 +32,8 @@ class DCLTrackHit;
 class DCHit
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   DCHit( void );
   DCHit( int layer );
   DCHit( int layer, double wire );
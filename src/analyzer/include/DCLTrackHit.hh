@@ -8,6 +8,7 @@
 #define DC_LTRACK_HIT_HH
 
 #include "DCHit.hh"
+#include "EventArena.hh"
 
 #include "MathTools.hh"
 
@@ -17,6 +18,8 @@ class DCAnalyzer;
 class DCLTrackHit
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   DCLTrackHit( DCHit *hit, double pos, int nh );
   DCLTrackHit( const DCLTrackHit& right );
 
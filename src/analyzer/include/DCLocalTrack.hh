@@ -15,6 +15,7 @@
 #include "ThreeVector.hh"
 #include "DCLTrackHit.hh"
 #include "DetectorID.hh"
+#include "EventArena.hh"
 
 class DCLTrackHit;
 class DCAnalyzer;
@@ -25,6 +26,8 @@ const double MaxChi2CFT  = 300.;
 class DCLocalTrack
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   explicit DCLocalTrack( void );
   ~DCLocalTrack( void );
 
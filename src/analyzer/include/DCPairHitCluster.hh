@@ -7,12 +7,16 @@
 #ifndef DC_PAIR_HIT_CLUSTER_HH
 #define DC_PAIR_HIT_CLUSTER_HH
 
+#include "EventArena.hh"
+
 class DCLTrackHit;
 
 //______________________________________________________________________________
 class DCPairHitCluster
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   DCPairHitCluster( DCLTrackHit *hitA, DCLTrackHit *hitB=0 );
   ~DCPairHitCluster( void );
 
@@ -11,12 +11,16 @@
 #include <string>
 #include <vector>
 
+#include "EventArena.hh"
+
 typedef std::vector<int> IntVec;
 
 //______________________________________________________________________________
 class DCRawHit
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   DCRawHit( int plane_id, int wire_id );
   ~DCRawHit( void );
 
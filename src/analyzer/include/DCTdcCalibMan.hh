@@ -7,11 +7,19 @@
 #ifndef DC_TDC_CALIB_MAN_HH
 #define DC_TDC_CALIB_MAN_HH
 
-#include <map>
 #include <string>
 #include <vector>
 
-struct DCTdcCalMap;
+#include "DenseParamTable.hh"
+
+//______________________________________________________________________________
+struct DCTdcCalMap
+{
+  double p0, p1;
+  DCTdcCalMap( double q0, double q1 )
+    : p0(q0), p1(q1)
+  {}
+};
 
 //______________________________________________________________________________
 class DCTdcCalibMan
@@ -27,8 +35,7 @@ private:
   DCTdcCalibMan& operator =( const DCTdcCalibMan & );
 
 private:
-  typedef std::map <unsigned int, DCTdcCalMap*> DCTdcContainer;
-  typedef DCTdcContainer::const_iterator DCTdcIterator;
+  typedef DenseParamTable<DCTdcCalMap> DCTdcContainer;
   bool           m_is_ready;
   std::string    m_file_name;
   DCTdcContainer m_container;
@@ -38,6 +45,9 @@ public:
   bool Initialize( const std::string& file_name );
   bool IsReady( void ) const { return m_is_ready; }
   bool GetTime( int plane_id, double wire_id, int tdc, double& time ) const;
+  // record index for GetTime( index, ... ), -1 (reported) if no record
+  int  GetIndex( int plane_id, double wire_id ) const;
+  bool GetTime( int index, int tdc, double& time ) const;
   bool GetTdc( int plane_id, double wire_id, double time, int& tdc ) const;
   void SetFileName( const std::string& file_name ) { m_file_name = file_name; }
 
@@ -45,7 +55,7 @@ public:
                      double &p0, double &p1 ) const;
 
 private:
-  DCTdcCalMap* GetMap( int plane_id, double wire_id ) const;
+  const DCTdcCalMap* GetMap( int plane_id, double wire_id ) const;
   void         ClearElements( void );
 };
 
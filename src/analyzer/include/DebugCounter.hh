@@ -7,7 +7,8 @@
 #ifndef DEBUG_COUNTER_HH
 #define DEBUG_COUNTER_HH
 
-#include <map>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <TObject.h>
@@ -15,6 +16,17 @@
 #include <std_ostream.hh>
 
 //_____________________________________________________________________
+// Live objects per class, to find leaks.
+// Each counted class defines one Counter next to its class_name,
+//
+//   debug::ObjectCounter::Counter gCounter( class_name );
+//
+// which registers itself when the library is loaded, and calls
+// increase(gCounter)/decrease(gCounter) in its constructors and
+// destructor. The counts are atomic, so the hits may be created on any
+// thread.
+// Only the debug build (make DEBUG=1, -DMemoryLeak) counts anything,
+// otherwise every call is empty and Counter holds no data.
 namespace debug
 {
   class ObjectCounter
@@ -28,18 +40,48 @@ namespace debug
     ObjectCounter( const ObjectCounter& );
     ObjectCounter& operator =( const ObjectCounter& );
 
+  public:
+    class Counter
+    {
+    public:
+      explicit Counter( const std::string& key );
+      ~Counter( void );
+
+    private:
+      Counter( const Counter& );
+      Counter& operator =( const Counter& );
+
+#ifdef MemoryLeak
+    private:
+      std::string       m_key;
+      std::atomic<long> m_count;
+
+    public:
+      long               count( void ) const
+      { return m_count.load( std::memory_order_relaxed ); }
+      const std::string& key( void ) const { return m_key; }
+      void               decrease( void )
+      { m_count.fetch_sub( 1, std::memory_order_relaxed ); }
+      void               increase( void )
+      { m_count.fetch_add( 1, std::memory_order_relaxed ); }
+#endif
+    };
+
   private:
-    typedef std::map<std::string,int> ObjectMap;
-    typedef ObjectMap::const_iterator ObjectIter;
-    ObjectMap m_map;
+    std::vector<const Counter*> m_counter; //!
+    mutable std::mutex          m_mutex;   //!
 
   public:
     void check( const std::string& arg="" ) const;
     void print( const std::string& arg="" ) const;
 
   public:
-    static void decrease( const std::string& key );
-    static void increase( const std::string& key );
+    static void decrease( Counter& counter );
+    static void increase( Counter& counter );
+
+  private:
+    void add( const Counter* counter );
+    void remove( const Counter* counter );
 
     ClassDef(ObjectCounter,0);
   };
@@ -54,22 +96,28 @@ namespace debug
 
   //_____________________________________________________________________
   inline void
-  ObjectCounter::decrease( const std::string& key )
+  ObjectCounter::decrease( Counter& counter )
   {
 #ifdef MemoryLeak
-    --(GetInstance().m_map[key]);
+    counter.decrease();
 #endif
   }
 
   //_____________________________________________________________________
   inline void
-  ObjectCounter::increase( const std::string& key )
+  ObjectCounter::increase( Counter& counter )
   {
 #ifdef MemoryLeak
-    ++(GetInstance().m_map[key]);
+    counter.increase();
 #endif
   }
 
+#ifndef MemoryLeak
+  //_____________________________________________________________________
+  inline ObjectCounter::Counter::Counter( const std::string& ) {}
+  inline ObjectCounter::Counter::~Counter( void ) {}
+#endif
+
 }
 
 #endif
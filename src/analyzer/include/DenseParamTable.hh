@@ -0,0 +1,188 @@
+/**
+ *  file: DenseParamTable.hh
+ *  date: 2026.10.17
+ *
+ */
+
+#ifndef DENSE_PARAM_TABLE_HH
+#define DENSE_PARAM_TABLE_HH
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+//______________________________________________________________________________
+// Calibration records keyed by (cid, plid, seg, ud).
+// Records are staged with Add() while the parameter file is read, then
+// Build() compiles them into one index box per cid (the plid/seg/ud range
+// actually used) and a contiguous value array, so Get() is a few range
+// checks and two array reads instead of a tree walk.
+// A caller that reads the same channel many times resolves it once with
+// Find() and then reads At(index), which is a single array access. The
+// index is valid until the next Build() or Clear().
+template <typename T>
+class DenseParamTable
+{
+public:
+  DenseParamTable( void );
+  ~DenseParamTable( void );
+
+private:
+  struct Box
+  {
+    int         plid0, n_plid;
+    int         seg0, n_seg;
+    int         ud0, n_ud;
+    std::size_t offset;
+  };
+  struct Key
+  {
+    int cid, plid, seg, ud;
+    bool operator <( const Key& k ) const
+    {
+      if( cid!=k.cid )   return cid<k.cid;
+      if( plid!=k.plid ) return plid<k.plid;
+      if( seg!=k.seg )   return seg<k.seg;
+      return ud<k.ud;
+    }
+  };
+
+  std::map<Key, T>  m_staging;
+  int               m_cid0;
+  std::vector<Box>  m_box;    // [cid-m_cid0]
+  std::vector<int>  m_index;  // -1 if no record
+  std::vector<T>    m_value;
+
+public:
+  bool     Add( int cid, int plid, int seg, int ud, const T& value );
+  void     Build( void );
+  void     Clear( void );
+  const T* Get( int cid, int plid, int seg, int ud ) const;
+  // -1 if no record
+  int      Find( int cid, int plid, int seg, int ud ) const;
+  const T* At( int index ) const
+  { return ( index<0 ) ? 0 : &m_value[index]; }
+  bool     IsEmpty( void ) const { return m_value.empty(); }
+};
+
+//______________________________________________________________________________
+template <typename T>
+inline
+DenseParamTable<T>::DenseParamTable( void )
+  : m_staging(), m_cid0(0), m_box(), m_index(), m_value()
+{
+}
+
+//______________________________________________________________________________
+template <typename T>
+inline
+DenseParamTable<T>::~DenseParamTable( void )
+{
+}
+
+//______________________________________________________________________________
+// returns false if a record of the same key is replaced
+template <typename T>
+inline bool
+DenseParamTable<T>::Add( int cid, int plid, int seg, int ud, const T& value )
+{
+  Key key = { cid, plid, seg, ud };
+  typename std::map<Key, T>::iterator itr = m_staging.find( key );
+  if( itr!=m_staging.end() ){
+    itr->second = value;
+    return false;
+  }
+  m_staging.insert( std::make_pair( key, value ) );
+  return true;
+}
+
+//______________________________________________________________________________
+template <typename T>
+inline void
+DenseParamTable<T>::Build( void )
+{
+  m_box.clear();
+  m_index.clear();
+  m_value.clear();
+  if( m_staging.empty() )
+    return;
+
+  typedef typename std::map<Key, T>::const_iterator Iterator;
+  const Iterator begin = m_staging.begin(), end = m_staging.end();
+  m_cid0 = begin->first.cid;
+  const int n_cid = m_staging.rbegin()->first.cid - m_cid0 + 1;
+  Box empty = { 0, 0, 0, 0, 0, 0, 0 };
+  m_box.assign( n_cid, empty );
+
+  // staging is sorted by cid, so each cid is one contiguous run
+  for( Iterator first=begin; first!=end; ){
+    const int cid = first->first.cid;
+    int plid0 = first->first.plid, plid1 = plid0;
+    int seg0 = first->first.seg, seg1 = seg0;
+    int ud0 = first->first.ud, ud1 = ud0;
+    Iterator last = first;
+    for( ; last!=end && last->first.cid==cid; ++last ){
+      const Key& k = last->first;
+      plid1 = std::max( plid1, k.plid );
+      seg0  = std::min( seg0, k.seg );  seg1 = std::max( seg1, k.seg );
+      ud0   = std::min( ud0, k.ud );    ud1  = std::max( ud1, k.ud );
+    }
+    Box& box  = m_box[cid-m_cid0];
+    box.plid0 = plid0; box.n_plid = plid1-plid0+1;
+    box.seg0  = seg0;  box.n_seg  = seg1-seg0+1;
+    box.ud0   = ud0;   box.n_ud   = ud1-ud0+1;
+    box.offset = m_index.size();
+    m_index.resize( m_index.size()
+		    + std::size_t(box.n_plid)*box.n_seg*box.n_ud, -1 );
+    for( ; first!=last; ++first ){
+      const Key& k = first->first;
+      std::size_t i = box.offset
+	+ ( std::size_t(k.plid-plid0)*box.n_seg + (k.seg-seg0) )*box.n_ud
+	+ (k.ud-ud0);
+      m_index[i] = m_value.size();
+      m_value.push_back( first->second );
+    }
+  }
+
+  m_staging.clear();
+}
+
+//______________________________________________________________________________
+template <typename T>
+inline void
+DenseParamTable<T>::Clear( void )
+{
+  m_staging.clear();
+  m_box.clear();
+  m_index.clear();
+  m_value.clear();
+}
+
+//______________________________________________________________________________
+template <typename T>
+inline const T*
+DenseParamTable<T>::Get( int cid, int plid, int seg, int ud ) const
+{
+  return At( Find( cid, plid, seg, ud ) );
+}
+
+//______________________________________________________________________________
+template <typename T>
+inline int
+DenseParamTable<T>::Find( int cid, int plid, int seg, int ud ) const
+{
+  const unsigned int c = cid - m_cid0;
+  if( c>=m_box.size() )
+    return -1;
+  const Box& box = m_box[c];
+  const unsigned int p = plid - box.plid0;
+  const unsigned int s = seg - box.seg0;
+  const unsigned int u = ud - box.ud0;
+  if( p>=(unsigned int)box.n_plid ||
+      s>=(unsigned int)box.n_seg ||
+      u>=(unsigned int)box.n_ud )
+    return -1;
+  return m_index[box.offset + ( std::size_t(p)*box.n_seg + s )*box.n_ud + u];
+}
+
+#endif
@@ -0,0 +1,261 @@
+/**
+ *  file: DetectorMonitor.hh
+ *  date: 2026.10.17
+ *
+ */
+
+#ifndef DETECTOR_MONITOR_HH
+#define DETECTOR_MONITOR_HH
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "EventSnapshot.hh"
+
+//______________________________________________________________________________
+// Raw histograms of the hodoscope-like detectors filled from a table
+// instead of a hand-written block per detector and per experiment.
+// A detector is declared once with its names in DetectorID.hh and
+// HistMaker,
+//
+//   const DetectorMonitor::Spec spec =
+//     { "BH1", kBH1, NumOfSegBH1, kUorD, DetectorMonitor::kHodoscope };
+//   DetectorMonitor::GetInstance().Add( spec );   // in process_begin()
+//
+// and Add() resolves the device and data IDs of the unpacker, the TDC
+// window ("Tdc"+device in UserParamMan unless spec.window is given)
+// and the sequential IDs of HistMaker (detector, 0, kADC/kTDC/kADCwTDC/
+// kHitPat/kMulti) once. Fill() then runs the same loop for every
+// detector,
+//
+//   for each segment, U/D:
+//     ADC       first ADC if any
+//     TDC       every TDC (non-zero with kGateADC)
+//     ADCwTDC   ADC if a TDC is inside the window (and ADC>0 with
+//               kGateADC)
+//   HitPat      segments with a hit in every U/D
+//   Multi       number of those segments
+//
+// with histogram index (HistMaker ID)+ud*n_segment+segment, as the
+// per-experiment loops did. kHodoscope is the BH1/BH2/TOF block,
+// kCounter the BAC one and kTdcCounter the BVH one; a detector with
+// fewer histograms (T1, TF_GN1, ...) passes its own EHist bits.
+// Fill() works on GUnpacker or on an EventSnapshot, and on the TH1 or
+// HistShard array of the program. On a snapshot it only visits the
+// non-empty channels of a device registered with its hit rows
+// (EventSnapshot::registerDevice(..., true)), and reads the others
+// channel by channel.
+// The table is built before the event loop and only read afterwards,
+// so the workers of EventPipeline may fill from it at the same time.
+class DetectorMonitor
+{
+public:
+  static DetectorMonitor& GetInstance( void );
+  ~DetectorMonitor( void );
+
+private:
+  DetectorMonitor( void );
+  DetectorMonitor( const DetectorMonitor& );
+  DetectorMonitor& operator =( const DetectorMonitor& );
+
+public:
+  enum EHist
+    {
+      kFillADC     = 1<<0,
+      kFillTDC     = 1<<1,
+      kFillADCwTDC = 1<<2,
+      kFillHitPat  = 1<<3,
+      kFillMulti   = 1<<4,
+      // zero TDC words are skipped and a hit also needs ADC>0
+      kGateADC     = 1<<5,
+      // ADC and TDC of every segment and U/D
+      kCounter     = kFillADC|kFillTDC|kFillADCwTDC|kFillHitPat|kFillMulti,
+      kHodoscope   = kCounter|kGateADC,
+      // TDC only, the window alone makes a hit
+      kTdcCounter  = kFillTDC|kFillHitPat|kFillMulti
+    };
+
+  struct Spec
+  {
+    std::string device;     // in the unpacker
+    int         detector;   // HistMaker detector type
+    int         n_segment;
+    int         n_ud;       // 1 or kUorD
+    int         hist;       // EHist
+    // optional, "tdc" and "Tdc"+device if empty
+    std::string tdc;        // TDC data name in the unpacker
+    std::string window;     // TDC window in UserParamMan
+  };
+
+private:
+  struct Detector
+  {
+    std::string name;
+    int         device_id;
+    int         adc_id;     // -1 without ADC
+    int         tdc_id;
+    int         n_segment;
+    int         n_ud;
+    bool        gate_adc;
+    double      tdc_min;
+    double      tdc_max;
+    // sequential IDs, -1 if not filled
+    int         adc_hid;
+    int         tdc_hid;
+    int         awt_hid;
+    int         hit_hid;
+    int         mul_hid;
+  };
+  std::vector<Detector> m_detector;
+
+public:
+  // index for Fill(), -1 if the device is unknown
+  int  Add( const Spec& spec );
+  int  GetIndex( const std::string& device ) const;
+  // multiplicity, the hit segments are added to hitseg
+  template <typename Event, typename HistArray>
+  int  Fill( int index, const Event& event, HistArray& hptr_array,
+	     std::vector<int>& hitseg ) const;
+  template <typename HistArray>
+  int  Fill( int index, const analyzer::EventSnapshot& event,
+	     HistArray& hptr_array, std::vector<int>& hitseg ) const;
+
+private:
+  template <typename Event, typename HistArray>
+  int  FillEntries( const Detector& d, const Event& event,
+		    HistArray& hptr_array, std::vector<int>& hitseg ) const;
+  template <typename HistArray>
+  int  FillHitPat( const Detector& d, const std::vector<unsigned int>& adc,
+		   const std::vector<char>& has_adc,
+		   const std::vector<char>& in_window,
+		   HistArray& hptr_array, std::vector<int>& hitseg ) const;
+};
+
+//______________________________________________________________________________
+template <typename Event, typename HistArray>
+int
+DetectorMonitor::Fill( int index, const Event& event, HistArray& hptr_array,
+		       std::vector<int>& hitseg ) const
+{
+  if( index<0 || index>=static_cast<int>(m_detector.size()) )
+    return 0;
+  return FillEntries( m_detector[index], event, hptr_array, hitseg );
+}
+
+//______________________________________________________________________________
+template <typename Event, typename HistArray>
+int
+DetectorMonitor::FillEntries( const Detector& d, const Event& event,
+			      HistArray& hptr_array,
+			      std::vector<int>& hitseg ) const
+{
+  int multiplicity = 0;
+  for( int seg=0; seg<d.n_segment; ++seg ){
+    int n_hit_ud = 0;
+    for( int ud=0; ud<d.n_ud; ++ud ){
+      const int ch = ud*d.n_segment + seg;
+      unsigned int adc = 0;
+      bool has_adc = false;
+      if( d.adc_id>=0 &&
+	  event.get_entries( d.device_id, 0, seg, ud, d.adc_id )>0 ){
+	adc = event.get( d.device_id, 0, seg, ud, d.adc_id );
+	has_adc = true;
+	if( d.adc_hid>=0 ) hptr_array[d.adc_hid+ch]->Fill( adc );
+      }
+      bool in_window = false;
+      for( int m=0, n=event.get_entries( d.device_id, 0, seg, ud, d.tdc_id );
+	   m<n; ++m ){
+	const unsigned int tdc = event.get( d.device_id, 0, seg, ud, d.tdc_id, m );
+	if( tdc==0 && d.gate_adc ) continue;
+	if( d.tdc_hid>=0 ) hptr_array[d.tdc_hid+ch]->Fill( tdc );
+	in_window |= ( d.tdc_min<tdc && tdc<d.tdc_max );
+      }
+      if( !in_window || ( d.gate_adc && adc==0 ) )
+	continue;
+      ++n_hit_ud;
+      if( d.awt_hid>=0 && has_adc ) hptr_array[d.awt_hid+ch]->Fill( adc );
+    }
+    if( n_hit_ud==d.n_ud ){
+      ++multiplicity;
+      if( d.hit_hid>=0 ) hptr_array[d.hit_hid]->Fill( seg );
+      hitseg.push_back( seg );
+    }
+  }
+  if( d.mul_hid>=0 ) hptr_array[d.mul_hid]->Fill( multiplicity );
+  return multiplicity;
+}
+
+//______________________________________________________________________________
+template <typename HistArray>
+int
+DetectorMonitor::Fill( int index, const analyzer::EventSnapshot& event,
+		       HistArray& hptr_array, std::vector<int>& hitseg ) const
+{
+  if( index<0 || index>=static_cast<int>(m_detector.size()) )
+    return 0;
+
+  const Detector& d = m_detector[index];
+  if( !analyzer::EventSnapshot::hasHitRows( d.device_id ) )
+    return FillEntries( d, event, hptr_array, hitseg );
+
+  static thread_local std::vector<unsigned int> adc;
+  static thread_local std::vector<char>         has_adc;
+  static thread_local std::vector<char>         in_window;
+  adc.assign( d.n_segment*d.n_ud, 0 );
+  has_adc.assign( d.n_segment*d.n_ud, 0 );
+  in_window.assign( d.n_segment*d.n_ud, 0 );
+  for( int i=event.get_hit_begin( d.device_id ),
+	 n=event.get_hit_end( d.device_id ); i<n; ++i ){
+    const int seg = event.get_hit_segment( i );
+    const int ud  = event.get_hit_ch( i );
+    if( event.get_hit_plane( i )!=0 || seg>=d.n_segment || ud>=d.n_ud )
+      continue;
+    const int ch = ud*d.n_segment + seg;
+    const int data_type = event.get_hit_data_type( i );
+    const unsigned int value = event.get_hit_value( i );
+    if( data_type==d.adc_id && event.get_hit_index( i )==0 ){
+      adc[ch] = value;
+      has_adc[ch] = 1;
+      if( d.adc_hid>=0 ) hptr_array[d.adc_hid+ch]->Fill( value );
+    }
+    else if( data_type==d.tdc_id && ( value!=0 || !d.gate_adc ) ){
+      if( d.tdc_hid>=0 ) hptr_array[d.tdc_hid+ch]->Fill( value );
+      in_window[ch] |= ( d.tdc_min<value && value<d.tdc_max );
+    }
+  }
+  return FillHitPat( d, adc, has_adc, in_window, hptr_array, hitseg );
+}
+
+//______________________________________________________________________________
+template <typename HistArray>
+int
+DetectorMonitor::FillHitPat( const Detector& d,
+			     const std::vector<unsigned int>& adc,
+			     const std::vector<char>& has_adc,
+			     const std::vector<char>& in_window,
+			     HistArray& hptr_array,
+			     std::vector<int>& hitseg ) const
+{
+  int multiplicity = 0;
+  for( int seg=0; seg<d.n_segment; ++seg ){
+    int n_hit_ud = 0;
+    for( int ud=0; ud<d.n_ud; ++ud ){
+      const int ch = ud*d.n_segment + seg;
+      if( !in_window[ch] || ( d.gate_adc && adc[ch]==0 ) )
+	continue;
+      ++n_hit_ud;
+      if( d.awt_hid>=0 && has_adc[ch] )
+	hptr_array[d.awt_hid+ch]->Fill( adc[ch] );
+    }
+    if( n_hit_ud==d.n_ud ){
+      ++multiplicity;
+      if( d.hit_hid>=0 ) hptr_array[d.hit_hid]->Fill( seg );
+      hitseg.push_back( seg );
+    }
+  }
+  if( d.mul_hid>=0 ) hptr_array[d.mul_hid]->Fill( multiplicity );
+  return multiplicity;
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <TObject.h>
 
 #include "BH2Filter.hh"
+#include "EventArena.hh"
 
 class RawData;
 class DCAnalyzer;
@@ -24,6 +25,8 @@ public:
   ~EventAnalyzer( void );
 
 protected:
+  // first member: opened before and closed after all event objects
+  EventArena::Scope     m_arena_scope; //!
   Bool_t                m_bh2filter_is_applied;
   RawData*              m_raw_data;
   DCAnalyzer*           m_dc_analyzer;
@@ -0,0 +1,85 @@
+/**
+ *  file: EventArena.hh
+ *  date: 2026.10.17
+ *
+ */
+
+#ifndef EVENT_ARENA_HH
+#define EVENT_ARENA_HH
+
+#include <cstddef>
+#include <vector>
+
+//______________________________________________________________________________
+// Event-scoped monotonic allocator, one per thread.
+// While an EventArena::Scope is alive (EventAnalyzer holds one), classes
+// declared with EVENT_ARENA_ALLOCATED are constructed into large blocks
+// instead of the general heap. delete only counts the object down in
+// its block, and the blocks are rewound for the next event when the
+// outermost scope ends, so the steady state does not call malloc for
+// these objects at all. A block still holding objects at the end of an
+// event (leaked or cached ones) is set aside and freed when its last
+// object is deleted, the next event starts in another block.
+// Objects created outside of a scope come from the heap as before.
+// An arena object must be deleted on the thread which created it.
+class EventArena
+{
+public:
+  static EventArena& GetInstance( void );
+  ~EventArena( void );
+
+private:
+  EventArena( void );
+  EventArena( const EventArena& );
+  EventArena& operator =( const EventArena& );
+
+private:
+  struct Block
+  {
+    char*       begin;
+    std::size_t size;
+    std::size_t n_live;
+  };
+  std::vector<Block> m_block;     // of the current event
+  std::vector<Block> m_retired;   // with objects of past events
+  std::size_t        m_current;   // block in use
+  std::size_t        m_offset;    // in the current block
+  std::size_t        m_n_live;
+  int                m_depth;     // nested scopes
+  bool               m_is_warned;
+
+public:
+  class Scope
+  {
+  public:
+    Scope( void );
+    ~Scope( void );
+  private:
+    Scope( const Scope& );
+    Scope& operator =( const Scope& );
+  };
+
+  static void* Allocate( std::size_t size );
+  static void  Deallocate( void* p );
+  std::size_t  GetCapacity( void ) const;
+  std::size_t  GetNumOfLive( void ) const { return m_n_live; }
+  std::size_t  GetNumOfRetired( void ) const { return m_retired.size(); }
+
+private:
+  void* AllocateInBlock( std::size_t size );
+  void  Begin( void );
+  void  End( void );
+  static Block* Find( std::vector<Block>& blocks, const void* p );
+};
+
+//______________________________________________________________________________
+// placed in the public part of a class declaration
+#define EVENT_ARENA_ALLOCATED						\
+  static void* operator new( std::size_t size )				\
+  { return EventArena::Allocate( size ); }				\
+  static void  operator delete( void* p )				\
+  { EventArena::Deallocate( p ); }					\
+  static void* operator new( std::size_t, void* p ) { return p; }	\
+  static void  operator delete( void*, void* ) {}
+
+#endif
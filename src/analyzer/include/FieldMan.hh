@@ -45,11 +45,18 @@ public:
   ThreeVector GetdBdX( const ThreeVector& position ) const;
   ThreeVector GetdBdY( const ThreeVector& position ) const;
   ThreeVector GetdBdZ( const ThreeVector& position ) const;
+  void        GetFieldAndGradient( const ThreeVector& position,
+				   ThreeVector& field,
+				   ThreeVector& dBdX,
+				   ThreeVector& dBdY ) const;
   void        ClearElementsList( void );
   void        AddElement( FieldElements *element );
   void        SetFileName( const std::string& file_name ) { m_file_name = file_name; }
   double      StepSize( const ThreeVector& position,
 			double default_step_size, double min_step_size ) const;
+
+private:
+  ThreeVector GetElementField( const ThreeVector& position ) const;
 };
 
 //______________________________________________________________________________
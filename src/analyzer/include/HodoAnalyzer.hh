@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "DetectorID.hh"
+#include "EventArena.hh"
 #include "RawData.hh"
 
 class RawData;
@@ -39,6 +40,8 @@ typedef std::vector < std::vector< FiberCluster*> > MultiPlaneFiberClusterContai
 class HodoAnalyzer
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   HodoAnalyzer( void );
   ~HodoAnalyzer( void );
 
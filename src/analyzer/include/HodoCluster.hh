@@ -9,6 +9,8 @@
 
 #include <cstddef>
 
+#include "EventArena.hh"
+
 class HodoHit;
 class HodoAnalyzer;
 
@@ -16,6 +18,8 @@ class HodoAnalyzer;
 class HodoCluster
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   HodoCluster( HodoHit *hitA, HodoHit *hitB=0, HodoHit *hitC=0 );
   virtual ~HodoCluster( void );
 
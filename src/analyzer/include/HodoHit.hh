@@ -1,7 +1,7 @@
 #ifndef HODO_HIT_HH
 #define HODO_HIT_HH
 
-#include "HodoHit.hh"
+#include "EventArena.hh"
 
 class RawData;
 
@@ -9,6 +9,8 @@ class RawData;
 class HodoHit
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   HodoHit( void );
   virtual ~HodoHit() = 0;
 
@@ -7,10 +7,11 @@
 #ifndef HODO_PHC_MAN_HH
 #define HODO_PHC_MAN_HH
 
-#include <map>
 #include <string>
 #include <vector>
 
+#include "DenseParamTable.hh"
+
 //______________________________________________________________________________
 class HodoPHCParam
 {
@@ -18,10 +19,6 @@ public:
   HodoPHCParam( int type, int np, std::vector<double> parlist );
   ~HodoPHCParam( void );
 
-private:
-  HodoPHCParam( const HodoPHCParam& right );
-  HodoPHCParam& operator =( const HodoPHCParam& );
-
 private:
   int                 m_type;
   int                 m_n_param;
@@ -51,8 +48,7 @@ private:
   HodoPHCMan& operator =( const HodoPHCMan& );
 
 private:
-  typedef std::map <int, HodoPHCParam *> PhcPContainer;
-  typedef std::map <int, HodoPHCParam *>::const_iterator PhcPIterator;
+  typedef DenseParamTable<HodoPHCParam> PhcPContainer;
   bool          m_is_ready;
   std::string   m_file_name;
   PhcPContainer m_container;
@@ -69,7 +65,7 @@ public:
 
 private:
   void          ClearElements( void );
-  HodoPHCParam* GetMap( int cid, int plid, int seg, int ud ) const;
+  const HodoPHCParam* GetMap( int cid, int plid, int seg, int ud ) const;
 };
 
 //______________________________________________________________________________
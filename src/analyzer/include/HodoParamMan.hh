@@ -8,7 +8,8 @@
 #define HODO_PARAM_MAN_HH
 
 #include <string>
-#include <map>
+
+#include "DenseParamTable.hh"
 
 //______________________________________________________________________________
 //Hodo TDC to Time
@@ -23,8 +24,6 @@ public:
 
 private:
   HodoTParam( void );
-  HodoTParam( const HodoTParam& );
-  HodoTParam& operator =( const HodoTParam& );
 
 private:
   double m_offset;
@@ -52,8 +51,6 @@ public:
 
 private:
   HodoAParam( void );
-  HodoAParam( const HodoAParam& );
-  HodoAParam& operator =( const HodoAParam& );
 
 private:
   double m_pedestal;
@@ -79,8 +76,6 @@ public:
   ~HodoFParam() {}
 private:
   HodoFParam();
-  HodoFParam( const HodoFParam & );
-  HodoFParam & operator = ( const HodoFParam & );
 private:
   double Par0, Par1, Par2, Par3, Par4, Par5;
 public:
@@ -108,12 +103,9 @@ private:
 
 private:
   enum eAorT { kAdc, kTdc, kAorT };
-  typedef std::map<int, HodoTParam*> TContainer;
-  typedef std::map<int, HodoAParam*> AContainer;
-  typedef std::map<int, HodoFParam*> FContainer;
-  typedef TContainer::const_iterator TIterator;
-  typedef AContainer::const_iterator AIterator;
-  typedef FContainer::const_iterator FIterator;
+  typedef DenseParamTable<HodoTParam> TContainer;
+  typedef DenseParamTable<HodoAParam> AContainer;
+  typedef DenseParamTable<HodoFParam> FContainer;
   bool        m_is_ready;
   std::string m_file_name;
   TContainer  m_TPContainer;
@@ -128,6 +120,13 @@ public:
   bool GetDe( int cid, int plid, int seg, int ud, int adc, double &de ) const;
   bool GetTdc( int cid, int plid, int seg, int ud, double time, int &tdc ) const;
   bool GetAdc( int cid, int plid, int seg, int ud, double de, int &adc ) const;
+  // record indices for the multi-hit loops, -1 if no record
+  int  GetTIndex( int cid, int plid, int seg, int ud ) const
+  { return m_TPContainer.Find( cid, plid, seg, ud ); }
+  int  GetAIndex( int cid, int plid, int seg, int ud ) const
+  { return m_APContainer.Find( cid, plid, seg, ud ); }
+  bool GetTime( int t_index, int tdc, double &time ) const;
+  bool GetDe( int a_index, int adc, double &de ) const;
   void SetFileName( const std::string& file_name ) { m_file_name = file_name; }
 
   double GetP0( int cid, int plid, int seg, int ud) const;
@@ -138,9 +137,9 @@ public:
   double  GetGain(int cid, int plid, int seg, int ud) const;
 
 private:
-  HodoTParam *GetTmap( int cid, int plid, int seg, int ud ) const;
-  HodoAParam *GetAmap( int cid, int plid, int seg, int ud ) const;
-  HodoFParam *GetFmap( int cid, int plid, int seg, int ud ) const;
+  const HodoTParam *GetTmap( int cid, int plid, int seg, int ud ) const;
+  const HodoAParam *GetAmap( int cid, int plid, int seg, int ud ) const;
+  const HodoFParam *GetFmap( int cid, int plid, int seg, int ud ) const;
   void ClearACont( void );
   void ClearTCont( void );
   void ClearFCont( void );
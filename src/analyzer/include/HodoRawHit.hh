@@ -11,10 +11,14 @@
 #include <vector>
 #include <iostream>
 
+#include "EventArena.hh"
+
 //______________________________________________________________________________
 class HodoRawHit
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   HodoRawHit( int detector_id, int plane_id, int segment_id );
   ~HodoRawHit( void );
 
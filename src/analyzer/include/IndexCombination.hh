@@ -0,0 +1,63 @@
+/**
+ *  file: IndexCombination.hh
+ *  date: 2026.10.17
+ *
+ */
+
+#ifndef INDEX_COMBINATION_HH
+#define INDEX_COMBINATION_HH
+
+#include <vector>
+
+//______________________________________________________________________________
+// Odometer over the cluster combinations of a set of planes.
+// Each plane index runs from -1 (plane not used) to nIndex[plane]-1 and
+// plane 0 turns fastest, which is the order of the former MakeIndex().
+// Combinations are generated one at a time, so memory does not depend on
+// the number of combinations, and blocks which cannot reach the minimum
+// number of hits (or exceed the maximum number of planes) are skipped
+// without being visited.
+class IndexCombination
+{
+public:
+  typedef std::vector<int> IndexList;
+
+public:
+  IndexCombination( const IndexList& nIndex );
+  ~IndexCombination( void );
+
+private:
+  IndexCombination( const IndexCombination& );
+  IndexCombination& operator =( const IndexCombination& );
+
+private:
+  int                    m_ndim;
+  IndexList              m_n_index;
+  IndexList              m_index;
+  std::vector<IndexList> m_n_hit;      // [plane][index], empty if unused
+  IndexList              m_max_below;  // max #hits of the planes < plane
+  int                    m_min_hit;
+  int                    m_max_plane;
+  double                 m_max_combi;
+  double                 m_n_combi;
+  bool                   m_is_end;
+  bool                   m_is_truncated;
+
+public:
+  const IndexList& Get( void ) const { return m_index; }
+  double GetNumOfCombi( void ) const { return m_n_combi; }
+  bool   IsEnd( void ) const { return m_is_end; }
+  bool   IsTruncated( void ) const { return m_is_truncated; }
+  void   Next( void );
+  void   SetMaxCombi( double maxCombi );
+  void   SetMaxNumOfPlanes( int maxPlane );
+  void   SetMinNumOfHits( const std::vector<IndexList>& nHit, int minHit );
+  void   Skip( int plane );
+
+private:
+  void   Advance( int plane );
+  bool   IsPossible( int plane ) const;
+  void   Restart( void );
+};
+
+#endif
@@ -3,6 +3,7 @@
 #ifndef KURAMA_FIELD_MAP_HH
 #define KURAMA_FIELD_MAP_HH
 
+#include <iosfwd>
 #include <string>
 #include <vector>
 
@@ -21,23 +22,42 @@ private:
   KuramaFieldMap& operator =( const KuramaFieldMap& );
 
 private:
-  struct XYZ { Double_t x, y, z; };
-  typedef std::vector< std::vector< std::vector<XYZ> > > Field;
+  // field components (bx, by, bz) of point (ix, iy, iz) at
+  // 3*((ix*Ny + iy)*Nz + iz), raw values of the text map
   Bool_t      m_is_ready;
   TString     m_file_name;
-  Field       B;
+  const Float_t*       B;         //! points to m_buffer or the mapped cache
+  std::vector<Float_t> m_buffer;  //!
+  void*       m_map_addr;         //!
+  std::size_t m_map_size;
+  Double_t    m_factor;           // NMR/Calc
   Int_t       Nx, Ny, Nz;
   Double_t    X0, Y0, Z0;
   Double_t    dX, dY, dZ;
+  Double_t    m_inv_dx, m_inv_dy, m_inv_dz;
+  std::size_t m_stride_x, m_stride_y;  // 3*Ny*Nz, 3*Nz
 
 public:
   Bool_t Initialize( void );
   Bool_t IsReady( void ) const { return m_is_ready; }
   Bool_t GetFieldValue( const Double_t pointCM[3],
 			Double_t *BfieldTesla ) const;
+  Bool_t GetFieldValue( const Double_t pointCM[3],
+			Double_t *BfieldTesla,
+			Double_t *dBdX, Double_t *dBdY ) const;
 
 private:
-  void ClearField( void );
+  void    ClearField( void );
+  static void Locate( Double_t t, Double_t t0, Double_t inv_d, Int_t n,
+		      Int_t& i1, Int_t& i2, Double_t w[2], Double_t dw[2] );
+  TString CacheFileName( void ) const;
+  Bool_t  LoadCache( ULong64_t source_size, ULong64_t source_mtime,
+		     ULong64_t source_sample );
+  Bool_t  ReadText( std::istream& ifs );
+  void    SetGrid( void );
+  Bool_t  WriteCache( ULong64_t source_size, ULong64_t source_mtime,
+		      ULong64_t source_sample,
+		      ULong64_t source_checksum ) const;
 
   ClassDef(KuramaFieldMap,0);
 };
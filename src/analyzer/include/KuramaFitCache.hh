@@ -0,0 +1,78 @@
+/**
+ *  file: KuramaFitCache.hh
+ *  date: 2026.10.17
+ *
+ */
+
+#ifndef KURAMA_FIT_CACHE_HH
+#define KURAMA_FIT_CACHE_HH
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class KuramaTrack;
+class RKCordParameter;
+
+//______________________________________________________________________________
+// Converged fits of the recent events, as the mean correction from the
+// start point of KuramaTrack::GuessCord() (SdcOut track at TOF and the
+// momentum from the bending) to the fitted parameters at TOF.
+// The corrections are binned in (x, u, v, p) of the start point, so the
+// common beam-like tracks of a run start close to their solution.
+//
+//   cache.Seed( track );    // before DoFit()
+//   cache.Update( track );  // after a passed fit
+//
+// One cache per event thread. DCAnalyzer seeds and updates it on the
+// calling thread, in the order of the pairs, so the fits on the
+// TaskPool only read the start point of their own track.
+// The cache makes the fitted tracks depend on the events seen before,
+// so it is off unless SetEnabled( true ). ParseOption( argv ), called in
+// process_begin() of the online monitors, turns it on for
+// --kurama-warm-start, but not when the input is a file (replay).
+// The chi-square pre-filter always starts cold, see
+// KuramaTrack::EstimateChiSqr().
+class KuramaFitCache
+{
+public:
+  static KuramaFitCache& GetInstance( void );
+  ~KuramaFitCache( void );
+
+private:
+  KuramaFitCache( void );
+  KuramaFitCache( const KuramaFitCache& );
+  KuramaFitCache& operator =( const KuramaFitCache& );
+
+private:
+  typedef unsigned long long Key;
+  struct Entry
+  {
+    int    n;
+    double dx, dy, du, dv;
+    double rq; // ratio of q
+  };
+  typedef std::unordered_map<Key, Entry> EntryMap;
+  EntryMap m_entry;
+  long     m_n_seed;
+  long     m_n_update;
+  static std::atomic<bool> s_is_enabled;
+
+public:
+  static bool IsEnabled( void ) { return s_is_enabled; }
+  static bool ParseOption( const std::vector<std::string>& argv );
+  static void SetEnabled( bool flag ) { s_is_enabled = flag; }
+  void        Clear( void );
+  std::size_t GetNumOfEntry( void ) const { return m_entry.size(); }
+  long        GetNumOfSeed( void ) const { return m_n_seed; }
+  long        GetNumOfUpdate( void ) const { return m_n_update; }
+  bool        Seed( KuramaTrack* track );
+  void        Update( const KuramaTrack* track );
+
+private:
+  static bool MakeKey( const RKCordParameter& cord, Key& key );
+};
+
+#endif
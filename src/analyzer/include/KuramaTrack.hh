@@ -7,6 +7,7 @@
 #ifndef KURAMA_TRACK_HH
 #define KURAMA_TRACK_HH
 
+#include "EventArena.hh"
 #include "RungeKuttaUtilities.hh"
 #include "ThreeVector.hh"
 
@@ -26,6 +27,8 @@ class Hodo2Hit;
 class KuramaTrack
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   KuramaTrack( DCLocalTrack *track_in, DCLocalTrack *track_out );
   ~KuramaTrack( void );
 
@@ -65,6 +68,8 @@ private:
   ThreeVector             m_tof_mom;
   RKCordParameter         m_cord_param;
   bool                    m_gfastatus;
+  RKCordParameter         m_warm_cord;
+  bool                    m_is_warm;
 
 public:
   DCLocalTrack*      GetLocalTrackIn( void ) { return m_track_in;}
@@ -72,10 +77,17 @@ public:
   bool               DoFit( void );
   bool               DoFit( RKCordParameter iniCord );
   bool               DoFitMinuit( void );
+  double             EstimateChiSqr( void ) const;
   bool               Status( void ) const { return m_status; }
   int                Niteration( void ) const { return m_n_iteration; }
   void               SetInitialMomentum( double initial_momentum )
   { m_initial_momentum = initial_momentum; }
+  // starts DoFit() from this point at TOF instead of GuessCord()
+  void               SetWarmStart( const RKCordParameter& cord )
+  { m_warm_cord = cord; m_is_warm = true; }
+  bool               IsWarmStarted( void ) const { return m_is_warm; }
+  RKCordParameter    GuessCord( void ) const;
+  const RKCordParameter& GetCordParameter( void ) const { return m_cord_param; }
   const ThreeVector& PrimaryPosition( void ) const { return m_primary_position; }
   const ThreeVector& PrimaryMomentum( void ) const { return m_primary_momentum; }
   double             PrimaryMomMag( void )   const { return m_primary_momentum.Mag();}
@@ -101,6 +113,8 @@ private:
   void   FillHitArray( void );
   void   ClearHitArray( void );
   double CalcChiSqr( const RKHitPointContainer &hpCont ) const;
+  RKCordParameter InitialCord( void ) const
+  { return m_is_warm ? m_warm_cord : GuessCord(); }
   bool   GuessNextParameters( const RKHitPointContainer &hpCont,
 			      RKCordParameter &Cord,
 			      double &estDeltaChisqr,
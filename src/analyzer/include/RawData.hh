@@ -8,6 +8,7 @@
 #define RAW_DATA_HH
 
 #include "DetectorID.hh"
+#include "EventArena.hh"
 #include <vector>
 
 class HodoRawHit;
@@ -20,6 +21,8 @@ typedef std::vector <int>        FADCRHitContainer;
 class RawData
 {
 public:
+  EVENT_ARENA_ALLOCATED
+
   RawData( void );
   ~RawData( void );
 
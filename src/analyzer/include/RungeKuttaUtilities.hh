@@ -23,6 +23,15 @@ class RKHitPointContainer;
 //______________________________________________________________________________
 namespace RK
 {
+  // step size of Trace() in the calling thread, kFixedStep is the former
+  // fixed step kept for comparison
+  enum EStepMode { kFixedStep, kAdaptiveStep };
+  //______________________________________________________________________________
+  EStepMode
+  GetStepMode( void );
+  //______________________________________________________________________________
+  void
+  SetStepMode( EStepMode mode );
   //______________________________________________________________________________
   RKFieldIntegral
   CalcFieldIntegral( double U, double V, double Q, const ThreeVector &B );
@@ -52,6 +61,12 @@ namespace RK
   RKTrajectoryPoint
   TraceOneStep( double StepSize, const RKTrajectoryPoint &prevPoint );
   //______________________________________________________________________________
+  // error: local position error estimated from the stages [mm]
+  // sagitta: deviation from the chord used by CheckCrossing() [mm]
+  RKTrajectoryPoint
+  TraceOneStep( double StepSize, const RKTrajectoryPoint &prevPoint,
+		double &error, double &sagitta );
+  //______________________________________________________________________________
   bool
   TraceToLast( RKHitPointContainer &hitContainer );
   //______________________________________________________________________________
@@ -80,7 +95,8 @@ private:
 public:
   void Print( std::ostream &ost ) const;
 
-  friend RKTrajectoryPoint RK::TraceOneStep( double, const RKTrajectoryPoint & );
+  friend RKTrajectoryPoint RK::TraceOneStep( double, const RKTrajectoryPoint &,
+					     double &, double & );
   friend RKDeltaFieldIntegral
   RK::CalcDeltaFieldIntegral( const RKTrajectoryPoint &,
 			      const RKFieldIntegral &,
@@ -108,7 +124,8 @@ private:
   double dkyx, dkyy, dkyu, dkyv, dkyq;
 public:
   void Print( std::ostream &ost ) const;
-  friend RKTrajectoryPoint RK::TraceOneStep( double, const RKTrajectoryPoint & );
+  friend RKTrajectoryPoint RK::TraceOneStep( double, const RKTrajectoryPoint &,
+					     double &, double & );
   friend RKDeltaFieldIntegral
   RK::CalcDeltaFieldIntegral( const RKTrajectoryPoint &,
 			      const RKFieldIntegral &,
@@ -156,7 +173,7 @@ public:
 
   friend class RKTrajectoryPoint;
   friend RKTrajectoryPoint
-  RK::TraceOneStep( double, const RKTrajectoryPoint & );
+  RK::TraceOneStep( double, const RKTrajectoryPoint &, double &, double & );
   friend RKDeltaFieldIntegral
   RK::CalcDeltaFieldIntegral( const RKTrajectoryPoint &,
 			      const RKFieldIntegral &,
@@ -384,7 +401,7 @@ public:
   void        Print( std::ostream &ost ) const;
 
   friend RKTrajectoryPoint
-  RK::TraceOneStep( double, const RKTrajectoryPoint & );
+  RK::TraceOneStep( double, const RKTrajectoryPoint &, double &, double & );
   friend bool
   RK::CheckCrossing( int, const RKTrajectoryPoint &,
 		     const RKTrajectoryPoint &, RKcalcHitPoint & );
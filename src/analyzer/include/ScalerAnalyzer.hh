@@ -5,6 +5,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <vector>
 
 #include <TString.h>
@@ -18,6 +19,7 @@ struct ScalerInfo;
 typedef Long64_t                               Scaler;
 typedef std::vector< std::vector<ScalerInfo> > ScalerList;
 typedef std::pair<Int_t, Int_t>                Channel;
+typedef Int_t                                  ScalerHandle; // -1 if none
 
 //_____________________________________________________________________________
 struct ScalerInfo
@@ -99,6 +101,23 @@ public:
 
 private:
   enum eScaler { kScaler1, kScaler2, kScaler3, nScaler };
+  // channels referred to by Duty() and Print()
+  enum eKey {
+    kKeyBH2,
+    kKeyTM,
+    kKeyL1Req,
+    kKeyL1Acc,
+    kKeyL2Acc,
+    kKeyLiveTime,
+    kKeyRealTime,
+    nKey
+  };
+  // a *-SUM channel and the handles of its terms
+  struct SumList
+  {
+    ScalerHandle              sum;
+    std::vector<ScalerHandle> term;
+  };
 
   std::ostream&       m_ost;
   ScalerList          m_info;
@@ -108,6 +127,13 @@ private:
   Bool_t              m_is_spill_on_end;
   Int_t               m_run_number;
   TCanvas*            m_canvas;
+  // resolved from the names by Compile() whenever the sheet is Set()
+  std::map<TString, ScalerHandle> m_handle;      //!
+  std::vector<ScalerHandle>       m_decode_list; //!
+  std::vector<SumList>            m_sum_list;    //!
+  std::vector<ScalerHandle>       m_key;         //!
+  ScalerHandle                    m_spill;       //!
+  Bool_t                          m_is_first;    //! first Decode()
 
 public:
   void       Clear( Option_t* option="" );
@@ -117,9 +143,12 @@ public:
   Bool_t     FlagDisp( Int_t i, Int_t j ) const
     { return m_info.at(i).at(j).flag_disp; }
   Double_t   Fraction( const TString& num, const TString& den ) const;
+  Double_t   Fraction( ScalerHandle num, ScalerHandle den ) const;
   Scaler     Get( Int_t i, Int_t j ) const { return m_info.at(i).at(j).data; }
   Scaler     Get( const TString& name ) const;
+  Scaler     Get( ScalerHandle handle ) const;
   Bool_t     GetFlag( Int_t i ) const { return m_flag[i]; }
+  ScalerHandle GetHandle( const TString& name ) const;
   Int_t      GetRunNumber( void ) const { return m_run_number; }
   ScalerInfo GetScalerInfo( Int_t i, Int_t j ) const
     { return m_info.at(i).at(j); }
@@ -141,6 +170,7 @@ public:
   Bool_t     SpillIncrement( void ) const { return m_spill_increment; }
 
 private:
+  void Compile( void );
   void DrawOneBox( Double_t x, Double_t y,
                    const TString& title1, const TString& val1 );
   void DrawOneLine( const TString& title1, const TString& val1,
@@ -167,4 +197,13 @@ ScalerAnalyzer::GetInstance( void )
   return g_instance;
 }
 
+//______________________________________________________________________________
+inline Scaler
+ScalerAnalyzer::Get( ScalerHandle handle ) const
+{
+  if( handle<0 )
+    return 0;
+  return m_info[handle/MaxRow][handle%MaxRow].data;
+}
+
 #endif
@@ -0,0 +1,90 @@
+/**
+ *  file: TaskPool.hh
+ *  date: 2026.10.17
+ *
+ */
+
+#ifndef TASK_POOL_HH
+#define TASK_POOL_HH
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//______________________________________________________________________________
+// Persistent helper threads for the independent pieces of work inside
+// one event, e.g. the fits of the Kurama track candidates.
+//
+//   TaskPool::GetInstance().Run( n, [&]( std::size_t i ){ ... } );
+//
+// calls the task once for each index in [0, n) and returns when all of
+// them have finished. The calling thread takes indices too, so Run() may
+// be called from several event workers at the same time and a pool of
+// one thread (the default) simply runs the loop in place.
+// The tasks must not share mutable state, each one writes its own slot
+// of the result, and must not touch ROOT objects (histograms, the event
+// display), which are not protected here.
+// An exception thrown by a task is rethrown by Run() after the others
+// have finished.
+// The programs using it call ParseOption( argv ) in process_begin(), so
+// the pool is sized by --fit-thread=N.
+class TaskPool
+{
+public:
+  static TaskPool& GetInstance( void );
+  ~TaskPool( void );
+
+private:
+  TaskPool( void );
+  TaskPool( const TaskPool& );
+  TaskPool& operator =( const TaskPool& );
+
+public:
+  typedef std::function<void(std::size_t)> Task;
+
+private:
+  struct Job
+  {
+    const Task*        task;
+    std::size_t        n;
+    std::size_t        next;    // index to be taken
+    std::size_t        n_done;
+    std::exception_ptr error;
+  };
+
+  std::vector<std::thread> m_thread;
+  std::deque<Job*>         m_job;
+  std::mutex               m_mutex;
+  std::condition_variable  m_cond_job;
+  std::condition_variable  m_cond_done;
+  bool                     m_is_end;
+
+public:
+  // threads working on a job, the caller included
+  std::size_t GetNThread( void ) const { return m_thread.size()+1; }
+  bool        ParseOption( const std::vector<std::string>& argv );
+  void        Run( std::size_t n, const Task& task );
+  // only between the events, no Run() may be in progress
+  void        SetNThread( int n );
+
+private:
+  bool Execute( std::unique_lock<std::mutex>& lock, Job* job );
+  void RunWorker( void );
+  void Stop( void );
+};
+
+//______________________________________________________________________________
+inline TaskPool&
+TaskPool::GetInstance( void )
+{
+  static TaskPool g_instance;
+  return g_instance;
+}
+
+#endif
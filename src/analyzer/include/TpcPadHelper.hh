@@ -4,6 +4,7 @@
 #define TPC_PAD_HELPER_HH
 
 #include <map>
+#include <vector>
 #include <TString.h>
 #include <TVector3.h>
 
@@ -78,18 +79,29 @@ public:
 private:
   typedef std::map<Int_t,TpcPadParam*> TpcGeomMap;
   TpcGeomMap m_map;
+  // dense lookup tables, filled by Initialize()
+  Int_t                     m_n_row;        // stride of m_layer_row_table
+  std::vector<TpcPadParam*> m_layer_row_table; // [layer*m_n_row+row]
+  std::vector<TpcPadParam*> m_pad_table;       // [pad]
+  std::vector<TpcPadParam*> m_pad_list;        // (layer,row) order, pad>=0
+  std::vector<TVector3>     m_point_table;     // [pad]
 
 public:
   TpcPadParam* GetParam( Int_t asad, Int_t aget, Int_t ch ) const;
   TpcPadParam* GetParam( Int_t layer, Int_t row ) const;
   TpcPadParam* GetParam( Int_t pad ) const;
   TVector3     GetPoint( Int_t pad ) const;
+  void         GetPoints( const std::vector<Int_t>& pad_list,
+                          std::vector<TVector3>& point_list ) const;
+  const std::vector<TpcPadParam*>& GetPadList( void ) const;
   Int_t        GetPadId( Int_t asad, Int_t aget, Int_t ch ) const;
   Int_t        GetPadId( Int_t layer, Int_t row ) const;
   Int_t        GetLayerId( Int_t asad, Int_t aget, Int_t ch ) const;
   Int_t        GetRowId( Int_t asad, Int_t aget, Int_t ch ) const;
   Bool_t       Initialize( const TString& file_name );
 
+private:
+  static TVector3 CalcPoint( Int_t pad );
 };
 
 //_____________________________________________________________________________
@@ -108,4 +120,11 @@ TpcPadHelper::GetInstance( void )
   return s_instance;
 }
 
+//_____________________________________________________________________________
+inline const std::vector<TpcPadParam*>&
+TpcPadHelper::GetPadList( void ) const
+{
+  return m_pad_list;
+}
+
 #endif
@@ -17,6 +17,16 @@ class DCLocalTrack;
 #define KeepOrderAsMakeIndex
 
 //______________________________________________________________________________
+// Depth-first track builder over the pair-plane clusters.
+// One cluster (or none) is chosen per plane, from the last plane to the
+// first, so the tracks come out in the order of the former MakeIndex().
+// Each branch keeps the sums of the normal equations of the straight line
+// fit, so adding a plane updates them in O(1). A branch is dropped as soon
+// as it cannot reach the minimum number of hits, or when its chi-square
+// alone already exceeds MaxChiSquare times the largest NDF it can reach
+// (the chi-square of a least-squares fit never decreases when hits are
+// added). The chi-square cut is applied only while the branch has no
+// honeycomb hit, whose fit is iterated in DCLocalTrack::DoFit().
 class TrackMaker
 {
 public:
@@ -39,6 +49,19 @@ private:
   TrackMaker( const TrackMaker& );
   TrackMaker& operator =( const TrackMaker& );
 
+protected:
+  // sums of s = (x0+u0*z)*cos(tilt) + (y0+v0*z)*sin(tilt)
+  struct NormalSum
+  {
+    double m[10];   // upper triangle of the 4x4 matrix
+    double b[4];
+    double ss;      // w*s*s
+    int    nhit;
+    bool   linear;  // no honeycomb hit
+
+    NormalSum& operator +=( const NormalSum& other );
+  };
+
 protected:
   const std::vector<ClusterList>& m_candidates;
   const std::size_t               m_npp;
@@ -48,6 +71,11 @@ protected:
   double m_maxChiSquare;
   double m_maxCombi;
   int    m_minNumOfHits;
+  int    m_maxNumOfCluster;
+  bool   m_isTruncated;
+  std::vector< std::vector<NormalSum> > m_sum;     // [plane][cluster]
+  IndexList                             m_maxBelow; // max #hits of planes < plane
+  IndexList                             m_index;
 
 public:
   virtual void  MakeTracks( std::vector<DCLocalTrack*>& trackList );
@@ -57,18 +85,21 @@ public:
   inline int    GetMinNumOfHits( void ) const;
   inline int    GetNumOfCombi( void ) const;
   inline int    GetNumOfValidCombi( void ) const;
+  inline bool   IsTruncated( void ) const;
   inline void   SetMaxChiSquare( double maxChiSquare );
   inline void   SetMaxCombi( double maxCombi );
+  inline void   SetMaxNumOfCluster( int maxNumOfCluster );
   inline void   SetMinNumOfHits( int minNumOfHits );
 
 protected:
   virtual bool IsGood( const DCLocalTrack* track ) const;
 
 private:
-  std::vector<IndexList> MakeIndex( int ndim, const int *index1 );
-  std::vector<IndexList> MakeIndex( int ndim, const std::vector<int>& index1 );
+  bool                   IsHopeless( const NormalSum& sum, int maxHit ) const;
   DCLocalTrack*          MakeOneTrack( const std::vector<ClusterList>& CandCont,
 				       const IndexList& combination );
+  void                   Search( int plane, const NormalSum& sum,
+				 std::vector<DCLocalTrack*>& trackList );
 
 };
 
@@ -100,6 +131,13 @@ TrackMaker::GetNumOfCombi( void ) const
   return m_nCombi;
 }
 
+//______________________________________________________________________________
+inline bool
+TrackMaker::IsTruncated( void ) const
+{
+  return m_isTruncated;
+}
+
 //______________________________________________________________________________
 inline void
 TrackMaker::SetMaxChiSquare( double maxChiSquare )
@@ -114,6 +152,14 @@ TrackMaker::SetMaxCombi( double maxCombi )
   m_maxCombi = maxCombi;
 }
 
+//______________________________________________________________________________
+// planes with more clusters are not used
+inline void
+TrackMaker::SetMaxNumOfCluster( int maxNumOfCluster )
+{
+  m_maxNumOfCluster = maxNumOfCluster;
+}
+
 //______________________________________________________________________________
 inline void
 TrackMaker::SetMinNumOfHits( int minNumOfHits )
@@ -18,6 +18,7 @@
 namespace
 {
   const std::string& class_name("BGOAnalyzer");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const double Time_SI = 1./33.33333;
   const double y_err = 30.;
   const double y_err_NoData = 300.;
@@ -41,7 +42,7 @@ namespace
 BGOAnalyzer::BGOAnalyzer( void )
   : m_fitFunction(0), m_func(0)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 
   const BGOTemplateManager& gBGOTemp = BGOTemplateManager::GetInstance();
 
@@ -67,7 +68,7 @@ BGOAnalyzer::~BGOAnalyzer( void )
     m_func = 0;
   }
 
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 
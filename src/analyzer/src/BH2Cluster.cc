@@ -20,6 +20,7 @@
 namespace
 {
   const std::string& class_name("BH2Cluster");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -37,13 +38,13 @@ BH2Cluster::BH2Cluster( BH2Hit *hitA, BH2Hit *hitB, BH2Hit *hitC ) :
   if(hitB) ++m_cluster_size;
   if(hitC) ++m_cluster_size;
   //  Calculate();
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 BH2Cluster::~BH2Cluster( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 };
 
 //______________________________________________________________________________
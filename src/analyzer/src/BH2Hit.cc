@@ -22,6 +22,7 @@
 namespace
 {
   const std::string& class_name("BH2Hit");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const HodoParamMan& gHodo = HodoParamMan::GetInstance();
   //  const HodoPHCMan&   gPHC  = HodoPHCMan::GetInstance();
 }
@@ -31,13 +32,13 @@ BH2Hit::BH2Hit( HodoRawHit *rhit, double max_time_diff )
   : Hodo2Hit(rhit, max_time_diff),
     m_time_offset(0.)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 BH2Hit::~BH2Hit( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
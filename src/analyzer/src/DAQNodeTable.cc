@@ -0,0 +1,95 @@
+/**
+ *  file: DAQNodeTable.cc
+ *  date: 2026.10.17
+ *
+ */
+
+#include "DAQNodeTable.hh"
+
+#include <UnpackerManager.hh>
+
+namespace
+{
+  const std::string& class_name("DAQNodeTable");
+  using namespace hddaq::unpacker;
+  const UnpackerManager& gUnpacker = GUnpacker::get_instance();
+
+  // [ENodeType] part of the node name
+  const char* TypeKey[DAQNodeTable::kNNodeType] =
+    { "vme", "hul", "easiroc", "cobo", "aft" };
+}
+
+//______________________________________________________________________________
+DAQNodeTable&
+DAQNodeTable::GetInstance( void )
+{
+  static thread_local DAQNodeTable g_instance;
+  return g_instance;
+}
+
+//______________________________________________________________________________
+DAQNodeTable::DAQNodeTable( void )
+  : m_node_id(),
+    m_n_update(0)
+{
+}
+
+//______________________________________________________________________________
+DAQNodeTable::~DAQNodeTable( void )
+{
+}
+
+//______________________________________________________________________________
+void
+DAQNodeTable::Classify( int id, const std::string& name )
+{
+  m_node_id.push_back( id );
+  for( int t=0; t<kNNodeType; ++t ){
+    if( name.find( TypeKey[t] )!=std::string::npos )
+      m_type_id[t].push_back( id );
+  }
+}
+
+//______________________________________________________________________________
+void
+DAQNodeTable::Clear( void )
+{
+  m_node_id.clear();
+  for( int t=0; t<kNNodeType; ++t )
+    m_type_id[t].clear();
+}
+
+//______________________________________________________________________________
+bool
+DAQNodeTable::Update( void )
+{
+  const DAQNode* root = gUnpacker.get_root();
+  if( !root ){
+    if( m_node_id.empty() )
+      return false;
+    Clear();
+    ++m_n_update;
+    return true;
+  }
+
+  bool is_same = true;
+  std::size_t i = 0;
+  for( const auto& c : root->get_child_list() ){
+    if( !c.second ) continue;
+    if( i>=m_node_id.size() || m_node_id[i]!=c.second->get_id() ){
+      is_same = false;
+      break;
+    }
+    ++i;
+  }
+  if( is_same && i==m_node_id.size() )
+    return false;
+
+  Clear();
+  for( const auto& c : root->get_child_list() ){
+    if( c.second )
+      Classify( c.second->get_id(), c.second->get_name() );
+  }
+  ++m_n_update;
+  return true;
+}
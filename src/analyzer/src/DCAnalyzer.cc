@@ -22,7 +22,9 @@
 #include "DCRawHit.hh"
 #include "DCTrackSearch.hh"
 #include "DebugCounter.hh"
+#include "DebugStageTimer.hh"
 #include "DebugTimer.hh"
+#include "EventDisplay.hh"
 #include "FiberCluster.hh"
 #include "Hodo1Hit.hh"
 #include "Hodo2Hit.hh"
@@ -31,10 +33,12 @@
 #include "K18Parameters.hh"
 //#include "K18TrackU2D.hh"
 #include "K18TrackD2U.hh"
+#include "KuramaFitCache.hh"
 #include "KuramaTrack.hh"
 #include "MathTools.hh"
 #include "MWPCCluster.hh"
 #include "RawData.hh"
+#include "TaskPool.hh"
 #include "UserParamMan.hh"
 #include "DeleteUtility.hh"
 #include "BH2Filter.hh"
@@ -58,6 +62,7 @@ namespace
 {
   using namespace K18Parameter;
   const std::string& class_name("DCAnalyzer");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const ConfMan&      gConf = ConfMan::GetInstance();
   const DCGeomMan&    gGeom = DCGeomMan::GetInstance();
   const UserParamMan& gUser = UserParamMan::GetInstance();
@@ -70,11 +75,62 @@ namespace
   const int& IdTOFDY = gGeom.DetectorId("TOF-DY");
 
   const double MaxChiSqrKuramaTrack = 10000.;
+  // KuramaTrack::EstimateChiSqr() is linearised at the initial momentum,
+  // so a pair is given up before the fit only far above the cut
+  const double MaxChiSqrKuramaEstimate = 10.*MaxChiSqrKuramaTrack;
   const double MaxTimeDifMWPC       =   100.;
 
   const double kMWPCClusteringWireExtension =  1.0; // [mm]
   const double kMWPCClusteringTimeExtension = 10.0; // [nsec]
 
+  //______________________________________________________________________________
+  // from the bending in the KURAMA magnet, 1 GeV/c if it is unphysical
+  inline double
+  KuramaInitialMomentum( const DCLocalTrack* trIn, const DCLocalTrack* trOut )
+  {
+    const double bending = trOut->GetU0() - trIn->GetU0();
+    const double p[3] = { 0.08493, 0.2227, 0.01572 };
+    const double initial_momentum = p[0] + p[1]/( bending-p[2] );
+    if( bending>0. && initial_momentum>0. )
+      return initial_momentum;
+    else
+      return 1.;
+  }
+
+  //______________________________________________________________________________
+  // Fits the candidates on the TaskPool, each one into its own slot, so the
+  // result does not depend on the number of threads. The event display
+  // draws every trace and is filled by one thread only.
+  // If enabled, the start points come from the KuramaFitCache of this
+  // thread, which learns from the passed fits afterwards in the order of
+  // the pairs.
+  void
+  FitKuramaTracks( const std::vector<KuramaTrack*>& candidates,
+		   std::vector<char>& passed )
+  {
+    const bool is_warm = KuramaFitCache::IsEnabled();
+    KuramaFitCache& cache = KuramaFitCache::GetInstance();
+    for( std::size_t i=0, n=candidates.size(); is_warm && i<n; ++i )
+      cache.Seed( candidates[i] );
+
+    passed.assign( candidates.size(), false );
+    const TaskPool::Task fit = [&]( std::size_t i ){
+      KuramaTrack* track = candidates[i];
+      if( track->EstimateChiSqr()>MaxChiSqrKuramaEstimate )
+	return;
+      passed[i] = track->DoFit() && track->chisqr()<MaxChiSqrKuramaTrack;
+    };
+    if( EventDisplay::GetInstance().IsReady() ){
+      for( std::size_t i=0, n=candidates.size(); i<n; ++i )
+	fit( i );
+    } else {
+      TaskPool::GetInstance().Run( candidates.size(), fit );
+    }
+
+    for( std::size_t i=0, n=candidates.size(); is_warm && i<n; ++i )
+      if( passed[i] ) cache.Update( candidates[i] );
+  }
+
   //______________________________________________________________________________
   inline bool /* for MWPCCluster */
   isConnectable( double wire1, double leading1, double trailing1,
@@ -147,7 +203,7 @@ DCAnalyzer::DCAnalyzer( void )
     m_is_decoded[i] = false;
     m_much_combi[i] = 0;
   }
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 DCAnalyzer::~DCAnalyzer( void )
@@ -171,7 +227,7 @@ DCAnalyzer::~DCAnalyzer( void )
 #endif
   ClearDCHits();
   ClearVtxHits();
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -700,6 +756,7 @@ DCAnalyzer::DecodeCFT16Hits( RawData* rawData ,DCLocalTrack* tp , int i )
 bool
 DCAnalyzer::DecodeRawHits( RawData *rawData )
 {
+  debug::StageTimer timer( debug::kDCDecode );
   ClearDCHits();
 #if UseBcIn
   DecodeBcInHits( rawData );
@@ -835,6 +892,7 @@ DCAnalyzer::DecodeTOFHits( const HodoClusterContainer& ClCont )
 bool
 DCAnalyzer::TrackSearchBcIn( void )
 {
+  debug::StageTimer timer( debug::kTrackBcIn );
   track::MWPCLocalTrackSearch( &(m_BcInHC[1]), m_BcInTC );
   return true;
 }
@@ -843,6 +901,7 @@ DCAnalyzer::TrackSearchBcIn( void )
 bool
 DCAnalyzer::TrackSearchBcIn( const std::vector<std::vector<DCHitContainer> >& hc )
 {
+  debug::StageTimer timer( debug::kTrackBcIn );
   track::MWPCLocalTrackSearch( hc, m_BcInTC );
   return true;
 }
@@ -852,6 +911,7 @@ DCAnalyzer::TrackSearchBcIn( const std::vector<std::vector<DCHitContainer> >& hc
 bool
 DCAnalyzer::TrackSearchBcOut( void )
 {
+  debug::StageTimer timer( debug::kTrackBcOut );
   static const Int_t MinLayer = gUser.GetParameter("MinLayerBcOut");
 
   ClearTracksBcOut();
@@ -876,6 +936,7 @@ DCAnalyzer::TrackSearchBcOut( void )
 bool
 DCAnalyzer::TrackSearchBcOut( const BH2Filter::FilterList& hc )
 {
+  debug::StageTimer timer( debug::kTrackBcOut );
   static const Int_t MinLayer = gUser.GetParameter("MinLayerBcOut");
 
   ClearTracksBcOut();
@@ -898,6 +959,7 @@ DCAnalyzer::TrackSearchBcOut( const BH2Filter::FilterList& hc )
 bool
 DCAnalyzer::TrackSearchBcOut( int T0Seg )
 {
+  debug::StageTimer timer( debug::kTrackBcOut );
   static const int MinLayer = gUser.GetParameter("MinLayerBcOut");
 
 #if BcOut_Pair //Pair Plane Tracking Routine for BcOut
@@ -920,6 +982,7 @@ DCAnalyzer::TrackSearchBcOut( int T0Seg )
 bool
 DCAnalyzer::TrackSearchBcOut( const std::vector<std::vector<DCHitContainer> >& hc, int T0Seg )
 {
+  debug::StageTimer timer( debug::kTrackBcOut );
   static const int MinLayer = gUser.GetParameter("MinLayerBcOut");
 
 #if BcOut_Pair //Pair Plane Tracking Routine for BcOut
@@ -939,6 +1002,7 @@ DCAnalyzer::TrackSearchBcOut( const std::vector<std::vector<DCHitContainer> >& h
 bool
 DCAnalyzer::TrackSearchSdcIn( void )
 {
+  debug::StageTimer timer( debug::kTrackSdcIn );
   // static const int MinLayer = gUser.GetParameter("MinLayerSdcIn");
   // track::LocalTrackSearch( m_SdcInHC, PPInfoSdcIn, NPPInfoSdcIn, m_SdcInTC, MinLayer );
   // track::LocalTrackSearchSdcInFiber( m_SdcInHC, PPInfoSdcIn, NPPInfoSdcIn, m_SdcInTC, MinLayer );
@@ -949,6 +1013,7 @@ DCAnalyzer::TrackSearchSdcIn( void )
 bool
 DCAnalyzer::TrackSearchSdcOut( void )
 {
+  debug::StageTimer timer( debug::kTrackSdcOut );
   static const int MinLayer = gUser.GetParameter("MinLayerSdcOut");
 
   track::LocalTrackSearchSdcOut( m_SdcOutHC, PPInfoSdcOut, NPPInfoSdcOut,
@@ -961,6 +1026,7 @@ DCAnalyzer::TrackSearchSdcOut( void )
 bool
 DCAnalyzer::TrackSearchSdcOut( const Hodo2HitContainer& TOFCont )
 {
+  debug::StageTimer timer( debug::kTrackSdcOut );
   static const int MinLayer = gUser.GetParameter("MinLayerSdcOut");
 
   if( !DecodeTOFHits( TOFCont ) ) return false;
@@ -981,6 +1047,7 @@ DCAnalyzer::TrackSearchSdcOut( const Hodo2HitContainer& TOFCont )
 bool
 DCAnalyzer::TrackSearchSdcOut( const HodoClusterContainer& TOFCont )
 {
+  debug::StageTimer timer( debug::kTrackSdcOut );
   static const int MinLayer = gUser.GetParameter("MinLayerSdcOut");
 
   if( !DecodeTOFHits( TOFCont ) ) return false;
@@ -1010,6 +1077,7 @@ DCAnalyzer::TrackSearchBcOutSdcIn( void )
 bool
 DCAnalyzer::TrackSearchK18U2D( void )
 {
+  debug::StageTimer timer( debug::kTrackK18 );
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   ClearK18TracksU2D();
@@ -1107,6 +1175,7 @@ DCAnalyzer::TrackSearchK18U2D( void )
 bool
 DCAnalyzer::TrackSearchK18D2U( const std::vector<double>& XinCont )
 {
+  debug::StageTimer timer( debug::kTrackK18 );
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   ClearK18TracksD2U();
@@ -1183,6 +1252,7 @@ DCAnalyzer::TrackSearchK18D2U( const std::vector<double>& XinCont )
 bool
 DCAnalyzer::TrackSearchKurama( void )
 {
+  debug::StageTimer timer( debug::kTrackKurama );
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   ClearKuramaTracks();
@@ -1193,6 +1263,8 @@ DCAnalyzer::TrackSearchKurama( void )
   if( nIn==0 || nOut==0 ) {
     return true;
   }
+
+  std::vector<KuramaTrack*> candidates;
   for( std::size_t iIn=0; iIn<nIn; ++iIn ){
     DCLocalTrack *trIn = GetTrackSdcIn( iIn );
     if( !trIn->GoodForTracking() ) continue;
@@ -1202,26 +1274,25 @@ DCAnalyzer::TrackSearchKurama( void )
 
       KuramaTrack *trKurama = new KuramaTrack( trIn, trOut );
       if( !trKurama ) continue;
-      double u0In    = trIn->GetU0();
-      double u0Out   = trOut->GetU0();
-      double bending = u0Out - u0In;
-      double p[3] = { 0.08493, 0.2227, 0.01572 };
-      double initial_momentum = p[0] + p[1]/( bending-p[2] );
-      if( bending>0. && initial_momentum>0. ) {
-	trKurama->SetInitialMomentum( initial_momentum );
-      } else {
-	trKurama->SetInitialMomentum( 1. );
-      }
-      if( trKurama->DoFit() && trKurama->chisqr()<MaxChiSqrKuramaTrack ){
-	m_KuramaTC.push_back( trKurama );
-      }
-      else{
-	//	trKurama->Print( "in "+func_name );
-	delete trKurama;
-      }
+      trKurama->SetInitialMomentum( KuramaInitialMomentum( trIn, trOut ) );
+      candidates.push_back( trKurama );
     }// for( iOut )
   }// for( iIn )
 
+  std::vector<char> passed;
+  FitKuramaTracks( candidates, passed );
+
+  // in the order of the pairs as before
+  for( std::size_t i=0, n=candidates.size(); i<n; ++i ){
+    if( passed[i] ){
+      m_KuramaTC.push_back( candidates[i] );
+    }
+    else{
+      //	candidates[i]->Print( "in "+func_name );
+      delete candidates[i];
+    }
+  }
+
   std::sort( m_KuramaTC.begin(), m_KuramaTC.end(), KuramaTrackComp() );
 
 #if 0
@@ -1235,6 +1306,7 @@ DCAnalyzer::TrackSearchKurama( void )
 bool
 DCAnalyzer::TrackSearchKurama( double initial_momentum )
 {
+  debug::StageTimer timer( debug::kTrackKurama );
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   ClearKuramaTracks();
@@ -1244,6 +1316,7 @@ DCAnalyzer::TrackSearchKurama( double initial_momentum )
 
   if( nIn==0 || nOut==0 ) return true;
 
+  std::vector<KuramaTrack*> candidates;
   for( int iIn=0; iIn<nIn; ++iIn ){
     DCLocalTrack *trIn = GetTrackSdcIn( iIn );
     if( !trIn->GoodForTracking() ) continue;
@@ -1253,16 +1326,23 @@ DCAnalyzer::TrackSearchKurama( double initial_momentum )
       KuramaTrack *trKurama = new KuramaTrack( trIn, trOut );
       if( !trKurama ) continue;
       trKurama->SetInitialMomentum( initial_momentum );
-      if( trKurama->DoFit() && trKurama->chisqr()<MaxChiSqrKuramaTrack ){
-	m_KuramaTC.push_back( trKurama );
-      }
-      else{
-	trKurama->Print( " in "+func_name );
-	delete trKurama;
-      }
+      candidates.push_back( trKurama );
     }// for( iOut )
   }// for( iIn )
 
+  std::vector<char> passed;
+  FitKuramaTracks( candidates, passed );
+
+  for( std::size_t i=0, n=candidates.size(); i<n; ++i ){
+    if( passed[i] ){
+      m_KuramaTC.push_back( candidates[i] );
+    }
+    else{
+      candidates[i]->Print( " in "+func_name );
+      delete candidates[i];
+    }
+  }
+
   std::sort( m_KuramaTC.begin(), m_KuramaTC.end(), KuramaTrackComp() );
 
 #if 0
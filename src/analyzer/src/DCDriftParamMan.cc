@@ -21,8 +21,6 @@
 #include <TMath.h>
 #include <std_ostream.hh>
 
-#include "DeleteUtility.hh"
-
 namespace
 {
   const auto qnan = TMath::QuietNaN();
@@ -46,22 +44,7 @@ DCDriftParamMan::~DCDriftParamMan( void )
 void
 DCDriftParamMan::ClearElements( void )
 {
-  del::ClearMap( m_container );
-}
-
-//______________________________________________________________________________
-inline unsigned int
-MakeKey( int plane, double wire )
-{
-  return (plane<<10) | int(wire);
-}
-
-//______________________________________________________________________________
-inline void
-DecodeKey( unsigned int key, int& plane, int& wire )
-{
-  wire  = key & 0x3ff;
-  plane = key >> 10;
+  m_container.Clear();
 }
 
 //______________________________________________________________________________
@@ -102,16 +85,16 @@ DCDriftParamMan::Initialize( void )
       hddaq::cerr << func_name << " format is wrong : " << line << std::endl;
       continue;
     }
-    unsigned int key = MakeKey( pid, 0 );
-    DCDriftParamRecord *record = new DCDriftParamRecord( type, np, q );
-    if( m_container[key] ){
+    if( !m_container.Add( pid, 0, 0, 0,
+			  DCDriftParamRecord( pid, type, np, q ) ) ){
       hddaq::cerr << "#W " << func_name << " "
-		  << "duplicated key is deleted : " << key << std::endl;
-      delete m_container[key];
+		  << "duplicated record is replaced : PlaneId="
+		  << pid << std::endl;
     }
-    m_container[key] = record;
   }
 
+  m_container.Build();
+
   m_is_ready = true;
   return m_is_ready;
 }
@@ -125,15 +108,11 @@ DCDriftParamMan::Initialize( const std::string& file_name )
 }
 
 //______________________________________________________________________________
-DCDriftParamRecord*
-DCDriftParamMan::GetParameter( int PlaneId, double WireId ) const
+// wire id is not used at present
+const DCDriftParamRecord*
+DCDriftParamMan::GetParameter( int PlaneId, double /* WireId */ ) const
 {
-  WireId = 0;
-  unsigned int key = MakeKey( PlaneId, WireId );
-  DCDriftParamRecord *record = 0;
-  DCDriftIterator itr = m_container.find(key);
-  if( itr!=m_container.end() ) record = itr->second;
-  return record;
+  return m_container.Get( PlaneId, 0, 0, 0 );
 }
 
 //______________________________________________________________________________
@@ -304,17 +283,52 @@ DCDriftParamMan::CalcDrift( int PlaneId, double WireId, double ctime,
 			    double & dt, double & dl ) const
 {
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
-  DCDriftParamRecord *record = GetParameter(PlaneId,WireId);
+  const DCDriftParamRecord *record = GetParameter(PlaneId,WireId);
   if( !record ){
     hddaq::cerr << "#E " << func_name << " No record. "
 		<< " PlaneId=" << std::setw(3) << PlaneId
 		<< " WireId="  << std::setw(3) << WireId << std::endl;
     return false;
   }
+  return CalcDrift( *record, ctime, dt, dl );
+}
+
+//______________________________________________________________________________
+int
+DCDriftParamMan::GetIndex( int PlaneId, double WireId ) const
+{
+  static const std::string func_name("["+class_name+"::"+__func__+"()]");
+  // wire id is not used at present
+  const int index = m_container.Find( PlaneId, 0, 0, 0 );
+  if( index<0 ){
+    hddaq::cerr << "#E " << func_name << " No record. "
+		<< " PlaneId=" << std::setw(3) << PlaneId
+		<< " WireId="  << std::setw(3) << WireId << std::endl;
+  }
+  return index;
+}
+
+//______________________________________________________________________________
+bool
+DCDriftParamMan::CalcDrift( int index, double ctime,
+			    double & dt, double & dl ) const
+{
+  const DCDriftParamRecord *record = m_container.At( index );
+  if( !record )
+    return false;
+  return CalcDrift( *record, ctime, dt, dl );
+}
 
-  int type = record->type;
-  // int np   = record->np;
-  std::vector<double> p = record->param;
+//______________________________________________________________________________
+bool
+DCDriftParamMan::CalcDrift( const DCDriftParamRecord& record, double ctime,
+			    double & dt, double & dl ) const
+{
+  static const std::string func_name("["+class_name+"::"+__func__+"()]");
+  const int PlaneId = record.plane;
+  int type = record.type;
+  // int np   = record.np;
+  const std::vector<double>& p = record.param;
 
   dt = p[0]-ctime;
 
@@ -30,6 +30,7 @@ DCGeomMan::DCGeomMan( void )
   : m_is_ready(false),
     m_file_name(""),
     m_container(),
+    m_table(),
     m_detector_id_map(),
     m_global_z_map(),
     m_local_z_map()
@@ -246,6 +247,8 @@ const DCGeomRecord*
 DCGeomMan::GetRecord( int lnum ) const
 {
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
+  if( 0<=lnum && lnum<static_cast<int>(m_table.size()) && m_table[lnum] )
+    return m_table[lnum];
   DCGeomIterator itr = m_container.find(lnum);
   DCGeomIterator end = m_container.end();
   DCGeomRecord *record = 0;
@@ -347,6 +350,7 @@ void
 DCGeomMan::ClearElements( void )
 {
   del::ClearMap( m_container );
+  m_table.clear();
 }
 
 //______________________________________________________________________________
@@ -398,6 +402,15 @@ DCGeomMan::Initialize( void )
     }
   }
 
+  // direct lookup for the per-hit calls of the tracking
+  for( DCGeomIterator itr=m_container.begin(), end=m_container.end();
+       itr!=end; ++itr ){
+    if( itr->first<0 || !itr->second ) continue;
+    if( itr->first>=static_cast<int>(m_table.size()) )
+      m_table.resize( itr->first+1, 0 );
+    m_table[itr->first] = itr->second;
+  }
+
   m_is_ready = true;
   return m_is_ready;
 }
@@ -27,7 +27,8 @@ DCGeomRecord::DCGeomRecord( int id, const std::string &name,
 			    double w0, double dd, double ofs )
   : m_id(id), m_name(name), m_pos(x,y,z), m_tilt_angle(ta),
     m_rot_angle1(ra1), m_rot_angle2(ra2),
-    m_length(length), m_resolution(resol), m_w0(w0), m_dd(dd), m_offset(ofs)
+    m_length(length), m_resolution(resol), m_w0(w0), m_dd(dd), m_offset(ofs),
+    m_cos_tilt(), m_sin_tilt(), m_weight(1./(resol*resol))
 {
   CalcVectors();
 }
@@ -39,7 +40,8 @@ DCGeomRecord::DCGeomRecord( int id, const std::string &name,
 			    double w0, double dd, double ofs )
   : m_id(id), m_name(name), m_pos(pos),  m_tilt_angle(ta),
     m_rot_angle1(ra1), m_rot_angle2(ra2),
-    m_length(length), m_resolution(resol), m_w0(w0), m_dd(dd), m_offset(ofs)
+    m_length(length), m_resolution(resol), m_w0(w0), m_dd(dd), m_offset(ofs),
+    m_cos_tilt(), m_sin_tilt(), m_weight(1./(resol*resol))
 {
   CalcVectors();
 }
@@ -55,6 +57,8 @@ DCGeomRecord::CalcVectors( void )
 {
   double ct0 = std::cos( m_tilt_angle*math::Deg2Rad() );
   double st0 = std::sin( m_tilt_angle*math::Deg2Rad() );
+  m_cos_tilt = ct0;
+  m_sin_tilt = st0;
   double ct1 = std::cos( m_rot_angle1*math::Deg2Rad() );
   double st1 = std::sin( m_rot_angle1*math::Deg2Rad() );
   double ct2 = std::cos( m_rot_angle2*math::Deg2Rad() );
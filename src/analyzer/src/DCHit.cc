@@ -29,6 +29,7 @@
 namespace
 {
   const std::string& class_name("DCHit");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const DCGeomMan&       gGeom  = DCGeomMan::GetInstance();
   const DCTdcCalibMan&   gTdc   = DCTdcCalibMan::GetInstance();
   const DCDriftParamMan& gDrift = DCDriftParamMan::GetInstance();
@@ -43,7 +44,7 @@ DCHit::DCHit( void )
     m_mwpc_flag(false),
     m_ofs_dt(0.)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
@@ -54,7 +55,7 @@ DCHit::DCHit( int layer )
     m_mwpc_flag(false),
     m_ofs_dt(0.)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
@@ -65,14 +66,14 @@ DCHit::DCHit( int layer, double wire )
     m_mwpc_flag(false),
     m_ofs_dt(0.)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 DCHit::~DCHit( void )
 {
   ClearRegisteredHits();
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 void DCHit::SetTdcCFT( int tdc )
@@ -178,15 +179,17 @@ DCHit::CalcDCObservables( void )
   }// for(i)
 
 
+  const int tdc_index   = gTdc.GetIndex( m_layer, m_wire );
+  const int drift_index = gDrift.GetIndex( m_layer, m_wire );
   for ( int i=0; i<nh_tdc; ++i ) {
     double ctime;
-    if( !gTdc.GetTime( m_layer, m_wire, leading_cont.at(i), ctime ) ){
+    if( !gTdc.GetTime( tdc_index, leading_cont.at(i), ctime ) ){
       return false;
     } 
 
     double dtime, dlength;
     double corrected_ctime = ctime + m_ofs_dt;
-    if( !gDrift.CalcDrift( m_layer, m_wire, corrected_ctime, dtime, dlength ) ){
+    if( !gDrift.CalcDrift( drift_index, corrected_ctime, dtime, dlength ) ){
       status = false;
     } 
 
@@ -195,7 +198,7 @@ DCHit::CalcDCObservables( void )
 
     if(m_pair_cont.at(i).index_t != -1){
       double trailing_ctime;
-      gTdc.GetTime( m_layer, m_wire, trailing_cont.at(m_pair_cont.at(i).index_t), trailing_ctime );
+      gTdc.GetTime( tdc_index, trailing_cont.at(m_pair_cont.at(i).index_t), trailing_ctime );
       m_pair_cont.at(i).trailing_time = trailing_ctime;
       m_pair_cont.at(i).tot           = ctime - trailing_ctime;
     }else{
@@ -324,14 +327,16 @@ DCHit::CalcMWPCObservables( void )
   }// for(i)
 
 
+  const int tdc_index   = gTdc.GetIndex( m_layer, m_wire );
+  const int drift_index = gDrift.GetIndex( m_layer, m_wire );
   for ( int i=0; i<nh_tdc; ++i ) {
     double ctime;
-    if( !gTdc.GetTime( m_layer, m_wire, leading_cont.at(i), ctime ) ){
+    if( !gTdc.GetTime( tdc_index, leading_cont.at(i), ctime ) ){
       return false;
     } 
 
     double dtime, dlength;
-    if( !gDrift.CalcDrift( m_layer, m_wire, ctime, dtime, dlength ) ){
+    if( !gDrift.CalcDrift( drift_index, ctime, dtime, dlength ) ){
       status = false;
     } 
 
@@ -340,7 +345,7 @@ DCHit::CalcMWPCObservables( void )
 
     if(m_pair_cont.at(i).index_t != -1){
       double trailing_ctime;
-      gTdc.GetTime( m_layer, m_wire, trailing_cont.at(i), trailing_ctime );
+      gTdc.GetTime( tdc_index, trailing_cont.at(i), trailing_ctime );
       m_pair_cont.at(i).trailing_time = trailing_ctime;
       m_pair_cont.at(i).tot           = ctime - trailing_ctime;
     }else{
@@ -20,6 +20,7 @@
 namespace
 {
   const std::string& class_name("DCLTrackHit");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -34,7 +35,7 @@ DCLTrackHit::DCLTrackHit( DCHit *hit, double pos, int nh )
     m_vcal(-9999.),
     m_honeycomb(false)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
   m_hit->RegisterHits(this);
 }
 
@@ -51,13 +52,13 @@ DCLTrackHit::DCLTrackHit( const DCLTrackHit& right )
     m_honeycomb(right.m_honeycomb)
 {
   m_hit->RegisterHits(this);
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 DCLTrackHit::~DCLTrackHit( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -20,6 +20,7 @@
 #include "DCAnalyzer.hh"
 #include "DCLTrackHit.hh"
 #include "DCGeomMan.hh"
+#include "DCGeomRecord.hh"
 #include "DetectorID.hh"
 #include "MathTools.hh"
 #include "PrintHelper.hh"
@@ -28,6 +29,7 @@
 namespace
 {
   const std::string& class_name("DCLocalTrack");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const DCGeomMan& gGeom = DCGeomMan::GetInstance();
   const double& zK18tgt = gGeom.LocalZ("K18Target");
   const double& zTgt    = gGeom.LocalZ("Target");
@@ -40,6 +42,104 @@ namespace
   const int MaxIteration       = 100;// for Honeycomb
   const double MaxChisqrDiff   = 1.0e-3;
   const int CFTLocalMinNHits   =  3;
+  // hits of DoFit() kept on the stack, a longer track uses the heap
+  const std::size_t MaxFitHits = 32;
+
+  //____________________________________________________________________________
+  // normal equation of DCLocalTrack::DoFit() for x0, u0, y0, v0,
+  // the symmetric matrix is kept as its upper triangle
+  //   0 1 2 3
+  //     4 5 6
+  //       7 8
+  //         9
+  struct NormalEquation
+  {
+    double m[10];
+    double b[4];
+
+    void Clear( void )
+    {
+      for( int i=0; i<10; ++i ) m[i] = 0.;
+      for( int i=0; i<4; ++i )  b[i] = 0.;
+    }
+
+    void Add( double w, double ct, double st, double z, double s )
+    {
+      const double a[4] = { ct, z*ct, st, z*st };
+      int k = 0;
+      for( int p=0; p<4; ++p ){
+	const double wa = w*a[p];
+	for( int q=p; q<4; ++q )
+	  m[k++] += wa*a[q];
+	b[p] += wa*s;
+      }
+    }
+
+    NormalEquation& operator +=( const NormalEquation& other )
+    {
+      for( int i=0; i<10; ++i ) m[i] += other.m[i];
+      for( int i=0; i<4; ++i )  b[i] += other.b[i];
+      return *this;
+    }
+
+    double M( int i, int j ) const
+    {
+      static const int index[4][4] = { { 0, 1, 2, 3 },
+				       { 1, 4, 5, 6 },
+				       { 2, 5, 7, 8 },
+				       { 3, 6, 8, 9 } };
+      return m[index[i][j]];
+    }
+
+    // Cholesky decomposition, M = L L^T, false if M is singular
+    bool Solve( double x[4] ) const
+    {
+      double l[4][4] = {};
+      for( int j=0; j<4; ++j ){
+	double d = M(j,j);
+	for( int k=0; k<j; ++k ) d -= l[j][k]*l[j][k];
+	if( !( d>0. ) )
+	  return false;
+	l[j][j] = std::sqrt(d);
+	for( int i=j+1; i<4; ++i ){
+	  double e = M(j,i);
+	  for( int k=0; k<j; ++k ) e -= l[i][k]*l[j][k];
+	  l[i][j] = e/l[j][j];
+	}
+      }
+      double y[4];
+      for( int i=0; i<4; ++i ){
+	double e = b[i];
+	for( int k=0; k<i; ++k ) e -= l[i][k]*y[k];
+	y[i] = e/l[i][i];
+      }
+      for( int i=3; i>=0; --i ){
+	double e = y[i];
+	for( int k=i+1; k<4; ++k ) e -= l[k][i]*x[k];
+	x[i] = e/l[i][i];
+      }
+      return true;
+    }
+  };
+
+  //____________________________________________________________________________
+  // one hit of DCLocalTrack::DoFit()
+  struct FitHit
+  {
+    double         z0;   // wire plane
+    double         wp;   // wire position
+    double         w;    // 1/resolution^2
+    double         ct;   // cos(tilt)
+    double         st;   // sin(tilt)
+    double         ss;   // local hit position
+    double         dl;   // drift length
+    double         s;    // fitted position, left/right for honeycomb
+    double         z;
+    double         coss; // drift direction of honeycomb
+    double         sins;
+    bool           honeycomb;
+    NormalEquation eq;   // contribution of a honeycomb hit
+  };
 }
 
 //______________________________________________________________________________
@@ -66,7 +166,7 @@ DCLocalTrack::DCLocalTrack( void )
 {
   m_hit_array.reserve( ReservedNumOfHits );
   m_hit_arrayUV.reserve( ReservedNumOfHits );
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 
   m_total_dE     = 0; m_total_max_dE = 0;
   m_total_dE_phi = 0; m_total_max_dE_phi = 0;
@@ -91,7 +191,7 @@ DCLocalTrack::DCLocalTrack( void )
 //______________________________________________________________________________
 DCLocalTrack::~DCLocalTrack( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -293,61 +393,117 @@ DCLocalTrack::DoFit( void )
   }
 
   const int nItr = HasHoneycomb() ? MaxIteration : 1;
+  const int ndf  = GetNDF();
+
+  FitHit              stack_hit[MaxFitHits];
+  std::vector<FitHit> heap_hit;
+  FitHit *hit = stack_hit;
+  if( n>MaxFitHits ){
+    heap_hit.resize( n );
+    hit = &heap_hit[0];
+  }
+
+  // the straight hits do not move between the iterations
+  NormalEquation fixed;
+  fixed.Clear();
+  for( std::size_t i=0; i<n; ++i ){
+    const DCLTrackHit  *hitp   = m_hit_array[i];
+    const DCGeomRecord *record = gGeom.GetRecord( hitp->GetLayer() );
+    if( !record ){
+      hddaq::cerr << func_name << ": No record. Layer#="
+		  << hitp->GetLayer() << std::endl;
+      return false;
+    }
+    FitHit& h = hit[i];
+    h.honeycomb = hitp->IsHoneycomb();
+    h.wp = hitp->GetWirePosition();
+    h.z0 = hitp->GetZ();
+    h.w  = record->Weight();
+    // some hits are given their own tilt, e.g. the MWPC x/y hits
+    const double tilt = hitp->GetTiltAngle();
+    if( tilt==record->TiltAngle() ){
+      h.ct = record->CosTilt();
+      h.st = record->SinTilt();
+    }else{
+      h.ct = std::cos( tilt*math::Deg2Rad() );
+      h.st = std::sin( tilt*math::Deg2Rad() );
+    }
+    h.ss   = hitp->GetLocalHitPos();
+    h.dl   = hitp->GetDriftLength();
+    h.s    = h.ss;
+    h.z    = h.z0;
+    h.coss = 1.;
+    h.sins = 0.;
+    if( !h.honeycomb )
+      fixed.Add( h.w, h.ct, h.st, h.z, h.s );
+  }
 
   double prev_chisqr = m_chisqr;
-  std::vector <double> z0(n), z(n), wp(n),
-    w(n), s(n), ct(n), st(n), coss(n);
-  std::vector<bool> honeycomb(n);
+  // m_u0 or m_v0 changed since the drift direction was computed
+  bool   moved = true;
   for( int iItr=0; iItr<nItr; ++iItr ){
+    // left/right of the honeycomb hits, only the hits which changed are
+    // summed again
+    bool changed = moved;
+    NormalEquation eq = fixed;
     for( std::size_t i=0; i<n; ++i ){
-      DCLTrackHit *hitp = m_hit_array[i];
-      int    lnum = hitp->GetLayer();
-      honeycomb[i] = hitp->IsHoneycomb();
-      wp[i] = hitp->GetWirePosition();
-      z0[i] = hitp->GetZ();
-      double ww = gGeom.GetResolution( lnum );
-      w[i] = 1./(ww*ww);
-      double aa = hitp->GetTiltAngle()*math::Deg2Rad();
-      ct[i] = std::cos(aa); st[i] = std::sin(aa);
-      double ss = hitp->GetLocalHitPos();
-      double dl = hitp->GetDriftLength();
-      double dsdz = m_u0*std::cos(aa)+m_v0*std::sin(aa);
-      double dcos = std::cos( std::atan(dsdz) );
-      coss[i] = dcos;
-      double dsin = std::sin( std::atan(dsdz) );
-      double ds = dl * dcos;
-      double dz = dl * dsin;
-      double scal = iItr==0 ? ss : GetS(z[i],aa);
-      if( honeycomb[i] ){
-	s[i] = scal-wp[i]>0 ? wp[i]+ds : wp[i]-ds;
-	z[i] = scal-wp[i]>0 ? z0[i]-dz : z0[i]+dz;
-      }else{
-	s[i] = ss;
-	z[i] = z0[i];
+      FitHit& h = hit[i];
+      if( !h.honeycomb ) continue;
+      if( moved ){
+	// cos(atan(dsdz)), sin(atan(dsdz))
+	const double dsdz = m_u0*h.ct + m_v0*h.st;
+	h.coss = 1./std::sqrt( 1.+dsdz*dsdz );
+	h.sins = dsdz*h.coss;
       }
+      const double scal = iItr==0 ? h.ss :
+	(m_x0+m_u0*h.z)*h.ct + (m_y0+m_v0*h.z)*h.st;
+      const double ds = h.dl*h.coss;
+      const double dz = h.dl*h.sins;
+      const double s  = scal-h.wp>0 ? h.wp+ds : h.wp-ds;
+      const double z  = scal-h.wp>0 ? h.z0-dz : h.z0+dz;
+      if( moved || s!=h.s || z!=h.z ){
+	h.s = s;
+	h.z = z;
+	h.eq.Clear();
+	h.eq.Add( h.w, h.ct, h.st, z, s );
+	changed = true;
+      }
+      eq += h.eq;
+    }
+    moved = false;
+
+    // same equation as the last iteration, so is the chisqr
+    if( !changed ){
+      m_n_iteration = iItr;
+      break;
     }
 
-    double x0, u0, y0, v0;
-    if( !math::SolveGaussJordan( z, w, s, ct, st,
-				 x0, u0, y0, v0 ) ){
+    double p[4];
+    if( !eq.Solve( p ) ){
       hddaq::cerr << func_name << " Fitting failed" << std::endl;
       return false;
     }
+    const double x0 = p[0];
+    const double u0 = p[1];
+    const double y0 = p[2];
+    const double v0 = p[3];
 
     double chisqr = 0.;
     double de     = 0.;
     for( std::size_t i=0; i<n; ++i ){
-      double scal = (x0+u0*z0[i])*ct[i]+(y0+v0*z0[i])*st[i];
-      double ss   = wp[i]+(s[i]-wp[i])/coss[i];
-      double res  = honeycomb[i] ? (ss-scal)*coss[i] : s[i]-scal;
-      chisqr += w[i]*res*res;
+      const FitHit& h = hit[i];
+      double scal = (x0+u0*h.z0)*h.ct+(y0+v0*h.z0)*h.st;
+      double res  = h.honeycomb ?
+	( h.wp+(h.s-h.wp)/h.coss-scal )*h.coss : h.s-scal;
+      chisqr += h.w*res*res;
     }
-    chisqr /= GetNDF();
+    chisqr /= ndf;
 
     if( iItr==0 ) m_chisqr1st = chisqr;
 
     // if worse, not update
     if( prev_chisqr-chisqr>0. ){
+      moved = ( u0!=m_u0 || v0!=m_v0 );
       m_x0 = x0;
       m_y0 = y0;
       m_u0 = u0;
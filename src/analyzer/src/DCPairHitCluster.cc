@@ -11,6 +11,7 @@
 namespace
 {
   const std::string& class_name("DCPairHitCluster");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -21,13 +22,13 @@ DCPairHitCluster::DCPairHitCluster( DCLTrackHit *hitA, DCLTrackHit *hitB )
 {
   if(m_hitA) ++m_nhits;
   if(m_hitB) ++m_nhits;
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 DCPairHitCluster::~DCPairHitCluster( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -16,6 +16,7 @@
 namespace
 {
   const std::string& class_name("DCRawHit");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -26,13 +27,13 @@ DCRawHit::DCRawHit( int plane_id, int wire_id )
 {
   m_tdc.clear();
   m_trailing.clear();
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 DCRawHit::~DCRawHit( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -15,22 +15,11 @@
 
 #include <std_ostream.hh>
 
-#include "DeleteUtility.hh"
-
 namespace
 {
   const std::string& class_name("DCTdcCalibMan");
 }
 
-//______________________________________________________________________________
-struct DCTdcCalMap
-{
-  double p0, p1;
-  DCTdcCalMap( double q0, double q1 )
-    : p0(q0), p1(q1)
-  {}
-};
-
 //______________________________________________________________________________
 DCTdcCalibMan::DCTdcCalibMan( void )
   : m_is_ready(false),
@@ -48,14 +37,7 @@ DCTdcCalibMan::~DCTdcCalibMan( void )
 void
 DCTdcCalibMan::ClearElements( void )
 {
-  del::ClearMap( m_container );
-}
-
-//______________________________________________________________________________
-inline unsigned int
-MakeKey( int plane_id, double wire_id )
-{
-  return (plane_id<<10) | int(wire_id);
+  m_container.Clear();
 }
 
 //______________________________________________________________________________
@@ -86,10 +68,7 @@ DCTdcCalibMan::Initialize( void )
     int    plane_id=-1, wire_id=-1;
     double p0=-9999., p1=-9999.;
     if( iss >> plane_id >> wire_id >> p1 >> p0 ){
-      unsigned int key = MakeKey( plane_id, wire_id );
-      DCTdcCalMap *tdc_calib = new DCTdcCalMap( p0, p1 );
-      if( m_container[key] ) delete m_container[key];
-      m_container[key] = tdc_calib;
+      m_container.Add( plane_id, 0, wire_id, 0, DCTdcCalMap( p0, p1 ) );
     }
     else{
       hddaq::cerr << func_name << ": Bad format => "
@@ -97,6 +76,8 @@ DCTdcCalibMan::Initialize( void )
     }
   }
 
+  m_container.Build();
+
   m_is_ready = true;
   return m_is_ready;
 }
@@ -110,14 +91,10 @@ DCTdcCalibMan::Initialize( const std::string& file_name )
 }
 
 //______________________________________________________________________________
-DCTdcCalMap*
+const DCTdcCalMap*
 DCTdcCalibMan::GetMap( int plane_id, double wire_id ) const
 {
-  unsigned int key = MakeKey( plane_id, wire_id );
-  DCTdcCalMap *map = 0;
-  DCTdcIterator itr = m_container.find(key);
-  if( itr!=m_container.end() ) map = itr->second;
-  return map;
+  return m_container.Get( plane_id, 0, int(wire_id), 0 );
 }
 
 //______________________________________________________________________________
@@ -126,7 +103,7 @@ DCTdcCalibMan::GetTime( int plane_id, double wire_id,
 			int tdc, double& time ) const
 {
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
-  DCTdcCalMap *tdc_calib = GetMap( plane_id, wire_id );
+  const DCTdcCalMap *tdc_calib = GetMap( plane_id, wire_id );
   if( tdc_calib ){
     time = ( tdc + (tdc_calib->p0) ) * (tdc_calib->p1);
     return true;
@@ -140,13 +117,39 @@ DCTdcCalibMan::GetTime( int plane_id, double wire_id,
   }
 }
 
+//______________________________________________________________________________
+int
+DCTdcCalibMan::GetIndex( int plane_id, double wire_id ) const
+{
+  static const std::string func_name("["+class_name+"::"+__func__+"()]");
+  const int index = m_container.Find( plane_id, 0, int(wire_id), 0 );
+  if( index<0 ){
+    hddaq::cerr << func_name << ": No record. "
+		<< " PlaneId=" << std::setw(3) << std::dec << plane_id
+		<< " WireId="  << std::setw(3) << std::dec << wire_id
+		<< std::endl;
+  }
+  return index;
+}
+
+//______________________________________________________________________________
+bool
+DCTdcCalibMan::GetTime( int index, int tdc, double& time ) const
+{
+  const DCTdcCalMap *tdc_calib = m_container.At( index );
+  if( !tdc_calib )
+    return false;
+  time = ( tdc + (tdc_calib->p0) ) * (tdc_calib->p1);
+  return true;
+}
+
 //______________________________________________________________________________
 bool
 DCTdcCalibMan::GetTdc( int plane_id, double wire_id,
 		       double time, int &tdc ) const
 {
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
-  DCTdcCalMap *tdc_calib = GetMap( plane_id, wire_id );
+  const DCTdcCalMap *tdc_calib = GetMap( plane_id, wire_id );
   if( tdc_calib ){
     tdc = int((time-(tdc_calib->p0))/(tdc_calib->p1));
     return true;
@@ -166,7 +169,7 @@ DCTdcCalibMan::GetParameter( int plane_id, double wire_id,
 			     double &p0, double &p1 ) const
 {
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
-  DCTdcCalMap *tdc_calib = GetMap( plane_id, wire_id );
+  const DCTdcCalMap *tdc_calib = GetMap( plane_id, wire_id );
   if( tdc_calib ){
     p0 = tdc_calib->p0;
     p1 = tdc_calib->p1;
@@ -19,6 +19,7 @@
 #include "DetectorID.hh"
 #include "Hodo1Hit.hh"
 #include "Hodo2Hit.hh"
+#include "IndexCombination.hh"
 #include "MathTools.hh"
 #include "MWPCCluster.hh"
 #include "TrackMaker.hh"
@@ -79,29 +80,28 @@ namespace
 
 
   //_____________________________________________________________________
+  // Keeps a track only if it shares no hit with the tracks kept before it
+  // (or its chisqr is within ChisqrCut), in one pass over the ranked list.
+  // The hits of the kept tracks stay joined.
   inline void
   DeleteDuplicatedTracks( std::vector<DCLocalTrack*>& trackCont, double ChisqrCut=0. )
   {
-    // evaluate container size in every iteration
+    std::size_t nkeep = 0;
     for( std::size_t i=0, n=trackCont.size(); i<n; ++i ){
-      const DCLocalTrack* const tp = trackCont[i];
-      if (!tp) continue;
+      DCLocalTrack* tp = trackCont[i];
+      if( !tp ) continue;
       int nh = tp->GetNHit();
-      for(int j=0; j<nh; ++j) tp->GetHit(j)->JoinTrack();
-
-      for( std::size_t i2=trackCont.size()-1; i2>i; --i2 ){
-	const DCLocalTrack* tp2 = trackCont[i2];
-	int nh2 = tp2->GetNHit(), flag=0;
-	double chisqr = tp2->GetChiSquare();
-	for( int j=0; j<nh2; ++j )
-	  if( tp2->GetHit(j)->BelongToTrack() ) ++flag;
-	if( flag>0 && chisqr>ChisqrCut ){
-	  delete tp2;
-	  tp2 = 0;
-	  trackCont.erase(trackCont.begin()+i2);
-	}
+      bool shared = false;
+      for( int j=0; j<nh && !shared; ++j )
+	shared = tp->GetHit(j)->BelongToTrack();
+      if( shared && tp->GetChiSquare()>ChisqrCut ){
+	delete tp;
+	continue;
       }
+      for( int j=0; j<nh; ++j ) tp->GetHit(j)->JoinTrack();
+      trackCont[nkeep++] = tp;
     }
+    trackCont.resize( nkeep );
   }
 
   //_____________________________________________________________________
@@ -599,104 +599,66 @@ namespace
   }
 
   //___________________________________________________________________________
-  // MakeIndex ________________________________________________________________
+  // NumOfHits ________________________________________________________________
   //___________________________________________________________________________
+  // number of hits of each cluster candidate, used by IndexCombination to
+  // skip the combinations which cannot reach the minimum number of hits
   std::vector<IndexList>
-  MakeIndex( int ndim, const int *index1, bool& status)
+  NumOfHits( const std::vector<ClusterList>& CandCont )
   {
-    static const std::string func_name("["+class_name+"::"+__func__+"()]");
-
-    if( ndim==1 ){
-      std::vector<IndexList> index2;
-      for( int i=-1; i<index1[0]; ++i ){
-	IndexList elem(1,i);
-	index2.push_back(elem);
-      }
-      return index2;
-    }
-
-    std::vector<IndexList> index2 = MakeIndex( ndim-1, index1+1, status );
-
-    std::vector<IndexList> index;
-    int n2=index2.size();
-    for( int j=0; j<n2; ++j ){
-      for( int i=-1; i<index1[0]; ++i ){
-	IndexList elem;
-	int n3=index2[j].size();
-	elem.reserve(n3+1);
-	elem.push_back(i);
-	for( int k=0; k<n3; ++k )
-	  elem.push_back(index2[j][k]);
-	index.push_back(elem);
-	int size1=index.size();
-	if( size1>MaxCombi ){
-	  status = false;
-#if 1
-	  hddaq::cout << func_name << " too much combinations... " << n2 << std::endl;
-#endif
-	  return std::vector<IndexList>(0);
-	}
+    std::vector<IndexList> nHit( CandCont.size() );
+    for( std::size_t i=0, n=CandCont.size(); i<n; ++i ){
+      nHit[i].resize( CandCont[i].size(), 0 );
+      for( std::size_t j=0, m=CandCont[i].size(); j<m; ++j ){
+	if( CandCont[i][j] )
+	  nHit[i][j] = CandCont[i][j]->NumberOfHits();
       }
     }
-
-    return index;
+    return nHit;
   }
 
   //___________________________________________________________________________
-  std::vector<IndexList>
-  MakeIndex( int ndim, const IndexList& index1, bool& status )
+  // false if MaxCombi stopped the search, the searches then keep the
+  // tracks found so far but return -1 as before
+  bool
+  CheckCombination( const std::string& func_name,
+		    const IndexCombination& combination )
   {
-    return MakeIndex( ndim, &(index1[0]), status );
+    if( combination.IsTruncated() ){
+      hddaq::cout << func_name << " too much combinations... stopped after "
+		  << combination.GetNumOfCombi() << std::endl;
+      return false;
+    }
+    return true;
   }
 
   //___________________________________________________________________________
-  std::vector<IndexList>
-  MakeIndex_VXU( int ndim,int maximumHit, const int *index1 )
+  bool
+  CheckCombination( const std::string& func_name,
+		    const TrackMaker& trackMaker )
   {
-    static const std::string func_name("["+class_name+"::"+__func__+"()]");
-
-    if( ndim==1 ){
-      std::vector<IndexList> index2;
-      for( int i=-1; i<index1[0]; ++i ){
-	IndexList elem(1,i);
-	index2.push_back(elem);
-      }
-      return index2;
-    }
-
-    std::vector<IndexList>
-      index2=MakeIndex_VXU( ndim-1, maximumHit, index1+1 );
-
-    std::vector<IndexList> index;
-    int n2=index2.size();
-    for( int j=0; j<n2; ++j ){
-      for( int i=-1; i<index1[0]; ++i ){
-	IndexList elem;
-	int validHitNum=0;
-	int n3=index2[j].size();
-	elem.reserve(n3+1);
-	elem.push_back(i);
-	if (i != -1)
-	  validHitNum++;
-	for( int k=0; k<n3; ++k ){
-	  elem.push_back(index2[j][k]);
-	  if (index2[j][k] != -1)
-	    validHitNum++;
-	}
-	if (validHitNum <= maximumHit)
-	  index.push_back(elem);
-	// int size1=index.size();
-      }
+    if( trackMaker.IsTruncated() ){
+      hddaq::cout << func_name << " too much combinations... stopped after "
+		  << trackMaker.GetNumOfCombi() << std::endl;
+      return false;
     }
-
-    return index;
+    return true;
   }
 
   //___________________________________________________________________________
+  // MakeIndex_VXU ____________________________________________________________
+  //___________________________________________________________________________
+  // combinations with at most maximumHit planes
   std::vector<IndexList>
-  MakeIndex_VXU( int ndim,int maximumHit, const IndexList& index1 )
+  MakeIndex_VXU( int ndim, int maximumHit, const IndexList& index1 )
   {
-    return MakeIndex_VXU( ndim, maximumHit, &(index1[0]) );
+    std::vector<IndexList> index;
+    IndexCombination combination( IndexList( index1.begin(),
+					      index1.begin()+ndim ) );
+    combination.SetMaxNumOfPlanes( maximumHit );
+    for( ; !combination.IsEnd(); combination.Next() )
+      index.push_back( combination.Get() );
+    return index;
   }
 
   //___________________________________________________________________________
@@ -761,53 +723,46 @@ namespace track
       }
     }
 
+#if 0
     IndexList nCombi(npp);
     for( int i=0; i<npp; ++i ){
       int n = CandCont[i].size();
       nCombi[i] = n>MaxNumOfCluster ? 0 : n;
     }
-
-#if 0
     DebugPrint( nCombi, CandCont, func_name );
 #endif
 
-    bool status = true;
-    std::vector<IndexList> CombiIndex = MakeIndex( npp, nCombi, status );
-
-    for( int i=0, n=CombiIndex.size(); i<n; ++i ){
-      DCLocalTrack *track = MakeTrack( CandCont, CombiIndex[i] );
-      if( !track ) continue;
-      if( track->GetNHit()>=MinNumOfHits
-    	  && track->DoFit()
-    	  && track->GetChiSquare()<MaxChisquare ){
-
-	if (T0Seg>=0 && T0Seg<NumOfSegBH2) {
-	  double xbh2=track->GetX(zBH2), ybh2=track->GetY(zBH2);
-	  double difPosBh2 = localPosBh2X[T0Seg] - xbh2;
-
-	  //	  double xtgt=track->GetX(zTarget), ytgt=track->GetY(zTarget);
-	  //	  double ytgt=track->GetY(zTarget);
-
-	  if (true
-	      && fabs(difPosBh2)<Bh2SegXAcc[T0Seg]
-	      && (-10 < ybh2 && ybh2 < 40)
-	      //	      && fabs(ytgt)<21.
-	      ){
-	    TrackCont.push_back(track);
-	  }else{
-	    delete track;
-	  }
-
-	}else{
+    std::vector<DCLocalTrack*> FittedCont;
+    TrackMaker trackMaker( CandCont, MinNumOfHits, MaxCombi, MaxChisquare );
+    trackMaker.SetMaxNumOfCluster( MaxNumOfCluster );
+    trackMaker.MakeTracks( FittedCont );
+
+    for( std::size_t i=0, n=FittedCont.size(); i<n; ++i ){
+      DCLocalTrack *track = FittedCont[i];
+      if (T0Seg>=0 && T0Seg<NumOfSegBH2) {
+	double xbh2=track->GetX(zBH2), ybh2=track->GetY(zBH2);
+	double difPosBh2 = localPosBh2X[T0Seg] - xbh2;
+
+	//	double xtgt=track->GetX(zTarget), ytgt=track->GetY(zTarget);
+	//	double ytgt=track->GetY(zTarget);
+
+	if (true
+	    && fabs(difPosBh2)<Bh2SegXAcc[T0Seg]
+	    && (-10 < ybh2 && ybh2 < 40)
+	    //	    && fabs(ytgt)<21.
+	    ){
 	  TrackCont.push_back(track);
+	}else{
+	  delete track;
 	}
-      }
-      else{
-    	delete track;
+
+      }else{
+	TrackCont.push_back(track);
       }
     }
 
     FinalizeTrack( func_name, TrackCont, DCLTrackComp(), CandCont );
+    const bool status = CheckCombination( func_name, trackMaker );
     return status? TrackCont.size() : -1;
   }
 
@@ -866,15 +821,16 @@ namespace track
       nCombi[i] = n>MaxNumOfCluster ? 0 : n;
     }
 
-    bool status = true;
-    std::vector<IndexList> CombiIndex = MakeIndex( npp, nCombi, status );
+    IndexCombination combination( nCombi );
+    combination.SetMinNumOfHits( NumOfHits( CandCont ), MinNumOfHits );
+    combination.SetMaxCombi( MaxCombi );
 
 #if 0
     DebugPrint( nCombi, CandCont, func_name );
 #endif
 
-    for ( int i=0, n=CombiIndex.size(); i<n; ++i ) {
-      DCLocalTrack *track = MakeTrack( CandCont, CombiIndex[i] );
+    for( ; !combination.IsEnd(); combination.Next() ) {
+      DCLocalTrack *track = MakeTrack( CandCont, combination.Get() );
       if ( !track ) continue;
       if ( track->GetNHit()>=MinNumOfHits     &&
 	   track->GetNHitY() >= 2             &&
@@ -890,6 +846,7 @@ namespace track
     }
 
     FinalizeTrack( func_name, TrackCont, DCLTrackComp(), CandCont );
+    const bool status = CheckCombination( func_name, combination );
     return status? TrackCont.size() : -1;
   }
 
@@ -930,15 +887,16 @@ namespace track
       nCombi[i] = n>MaxNumOfCluster ? 0 : n;
     }
 
-    bool status = true;
-    std::vector<IndexList> CombiIndex = MakeIndex( npp, nCombi, status );
+    IndexCombination combination( nCombi );
+    combination.SetMinNumOfHits( NumOfHits( CandCont ), MinNumOfHits+2 );
+    combination.SetMaxCombi( MaxCombi );
 
 #if 0
     DebugPrint( nCombi, CandCont, func_name );
 #endif
 
-    for( int i=0, n=CombiIndex.size(); i<n; ++i ){
-      DCLocalTrack *track = MakeTrack( CandCont, CombiIndex[i] );
+    for( ; !combination.IsEnd(); combination.Next() ){
+      DCLocalTrack *track = MakeTrack( CandCont, combination.Get() );
       if( !track ) continue;
 
       static const int IdTOF_UX = gGeom.GetDetectorId("TOF-UX");
@@ -980,6 +938,7 @@ namespace track
     }
 
     FinalizeTrack( func_name, TrackCont, DCLTrackComp(), CandCont );
+    const bool status = CheckCombination( func_name, combination );
     return status? TrackCont.size() : -1;
   }
 
@@ -1009,31 +968,12 @@ namespace track
       }
     }
 
-    IndexList nCombi(npp);
-    for ( int i=0; i<npp; ++i ) {
-      int n = CandCont[i].size();
-      nCombi[i] = n>MaxNumOfCluster ? 0 : n;
-    }
-
-    bool status = true;
-    std::vector<IndexList> CombiIndex = MakeIndex( npp, nCombi, status );
-
-    for( int i=0, n=CombiIndex.size(); i<n; ++i ){
-      DCLocalTrack *track = MakeTrack( CandCont, CombiIndex[i] );
-      if( !track ) continue;
-
-      if(true
-	 && track->GetNHit()>=MinNumOfHits
-	 && track->DoFit()
-	 && track->GetChiSquare()<MaxChisquare
-	 ){
-     	TrackCont.push_back(track);
-      }
-      else
-	delete track;
-    }
+    TrackMaker trackMaker( CandCont, MinNumOfHits, MaxCombi, MaxChisquare );
+    trackMaker.SetMaxNumOfCluster( MaxNumOfCluster );
+    trackMaker.MakeTracks( TrackCont );
 
     FinalizeTrack( func_name, TrackCont, DCLTrackComp(), CandCont );
+    const bool status = CheckCombination( func_name, trackMaker );
     return status? TrackCont.size() : -1;
   }
 
@@ -1136,15 +1076,18 @@ namespace track
 #endif
 
     bool status[3] = {true, true, true};
-    std::vector<IndexList> CombiIndexV = MakeIndex( npp, nCombiV, status[0] );
-    int nnCombiV=CombiIndexV.size();
-    std::vector<IndexList> CombiIndexX = MakeIndex( npp, nCombiX, status[1] );
-    int nnCombiX=CombiIndexX.size();
-    std::vector<IndexList> CombiIndexU = MakeIndex( npp, nCombiU, status[2] );
-    int nnCombiU=CombiIndexU.size();
-
-    for( int i=0; i<nnCombiV; ++i ){
-      DCLocalTrack *track = MakeTrack( CandContV, CombiIndexV[i] );
+    IndexCombination combinationV( nCombiV );
+    combinationV.SetMinNumOfHits( NumOfHits( CandContV ), 3 );
+    combinationV.SetMaxCombi( MaxCombi );
+    IndexCombination combinationX( nCombiX );
+    combinationX.SetMinNumOfHits( NumOfHits( CandContX ), 3 );
+    combinationX.SetMaxCombi( MaxCombi );
+    IndexCombination combinationU( nCombiU );
+    combinationU.SetMinNumOfHits( NumOfHits( CandContU ), 3 );
+    combinationU.SetMaxCombi( MaxCombi );
+
+    for( ; !combinationV.IsEnd(); combinationV.Next() ){
+      DCLocalTrack *track = MakeTrack( CandContV, combinationV.Get() );
       if( !track ) continue;
       if( track->GetNHit()>=3 && track->DoFitVXU() &&
 	  track->GetChiSquare()<MaxChisquareVXU ){
@@ -1154,9 +1097,10 @@ namespace track
 	delete track;
       }
     }
+    status[0] = CheckCombination( func_name+" V", combinationV );
 
-    for( int i=0; i<nnCombiX; ++i ){
-      DCLocalTrack *track = MakeTrack( CandContX, CombiIndexX[i] );
+    for( ; !combinationX.IsEnd(); combinationX.Next() ){
+      DCLocalTrack *track = MakeTrack( CandContX, combinationX.Get() );
       if( !track ) continue;
       if( track->GetNHit()>=3 && track->DoFitVXU() &&
 	  track->GetChiSquare()<MaxChisquareVXU ){
@@ -1166,9 +1110,10 @@ namespace track
 	delete track;
       }
     }
+    status[1] = CheckCombination( func_name+" X", combinationX );
 
-    for( int i=0; i<nnCombiU; ++i ){
-      DCLocalTrack *track = MakeTrack( CandContU, CombiIndexU[i] );
+    for( ; !combinationU.IsEnd(); combinationU.Next() ){
+      DCLocalTrack *track = MakeTrack( CandContU, combinationU.Get() );
       if( !track ) continue;
       if( track->GetNHit()>=3 && track->DoFitVXU() &&
 	  track->GetChiSquare()<MaxChisquareVXU ){
@@ -1178,6 +1123,7 @@ namespace track
 	delete track;
       }
     }
+    status[2] = CheckCombination( func_name+" U", combinationU );
 
 
     std::stable_sort( TrackContV.begin(), TrackContV.end(), DCLTrackComp1() );
@@ -1664,23 +1610,18 @@ namespace track
     DebugPrint( nCombi, CandCont, func_name );
 #endif
 
-    bool status = true;
-    std::vector<IndexList> CombiIndex = MakeIndex( npp, nCombi, status );
-    int nnCombi = CombiIndex.size();
+    IndexCombination combination( nCombi );
+    combination.SetMinNumOfHits( NumOfHits( CandCont ), MinNumOfHits );
+    combination.SetMaxCombi( MaxCombi );
 
+    for( ; !combination.IsEnd(); combination.Next() ){
 #if 0
-    hddaq::cout << " ===> " << nnCombi << " combinations will be checked.."
-		<< std::endl;
-    for( int i=0; i<nnCombi; ++i ){
       for (int j=0;j<npp;j++) {
-	hddaq::cout << CombiIndex[i][j] << " ";
+	hddaq::cout << combination.Get()[j] << " ";
       }
       hddaq::cout << std::endl;
-    }
 #endif
-
-    for( int i=0; i<nnCombi; ++i ){
-      DCLocalTrack *track = MakeTrack( CandCont, CombiIndex[i] );
+      DCLocalTrack *track = MakeTrack( CandCont, combination.Get() );
       if( !track ) continue;
       if( track->GetNHit()>=MinNumOfHits && track->DoFitBcSdc() &&
 	  track->GetChiSquare()<MaxChisquare )
@@ -1688,6 +1629,7 @@ namespace track
       else
 	delete track;
     }
+    CheckCombination( func_name, combination );
 
     FinalizeTrack( func_name, TrackCont, DCLTrackComp(), CandCont );
 
@@ -1774,12 +1716,12 @@ namespace track
       nCombi[i] = n>MaxNumOfCluster ? 0 : n;
     }
 
-    bool status = true;
-    std::vector<IndexList> CombiIndex = MakeIndex( npp, nCombi, status );
-    int nnCombi = CombiIndex.size();
+    IndexCombination combination( nCombi );
+    combination.SetMinNumOfHits( NumOfHits( CandCont ), MinNumOfHits );
+    combination.SetMaxCombi( MaxCombi );
 
-    for( int i=0; i<nnCombi; ++i ){
-      DCLocalTrack *track = MakeTrack( CandCont, CombiIndex[i] );
+    for( ; !combination.IsEnd(); combination.Next() ){
+      DCLocalTrack *track = MakeTrack( CandCont, combination.Get() );
       if( !track ) continue;
       if( track->GetNHit()>=MinNumOfHits &&
 	  track->DoFit() &&
@@ -1790,6 +1732,7 @@ namespace track
     }
 
     FinalizeTrack( func_name, TrackCont, DCLTrackComp(), CandCont );
+    const bool status = CheckCombination( func_name, combination );
     return status? TrackCont.size() : -1;
   }
 
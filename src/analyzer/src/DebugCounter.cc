@@ -6,10 +6,10 @@
 
 #include "DebugCounter.hh"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
-#include <map>
 
 #include <std_ostream.hh>
 
@@ -22,7 +22,8 @@ namespace debug
 
 //_____________________________________________________________________
 ObjectCounter::ObjectCounter( void )
-  : m_map()
+  : m_counter(),
+    m_mutex()
 {
 }
 
@@ -31,6 +32,14 @@ ObjectCounter::~ObjectCounter( void )
 {
 }
 
+//_____________________________________________________________________
+void
+ObjectCounter::add( const Counter* counter )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_counter.push_back( counter );
+}
+
 //_____________________________________________________________________
 void
 ObjectCounter::check( const std::string& arg ) const
@@ -39,10 +48,11 @@ ObjectCounter::check( const std::string& arg ) const
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   bool has_leak = false;
-
-  ObjectIter itr, end=m_map.end();
-  for( itr=m_map.begin(); itr!=end; ++itr ){
-    if( itr->second!=0 ) has_leak = true;
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    for( std::size_t i=0, n=m_counter.size(); i<n; ++i ){
+      if( m_counter[i]->count()!=0 ) has_leak = true;
+    }
   }
 
   if( has_leak )
@@ -58,11 +68,42 @@ ObjectCounter::print( const std::string& arg ) const
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   hddaq::cout << "#DCounter " << func_name << " " << arg << std::endl;
-  ObjectIter itr, end=m_map.end();
-  for( itr=m_map.begin(); itr!=end; ++itr ){
+#ifdef MemoryLeak
+  std::lock_guard<std::mutex> lock( m_mutex );
+  std::vector<const Counter*> counter( m_counter );
+  std::sort( counter.begin(), counter.end(),
+	     []( const Counter* a, const Counter* b )
+	     { return a->key() < b->key(); } );
+  for( std::size_t i=0, n=counter.size(); i<n; ++i ){
     hddaq::cout << std::setw(20) << std::left
-		<< itr->first << " : " << itr->second << std::endl;
+		<< counter[i]->key() << " : " << counter[i]->count() << std::endl;
   }
+#endif
+}
+
+//_____________________________________________________________________
+void
+ObjectCounter::remove( const Counter* counter )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_counter.erase( std::remove( m_counter.begin(), m_counter.end(), counter ),
+		   m_counter.end() );
+}
+
+#ifdef MemoryLeak
+//_____________________________________________________________________
+ObjectCounter::Counter::Counter( const std::string& key )
+  : m_key(key),
+    m_count(0)
+{
+  ObjectCounter::GetInstance().add( this );
+}
+
+//_____________________________________________________________________
+ObjectCounter::Counter::~Counter( void )
+{
+  ObjectCounter::GetInstance().remove( this );
 }
+#endif
 
 }
@@ -0,0 +1,97 @@
+/**
+ *  file: DetectorMonitor.cc
+ *  date: 2026.10.17
+ *
+ */
+
+#include "DetectorMonitor.hh"
+
+#include <UnpackerManager.hh>
+#include <std_ostream.hh>
+
+#include "HistMaker.hh"
+#include "UserParamMan.hh"
+
+namespace
+{
+  const std::string& class_name("DetectorMonitor");
+  using namespace hddaq::unpacker;
+  const UnpackerManager& gUnpacker = GUnpacker::get_instance();
+  const UserParamMan&    gUser     = UserParamMan::GetInstance();
+
+  //____________________________________________________________________________
+  inline int
+  HistID( int hist, int flag, int detector, int data_type )
+  {
+    return ( hist & flag ) ?
+      HistMaker::getSequentialID( detector, 0, data_type ) : -1;
+  }
+}
+
+//______________________________________________________________________________
+DetectorMonitor&
+DetectorMonitor::GetInstance( void )
+{
+  static DetectorMonitor g_instance;
+  return g_instance;
+}
+
+//______________________________________________________________________________
+DetectorMonitor::DetectorMonitor( void )
+  : m_detector()
+{
+}
+
+//______________________________________________________________________________
+DetectorMonitor::~DetectorMonitor( void )
+{
+}
+
+//______________________________________________________________________________
+int
+DetectorMonitor::Add( const Spec& spec )
+{
+  static const std::string func_name("["+class_name+"::"+__func__+"()]");
+
+  const int device_id = gUnpacker.get_device_id( spec.device );
+  if( device_id<0 ){
+    hddaq::cerr << "#W " << func_name << " unknown device : "
+		<< spec.device << std::endl;
+    return -1;
+  }
+
+  const std::string& tdc    = spec.tdc.empty() ? "tdc" : spec.tdc;
+  const std::string& window = spec.window.empty() ?
+    "Tdc"+spec.device : spec.window;
+
+  Detector d;
+  d.name      = spec.device;
+  d.device_id = device_id;
+  d.adc_id    = ( spec.hist & (kFillADC|kFillADCwTDC|kGateADC) ) ?
+    gUnpacker.get_data_id( spec.device, "adc" ) : -1;
+  d.tdc_id    = gUnpacker.get_data_id( spec.device, tdc );
+  d.n_segment = spec.n_segment;
+  d.n_ud      = spec.n_ud;
+  d.gate_adc  = ( spec.hist & kGateADC );
+  d.tdc_min   = gUser.GetParameter( window, 0 );
+  d.tdc_max   = gUser.GetParameter( window, 1 );
+  d.adc_hid   = HistID( spec.hist, kFillADC,     spec.detector, kADC );
+  d.tdc_hid   = HistID( spec.hist, kFillTDC,     spec.detector, kTDC );
+  d.awt_hid   = HistID( spec.hist, kFillADCwTDC, spec.detector, kADCwTDC );
+  d.hit_hid   = HistID( spec.hist, kFillHitPat,  spec.detector, kHitPat );
+  d.mul_hid   = HistID( spec.hist, kFillMulti,   spec.detector, kMulti );
+
+  m_detector.push_back( d );
+  return m_detector.size()-1;
+}
+
+//______________________________________________________________________________
+int
+DetectorMonitor::GetIndex( const std::string& device ) const
+{
+  for( int i=0, n=m_detector.size(); i<n; ++i ){
+    if( m_detector[i].name==device )
+      return i;
+  }
+  return -1;
+}
@@ -22,6 +22,7 @@ namespace
 //______________________________________________________________________________
 EventAnalyzer::EventAnalyzer( void )
   : TObject(),
+    m_arena_scope(),
     m_bh2filter_is_applied( false ),
     m_raw_data( new RawData ),
     m_dc_analyzer( new DCAnalyzer ),
@@ -0,0 +1,200 @@
+/**
+ *  file: EventArena.cc
+ *  date: 2026.10.17
+ *
+ */
+
+#include "EventArena.hh"
+
+#include <algorithm>
+#include <new>
+#include <string>
+
+#include <std_ostream.hh>
+
+namespace
+{
+  const std::string& class_name("EventArena");
+  const std::size_t BlockSize = 1 << 20;
+  const std::size_t Alignment = 16;
+
+  //____________________________________________________________________________
+  inline std::size_t
+  Align( std::size_t size )
+  {
+    return ( size + Alignment - 1 ) & ~( Alignment - 1 );
+  }
+}
+
+//______________________________________________________________________________
+EventArena&
+EventArena::GetInstance( void )
+{
+  static thread_local EventArena g_instance;
+  return g_instance;
+}
+
+//______________________________________________________________________________
+EventArena::EventArena( void )
+  : m_block(),
+    m_retired(),
+    m_current(0),
+    m_offset(0),
+    m_n_live(0),
+    m_depth(0),
+    m_is_warned(false)
+{
+}
+
+//______________________________________________________________________________
+EventArena::~EventArena( void )
+{
+  // objects still alive keep pointing into their blocks
+  for( std::size_t i=0, n=m_block.size(); i<n; ++i )
+    if( m_block[i].n_live==0 ) ::operator delete( m_block[i].begin );
+  for( std::size_t i=0, n=m_retired.size(); i<n; ++i )
+    if( m_retired[i].n_live==0 ) ::operator delete( m_retired[i].begin );
+}
+
+//______________________________________________________________________________
+void*
+EventArena::Allocate( std::size_t size )
+{
+  EventArena& arena = GetInstance();
+  if( arena.m_depth==0 )
+    return ::operator new( size );
+  void* p = arena.AllocateInBlock( Align( size ) );
+  ++arena.m_n_live;
+  return p;
+}
+
+//______________________________________________________________________________
+void*
+EventArena::AllocateInBlock( std::size_t size )
+{
+  while( m_current<m_block.size() ){
+    Block& b = m_block[m_current];
+    if( m_offset+size<=b.size ){
+      void* p = b.begin + m_offset;
+      m_offset += size;
+      ++b.n_live;
+      return p;
+    }
+    ++m_current;
+    m_offset = 0;
+  }
+  const std::size_t block_size = std::max( size, BlockSize );
+  Block b = { static_cast<char*>( ::operator new( block_size ) ),
+	      block_size, 1 };
+  m_block.push_back( b );
+  m_current = m_block.size()-1;
+  m_offset  = size;
+  return b.begin;
+}
+
+//______________________________________________________________________________
+void
+EventArena::Begin( void )
+{
+  ++m_depth;
+}
+
+//______________________________________________________________________________
+void
+EventArena::Deallocate( void* p )
+{
+  if( !p )
+    return;
+  EventArena& arena = GetInstance();
+  if( Block* b = Find( arena.m_block, p ) ){
+    --b->n_live;
+    --arena.m_n_live;
+    return;
+  }
+  if( Block* b = Find( arena.m_retired, p ) ){
+    --arena.m_n_live;
+    if( --b->n_live==0 ){
+      ::operator delete( b->begin );
+      arena.m_retired.erase( arena.m_retired.begin()+( b-&arena.m_retired[0] ) );
+    }
+    return;
+  }
+  ::operator delete( p );
+}
+
+//______________________________________________________________________________
+void
+EventArena::End( void )
+{
+  static const std::string func_name("["+class_name+"::"+__func__+"()]");
+
+  if( --m_depth>0 )
+    return;
+
+  // set aside the blocks with objects outliving the event
+  std::size_t size = 0;
+  std::size_t n_free = 0;
+  for( std::size_t i=0, n=m_block.size(); i<n; ++i ){
+    Block& b = m_block[i];
+    if( b.n_live>0 ){
+      if( !m_is_warned ){
+	m_is_warned = true;
+	hddaq::cerr << "#W " << func_name << " " << b.n_live
+		    << " objects outlive the event, their block is set aside"
+		    << std::endl;
+      }
+      m_retired.push_back( b );
+      continue;
+    }
+    m_block[n_free++] = b;
+    size += b.size;
+  }
+  m_block.resize( n_free );
+
+  // a single block is enough from the next event on
+  if( m_block.size()>1 ){
+    for( std::size_t i=0, n=m_block.size(); i<n; ++i )
+      ::operator delete( m_block[i].begin );
+    Block b = { static_cast<char*>( ::operator new( size ) ), size, 0 };
+    m_block.assign( 1, b );
+  }
+  m_current = 0;
+  m_offset  = 0;
+}
+
+//______________________________________________________________________________
+EventArena::Block*
+EventArena::Find( std::vector<Block>& blocks, const void* p )
+{
+  const char* c = static_cast<const char*>( p );
+  for( std::size_t i=0, n=blocks.size(); i<n; ++i ){
+    Block& b = blocks[i];
+    if( c>=b.begin && c<b.begin+b.size )
+      return &b;
+  }
+  return 0;
+}
+
+//______________________________________________________________________________
+std::size_t
+EventArena::GetCapacity( void ) const
+{
+  std::size_t size = 0;
+  for( std::size_t i=0, n=m_block.size(); i<n; ++i )
+    size += m_block[i].size;
+  for( std::size_t i=0, n=m_retired.size(); i<n; ++i )
+    size += m_retired[i].size;
+  return size;
+}
+
+//______________________________________________________________________________
+EventArena::Scope::Scope( void )
+{
+  EventArena::GetInstance().Begin();
+}
+
+//______________________________________________________________________________
+EventArena::Scope::~Scope( void )
+{
+  EventArena::GetInstance().End();
+}
@@ -13,6 +13,7 @@
 namespace
 {
   const std::string& class_name("FLHit");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -24,7 +25,7 @@ FLHit::FLHit( FiberHit* ptr, int index )
   m_hit_u->RegisterHits(this);
   m_hit_u->SetJoined(index);
   Initialize();
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
@@ -38,13 +39,13 @@ FLHit::FLHit( FiberHit* ptr1,  FiberHit* ptr2,
   m_hit_u->SetJoined(index1);
   m_hit_d->SetJoined(index2);
   Initialize();
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 FLHit::~FLHit( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -23,6 +23,7 @@ static const bool reject_nan = false;
 namespace
 {
   const std::string& class_name("FiberCluster");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -32,14 +33,14 @@ FiberCluster::FiberCluster( void )
   for ( int i=0; i<sizeFlagsFiber; ++i ){
     m_flag[i] = false;
   }
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 FiberCluster::~FiberCluster( void )
 {
   m_hit_container.clear();
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
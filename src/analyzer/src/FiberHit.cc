@@ -27,6 +27,7 @@
 namespace
 {
   const std::string& class_name("FiberHit");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const DCGeomMan&    gGeom = DCGeomMan::GetInstance();
   const HodoParamMan& gHodo = HodoParamMan::GetInstance();
   const HodoPHCMan&   gPHC  = HodoPHCMan::GetInstance();
@@ -55,14 +56,14 @@ FiberHit::FiberHit( HodoRawHit *object, const char* name )
     m_r(0.),
     m_phi(0.)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 FiberHit::~FiberHit( void )
 {
   del::ClearContainer( m_hit_container );
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -184,11 +185,12 @@ FiberHit::Calculate( void )
       }
   }// for(i)
 
+  const int t_index = gHodo.GetTIndex( cid, plid, seg, m_ud );
   for(int i = 0; i<m_multi_hit_l; ++i){
     // leading
     int leading = leading_cont.at(i);
     double time_leading = -999.;
-    if( !gHodo.GetTime(cid, plid, seg, m_ud, leading, time_leading) ){
+    if( !gHodo.GetTime(t_index, leading, time_leading) ){
       hddaq::cerr << "#E " << func_name
 		  << " something is wrong at GetTime("
 		  << cid  << ", " << plid          << ", " << seg  << ", "
@@ -210,7 +212,7 @@ FiberHit::Calculate( void )
     // trailing
     int trailing = trailing_cont.at(m_pair_cont.at(i).index_t);
     double time_trailing = -999.;
-    if( !gHodo.GetTime(cid, plid, seg, m_ud, trailing, time_trailing) ){
+    if( !gHodo.GetTime(t_index, trailing, time_trailing) ){
       hddaq::cerr << "#E " << func_name
 		  << " something is wrong at GetTime("
 		  << cid  << ", " << plid          << ", " << seg  << ", "
@@ -81,36 +81,64 @@ FieldMan::GetField( const ThreeVector& position ) const
   }
 
 #if 1
-  FEIterator itr, itr_end = m_element_list.end();
-  for( itr=m_element_list.begin(); itr!=itr_end; ++itr ){
-    if( (*itr)->ExistField( position ) )
-      field += (*itr)->GetField( position );
-  }
+  field += GetElementField( position );
 #endif
 
   return field;
 }
 
+//______________________________________________________________________________
+// B, dB/dx and dB/dy in one call, the map part from the interpolation
+// kernel and the field elements (if any) by finite difference
+void
+FieldMan::GetFieldAndGradient( const ThreeVector& position,
+			       ThreeVector& field,
+			       ThreeVector& dBdX, ThreeVector& dBdY ) const
+{
+  field.SetXYZ( 0., 0., 0. );
+  dBdX.SetXYZ( 0., 0., 0. );
+  dBdY.SetXYZ( 0., 0., 0. );
+  if( m_kurama_map ){
+    double p[3], b[3], bx[3], by[3];
+    p[0] = position.x()*0.1;
+    p[1] = position.y()*0.1;
+    p[2] = position.z()*0.1;
+    if( m_kurama_map->GetFieldValue( p, b, bx, by ) ){
+      // Tesla/cm -> Tesla/mm
+      field.SetXYZ( b[0], b[1], b[2] );
+      dBdX.SetXYZ( 0.1*bx[0], 0.1*bx[1], 0.1*bx[2] );
+      dBdY.SetXYZ( 0.1*by[0], 0.1*by[1], 0.1*by[2] );
+    }
+  }
+
+#if 1
+  if( !m_element_list.empty() ){
+    field += GetElementField( position );
+    ThreeVector dx( Delta, 0., 0. ), dy( 0., Delta, 0. );
+    dBdX += 0.5/Delta*( GetElementField( position+dx )
+			- GetElementField( position-dx ) );
+    dBdY += 0.5/Delta*( GetElementField( position+dy )
+			- GetElementField( position-dy ) );
+  }
+#endif
+}
+
 //______________________________________________________________________________
 ThreeVector
 FieldMan::GetdBdX( const ThreeVector& position ) const
 {
-  ThreeVector p1 = position + ThreeVector( Delta, 0., 0. );
-  ThreeVector p2 = position - ThreeVector( Delta, 0., 0. );
-  ThreeVector B1 = GetField( p1 );
-  ThreeVector B2 = GetField( p2 );
-  return 0.5/Delta*(B1-B2);
+  ThreeVector B, dBdX, dBdY;
+  GetFieldAndGradient( position, B, dBdX, dBdY );
+  return dBdX;
 }
 
 //______________________________________________________________________________
 ThreeVector
 FieldMan::GetdBdY( const ThreeVector& position ) const
 {
-  ThreeVector p1 = position + ThreeVector( 0., Delta, 0. );
-  ThreeVector p2 = position - ThreeVector( 0., Delta, 0. );
-  ThreeVector B1 = GetField( p1 );
-  ThreeVector B2 = GetField( p2 );
-  return 0.5/Delta*(B1-B2);
+  ThreeVector B, dBdX, dBdY;
+  GetFieldAndGradient( position, B, dBdX, dBdY );
+  return dBdY;
 }
 
 //______________________________________________________________________________
@@ -124,6 +152,19 @@ FieldMan::GetdBdZ( const ThreeVector& position ) const
   return 0.5/Delta*(B1-B2);
 }
 
+//______________________________________________________________________________
+ThreeVector
+FieldMan::GetElementField( const ThreeVector& position ) const
+{
+  ThreeVector field( 0., 0., 0. );
+  FEIterator itr, itr_end = m_element_list.end();
+  for( itr=m_element_list.begin(); itr!=itr_end; ++itr ){
+    if( (*itr)->ExistField( position ) )
+      field += (*itr)->GetField( position );
+  }
+  return field;
+}
+
 //______________________________________________________________________________
 void
 FieldMan::ClearElementsList( void )
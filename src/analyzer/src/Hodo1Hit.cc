@@ -23,6 +23,7 @@
 namespace
 {
   const std::string& class_name("Hodo1Hit");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const HodoParamMan& gHodo = HodoParamMan::GetInstance();
   const HodoPHCMan&   gPHC  = HodoPHCMan::GetInstance();
 }
@@ -35,13 +36,13 @@ HodoHit::~HodoHit(){};
 Hodo1Hit::Hodo1Hit( HodoRawHit *rhit, int index )
   : HodoHit(), m_raw(rhit), m_is_calculated(false), m_index(index)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 Hodo1Hit::~Hodo1Hit( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -96,6 +97,7 @@ Hodo1Hit::Calculate( bool tdc_flag )
 
   m_a.push_back(dE);
 
+  const int t_index = gHodo.GetTIndex( cid, plid, seg, UorD );
   int mhit = m_multi_hit_l;
   for( int m=0; m<mhit; ++m ){
     int    tdc  = -999;
@@ -108,7 +110,7 @@ Hodo1Hit::Calculate( bool tdc_flag )
 
     if( tdc<0 ) continue;
 
-    if( !gHodo.GetTime( cid, plid, seg, UorD, tdc, time ) ){
+    if( !gHodo.GetTime( t_index, tdc, time ) ){
       hddaq::cerr << "#E " << func_name
 		  << " something is wrong at GetTime("
 		  << cid  << ", " << plid << ", " << seg  << ", "
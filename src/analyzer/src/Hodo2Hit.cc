@@ -23,6 +23,7 @@
 namespace
 {
   const std::string& class_name("Hodo2Hit");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const HodoParamMan& gHodo = HodoParamMan::GetInstance();
   const HodoPHCMan&   gPHC = HodoPHCMan::GetInstance();
 }
@@ -34,13 +35,13 @@ Hodo2Hit::Hodo2Hit( HodoRawHit *rhit, double max_time_diff)
     m_is_tof(false),
     m_max_time_diff(max_time_diff)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 Hodo2Hit::~Hodo2Hit( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -112,12 +113,15 @@ Hodo2Hit::Calculate( void )
   std::vector<double> ctime1;
   std::vector<double> ctime2;
 
+  const int t_index1 = gHodo.GetTIndex( cid, plid, seg, 0 );
+  const int t_index2 = gHodo.GetTIndex( cid, plid, seg, 1 );
+
   // Tdc1
   for(int i = 0; i<n_mhit1; ++i){
     int tdc = m_raw->GetTdc1(i);
 
     double time = 0.;
-    if( !gHodo.GetTime( cid, plid, seg, 0, tdc, time )){
+    if( !gHodo.GetTime( t_index1, tdc, time )){
       hddaq::cerr << "#E " << func_name
 		  << " something is wrong at GetTime("
 		  << cid  << ", " << plid << ", " << seg  << ", "
@@ -138,7 +142,7 @@ Hodo2Hit::Calculate( void )
     int tdc = m_raw->GetTdc2(i);
 
     double time = 0.;
-    if( !gHodo.GetTime( cid, plid, seg, 1, tdc, time )){
+    if( !gHodo.GetTime( t_index2, tdc, time )){
       hddaq::cerr << "#E " << func_name
 		  << " something is wrong at GetTime("
 		  << cid  << ", " << plid << ", " << seg  << ", "
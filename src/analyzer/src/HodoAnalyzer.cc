@@ -31,6 +31,7 @@
 namespace
 {
   const std::string& class_name("HodoAnalyzer");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const double MaxTimeDifBH1 =  2.0;
   const double MaxTimeDifBH2 =  2.0;
   const double MaxTimeDifSAC = -1.0;
@@ -53,7 +54,7 @@ namespace
 //______________________________________________________________________________
 HodoAnalyzer::HodoAnalyzer( void )
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
@@ -75,7 +76,7 @@ HodoAnalyzer::~HodoAnalyzer( void )
   ClearFHT1Hits();
   ClearFHT2Hits();
 #endif
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -21,6 +21,7 @@
 namespace
 {
   const std::string& class_name("HodoCluster");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -38,13 +39,13 @@ HodoCluster::HodoCluster( HodoHit *hitA, HodoHit *hitB, HodoHit *hitC )
   if(hitB) ++m_cluster_size;
   if(hitC) ++m_cluster_size;
   //  Calculate();
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 HodoCluster::~HodoCluster( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
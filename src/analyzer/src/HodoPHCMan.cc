@@ -19,7 +19,6 @@
 
 #include <std_ostream.hh>
 
-#include "DeleteUtility.hh"
 #include "MathTools.hh"
 
 namespace
@@ -157,7 +156,7 @@ HodoPHCMan::~HodoPHCMan()
 //______________________________________________________________________________
 void HodoPHCMan::ClearElements( void )
 {
-  del::ClearMap( m_container );
+  m_container.Clear();
 }
 
 //______________________________________________________________________________
@@ -191,14 +190,11 @@ HodoPHCMan::Initialize( void )
       double p = 0.;
       while( input_line >> p ) par.push_back(p);
       int key = MakeKey(cid,plid,seg,ud);
-      HodoPHCParam *param = new HodoPHCParam(type,np,par);
-      HodoPHCParam *pre_param = m_container[key];
-      m_container[key] = param;
-      if( pre_param ){
+      if( !m_container.Add( cid, plid, seg, ud,
+			    HodoPHCParam(type,np,par) ) ){
 	hddaq::cerr << func_name << ": duplicated key "
 		    << " following record is deleted." << std::endl
 		    << " key = " << key << std::endl;
-	delete pre_param;
       }
     }
     else{
@@ -207,6 +203,8 @@ HodoPHCMan::Initialize( void )
     }
   }
 
+  m_container.Build();
+
   m_is_ready = true;
   return true;
 }
@@ -225,7 +223,7 @@ HodoPHCMan::DoCorrection( int cid, int plid, int seg, int ud,
 			  double time, double de, double & ctime ) const
 {
   ctime = time;
-  HodoPHCParam* map = GetMap(cid,plid,seg,ud);
+  const HodoPHCParam* map = GetMap(cid,plid,seg,ud);
   if(!map) return false;
   ctime = map->DoPHC(time,de);
   return true;
@@ -237,19 +235,15 @@ HodoPHCMan::DoRCorrection( int cid, int plid, int seg, int ud,
 			   double time, double de, double & ctime ) const
 {
   ctime = time;
-  HodoPHCParam* map = GetMap(cid,plid,seg,ud);
+  const HodoPHCParam* map = GetMap(cid,plid,seg,ud);
   if(!map) return false;
   ctime = map->DoRPHC(time,de);
   return true;
 }
 
 //______________________________________________________________________________
-HodoPHCParam*
+const HodoPHCParam*
 HodoPHCMan::GetMap( int cid, int plid, int seg, int ud ) const
 {
-  int key = MakeKey(cid,plid,seg,ud);
-  HodoPHCParam* map = 0;
-  PhcPIterator  itr = m_container.find(key);
-  if( itr != m_container.end() ) map = itr->second;
-  return map;
+  return m_container.Get( cid, plid, seg, ud );
 }
@@ -15,8 +15,6 @@
 
 #include <std_ostream.hh>
 
-#include "DeleteUtility.hh"
-
 namespace
 {
   const std::string& class_name("HodoParamMan");
@@ -39,21 +37,28 @@ HodoParamMan::HodoParamMan( void )
 //______________________________________________________________________________
 HodoParamMan::~HodoParamMan( void )
 {
-  ClearACont(); ClearTCont();
+  ClearACont(); ClearTCont(); ClearFCont();
 }
 
 //______________________________________________________________________________
 void
 HodoParamMan::ClearACont( void )
 {
-  del::ClearMap( m_APContainer );
+  m_APContainer.Clear();
 }
 
 //______________________________________________________________________________
 void
 HodoParamMan::ClearTCont( void )
 {
-  del::ClearMap( m_TPContainer );
+  m_TPContainer.Clear();
+}
+
+//______________________________________________________________________________
+void
+HodoParamMan::ClearFCont( void )
+{
+  m_FPContainer.Clear();
 }
 
 //______________________________________________________________________________
@@ -85,7 +90,7 @@ HodoParamMan::Initialize( void )
     return false;
   }
 
-  ClearACont(); ClearTCont();
+  ClearACont(); ClearTCont(); ClearFCont();
 
   int invalid=0;
   std::string line;
@@ -99,39 +104,28 @@ HodoParamMan::Initialize( void )
     if( input_line >> cid >> plid >> seg >> at >> ud >> p0 >> p1 ){
       int key = KEY( cid, plid, seg, ud );
       if( at == kAdc ){
-	HodoAParam *pre_param = m_APContainer[key];
-	HodoAParam *param = new HodoAParam(p0,p1);
-	m_APContainer[key] = param;
-	if( pre_param ){
+	if( !m_APContainer.Add( cid, plid, seg, ud, HodoAParam(p0,p1) ) ){
 	  hddaq::cerr << func_name << ": duplicated key "
 		      << " following record is deleted." << std::endl
 		      << " key = " << key << std::endl;
-	  delete pre_param;
 	}
       }
       else if( at == kTdc ){
-	HodoTParam *pre_param = m_TPContainer[key];
-	HodoTParam *param = new HodoTParam(p0,p1);
-	m_TPContainer[key] = param;
-	if( pre_param ){
+	if( !m_TPContainer.Add( cid, plid, seg, ud, HodoTParam(p0,p1) ) ){
 	  hddaq::cerr << func_name << ": duplicated key "
 		      << " following record is deleted." << std::endl
 		      << " key = " << key << std::endl;
-	  delete pre_param;
 	}
       }
       else if(at == 2){
       }
       else if(at == 3){// for fiber position correction
 	if(input_line  >> p2 >> p3>> p4 >> p5 ){
-	  HodoFParam *pre_param = m_FPContainer[key];
-	  HodoFParam *param = new HodoFParam(p0,p1,p2,p3,p4,p5);
-	  m_FPContainer[key] = param;
-	  if( pre_param ){
+	  if( !m_FPContainer.Add( cid, plid, seg, ud,
+				  HodoFParam(p0,p1,p2,p3,p4,p5) ) ){
 	    hddaq::cerr << func_name << ": duplicated key "
 			<< " following record is deleted." << std::endl
 			<< " key = " << key << std::endl;
-	    delete pre_param;
 	  }
 	}
       }else{
@@ -145,6 +139,10 @@ HodoParamMan::Initialize( void )
     } /* if( input_line >> ) */
   } /* while( std::getline ) */
 
+  m_APContainer.Build();
+  m_TPContainer.Build();
+  m_FPContainer.Build();
+
   m_is_ready = true;
   return true;
 }
@@ -161,7 +159,7 @@ HodoParamMan::Initialize( const std::string& file_name )
 bool
 HodoParamMan::GetTime( int cid, int plid, int seg, int ud, int tdc, double &time ) const
 {
-  HodoTParam* map = GetTmap( cid, plid, seg, ud );
+  const HodoTParam* map = GetTmap( cid, plid, seg, ud );
   if(!map) return false;
   time = map->Time( tdc );
   return true;
@@ -171,7 +169,27 @@ HodoParamMan::GetTime( int cid, int plid, int seg, int ud, int tdc, double &time
 bool
 HodoParamMan::GetDe( int cid, int plid, int seg, int ud, int adc, double &de ) const
 {
-  HodoAParam* map = GetAmap( cid, plid, seg, ud );
+  const HodoAParam* map = GetAmap( cid, plid, seg, ud );
+  if(!map) return false;
+  de = map->DeltaE( adc );
+  return true;
+}
+
+//______________________________________________________________________________
+bool
+HodoParamMan::GetTime( int t_index, int tdc, double &time ) const
+{
+  const HodoTParam* map = m_TPContainer.At( t_index );
+  if(!map) return false;
+  time = map->Time( tdc );
+  return true;
+}
+
+//______________________________________________________________________________
+bool
+HodoParamMan::GetDe( int a_index, int adc, double &de ) const
+{
+  const HodoAParam* map = m_APContainer.At( a_index );
   if(!map) return false;
   de = map->DeltaE( adc );
   return true;
@@ -179,7 +197,7 @@ HodoParamMan::GetDe( int cid, int plid, int seg, int ud, int adc, double &de ) c
 
 double HodoParamMan::GetP0( int cid, int plid, int seg, int ud ) const
 {
-  HodoAParam* map=GetAmap(  cid, plid, seg, ud);
+  const HodoAParam* map=GetAmap(  cid, plid, seg, ud);
   if(!map) return -1;
 
   double p0=map->Pedestal();
@@ -187,7 +205,7 @@ double HodoParamMan::GetP0( int cid, int plid, int seg, int ud ) const
 }
 double HodoParamMan::GetP1( int cid, int plid, int seg, int ud ) const
 {
-  HodoAParam* map=GetAmap(  cid, plid, seg, ud);
+  const HodoAParam* map=GetAmap(  cid, plid, seg, ud);
   if(!map) return -1;
 
   double p1=map->Gain();
@@ -195,7 +213,7 @@ double HodoParamMan::GetP1( int cid, int plid, int seg, int ud ) const
 }
 double HodoParamMan::GetPar( int cid, int plid, int seg, int ud, int i ) const
 {
-  HodoFParam *map=GetFmap(cid,plid,seg,ud);
+  const HodoFParam *map=GetFmap(cid,plid,seg,ud);
   if(!map) return -1;
 
   double par=0;
@@ -214,7 +232,7 @@ double HodoParamMan::GetPar( int cid, int plid, int seg, int ud, int i ) const
 double
 HodoParamMan::GetOffset(int cid, int plid, int seg, int ud) const
 {
-  HodoTParam* map = GetTmap( cid, plid, seg, ud );
+  const HodoTParam* map = GetTmap( cid, plid, seg, ud );
   if(!map) return -9999.;
 
   return map->Offset();
@@ -225,7 +243,7 @@ HodoParamMan::GetOffset(int cid, int plid, int seg, int ud) const
 double
 HodoParamMan::GetGain(int cid, int plid, int seg, int ud) const
 {
-  HodoTParam* map = GetTmap( cid, plid, seg, ud );
+  const HodoTParam* map = GetTmap( cid, plid, seg, ud );
   if(!map) return -9999.;
 
   return map->Gain();
@@ -234,37 +252,22 @@ HodoParamMan::GetGain(int cid, int plid, int seg, int ud) const
 
 
 //______________________________________________________________________________
-HodoTParam*
+const HodoTParam*
 HodoParamMan::GetTmap( int cid, int plid, int seg, int ud ) const
 {
-  int key = KEY(cid,plid,seg,ud);
-  HodoTParam* map     = 0;
-  TIterator   itr     = m_TPContainer.find(key);
-  TIterator   itr_end = m_TPContainer.end();
-  if( itr!=itr_end ) map = itr->second;
-  return map;
+  return m_TPContainer.Get( cid, plid, seg, ud );
 }
 
 //______________________________________________________________________________
-HodoAParam*
+const HodoAParam*
 HodoParamMan::GetAmap( int cid, int plid, int seg, int ud ) const
 {
-  int key = KEY(cid,plid,seg,ud);
-  HodoAParam* map     = 0;
-  AIterator   itr     = m_APContainer.find(key);
-  AIterator   itr_end = m_APContainer.end();
-  if( itr!=itr_end ) map = itr->second;
-  return map;
+  return m_APContainer.Get( cid, plid, seg, ud );
 }
 
 //______________________________________________________________________________
-HodoFParam*
+const HodoFParam*
 HodoParamMan::GetFmap( int cid, int plid, int seg, int ud ) const
 {
-  int key = KEY(cid,plid,seg,ud);
-  HodoFParam* map     = 0;
-  FIterator   itr     = m_FPContainer.find(key);
-  FIterator   itr_end = m_FPContainer.end();
-  if( itr!=itr_end ) map = itr->second;
-  return map;
+  return m_FPContainer.Get( cid, plid, seg, ud );
 }
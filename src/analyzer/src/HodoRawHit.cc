@@ -13,6 +13,7 @@
 namespace
 {
   const std::string class_name("HodoRawHit");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -25,13 +26,13 @@ HodoRawHit::HodoRawHit( int detector_id, int plane_id, int segment_id )
     m_tdc_t1(1, -1), m_tdc_t2(1, -1),
     m_oftdc( false ), m_nhtdc(0)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 HodoRawHit::~HodoRawHit( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
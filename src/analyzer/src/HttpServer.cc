@@ -20,11 +20,26 @@
 
 #include "JsRootUpdater.hh"
 
+#include "DebugStageTimer.hh"
 #include "FuncName.hh"
 #include "HttpServer.hh"
 
 ClassImp(HttpServer);
 
+namespace
+{
+  const TString ProfileItem = "/Profile";
+
+  //___________________________________________________________________________
+  // publisher task, latency percentiles of the analysis stages
+  void
+  UpdateProfile( void )
+  {
+    HttpServer::GetInstance().SetItemField( ProfileItem, "value",
+					    debug::StageProfile::table() );
+  }
+}
+
 //_____________________________________________________________________________
 HttpServer::HttpServer( void )
   : TObject(),
@@ -104,6 +119,12 @@ HttpServer::Open( void )
   m_server->RegisterCommand("/Reset", "HttpServer::GetInstance().ResetAll()");
   m_server->RegisterCommand("/Restart", "gSystem->Exit(0)");
   // m_server->RegisterCommand("/MakePs", "HttpServer::GetInstance().MakePs()");
+  analyzer::JsRootUpdater::getInstance().setServer(m_server);
+#ifdef ProfileStage
+  m_server->CreateItem( ProfileItem, "Latency of the analysis stages" );
+  m_server->SetItemField( ProfileItem, "_kind", "Text" );
+  analyzer::JsRootUpdater::getInstance().addTask( &UpdateProfile );
+#endif
   std::cout << "#D HttpServer::Open()" << std::endl
 	    << "   Port : " << m_port << std::endl;
 }
@@ -177,6 +198,8 @@ HttpServer::ResetAll( void )
   std::cout << "#D HttpServer::ResetAll()" << std::endl;
   for( auto&& h : m_th1_list )
     h->Reset();
+  analyzer::JsRootUpdater::getInstance().requestReset();
+  debug::StageProfile::reset();
 }
 
 //_____________________________________________________________________________
@@ -0,0 +1,157 @@
+/**
+ *  file: IndexCombination.cc
+ *  date: 2026.10.17
+ *
+ */
+
+#include "IndexCombination.hh"
+
+#include <algorithm>
+
+//______________________________________________________________________________
+IndexCombination::IndexCombination( const IndexList& nIndex )
+  : m_ndim( nIndex.size() ),
+    m_n_index( nIndex ),
+    m_index( nIndex.size(), -1 ),
+    m_n_hit(),
+    m_max_below( nIndex.size()+1, 0 ),
+    m_min_hit( 0 ),
+    m_max_plane( nIndex.size() ),
+    m_max_combi( -1. ),
+    m_n_combi( 0. ),
+    m_is_end( false ),
+    m_is_truncated( false )
+{
+  Restart();
+}
+
+//______________________________________________________________________________
+IndexCombination::~IndexCombination( void )
+{
+}
+
+//______________________________________________________________________________
+// increment the index of plane (lower planes are reset) until an
+// acceptable combination is found
+void
+IndexCombination::Advance( int plane )
+{
+  int p = plane;
+  for( int q=0; q<p && q<m_ndim; ++q )
+    m_index[q] = -1;
+
+  for(;;){
+    while( p<m_ndim && ++m_index[p]>=m_n_index[p] ){
+      m_index[p] = -1;
+      ++p;
+    }
+    if( p>=m_ndim ){
+      m_is_end = true;
+      return;
+    }
+    // whole block of lower planes cannot be accepted
+    if( !IsPossible( p ) )
+      continue;
+    if( IsPossible( 0 ) )
+      break;
+    p = 0;
+  }
+
+  if( m_max_combi>=0. && ++m_n_combi>m_max_combi ){
+    m_is_end       = true;
+    m_is_truncated = true;
+  }
+}
+
+//______________________________________________________________________________
+bool
+IndexCombination::IsPossible( int plane ) const
+{
+  int nhit   = m_max_below[plane];
+  int nplane = 0;
+  for( int q=plane; q<m_ndim; ++q ){
+    int m = m_index[q];
+    if( m<0 ) continue;
+    ++nplane;
+    if( !m_n_hit.empty() )
+      nhit += m_n_hit[q][m];
+  }
+  return nhit>=m_min_hit && nplane<=m_max_plane;
+}
+
+//______________________________________________________________________________
+void
+IndexCombination::Next( void )
+{
+  if( !m_is_end )
+    Advance( 0 );
+}
+
+//______________________________________________________________________________
+// start again from the first acceptable combination (all planes unused)
+void
+IndexCombination::Restart( void )
+{
+  std::fill( m_index.begin(), m_index.end(), -1 );
+  m_n_combi      = 0.;
+  m_is_truncated = false;
+  m_is_end       = ( m_ndim==0 );
+  if( m_is_end )
+    return;
+  if( IsPossible( 0 ) ){
+    if( m_max_combi>=0. && ++m_n_combi>m_max_combi ){
+      m_is_end       = true;
+      m_is_truncated = true;
+    }
+  }
+  else{
+    Advance( 0 );
+  }
+}
+
+//______________________________________________________________________________
+void
+IndexCombination::SetMaxCombi( double maxCombi )
+{
+  m_max_combi = maxCombi;
+  Restart();
+}
+
+//______________________________________________________________________________
+void
+IndexCombination::SetMaxNumOfPlanes( int maxPlane )
+{
+  m_max_plane = maxPlane;
+  Restart();
+}
+
+//______________________________________________________________________________
+// nHit[plane][index] is an upper limit of the number of hits added by
+// the cluster index of plane
+void
+IndexCombination::SetMinNumOfHits( const std::vector<IndexList>& nHit,
+				   int minHit )
+{
+  m_n_hit   = nHit;
+  m_min_hit = minHit;
+  m_n_hit.resize( m_ndim );
+  m_max_below[0] = 0;
+  for( int q=0; q<m_ndim; ++q ){
+    m_n_hit[q].resize( std::max( m_n_index[q], 0 ), 0 );
+    int max_hit = 0;
+    for( int i=0; i<m_n_index[q]; ++i )
+      max_hit = std::max( max_hit, m_n_hit[q][i] );
+    m_max_below[q+1] = m_max_below[q] + max_hit;
+  }
+  Restart();
+}
+
+//______________________________________________________________________________
+// skip the remaining combinations which share the indices of the planes
+// >= plane with the current one
+void
+IndexCombination::Skip( int plane )
+{
+  if( !m_is_end )
+    Advance( plane );
+}
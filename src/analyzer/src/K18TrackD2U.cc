@@ -31,6 +31,7 @@ namespace
 {
   using namespace K18Parameter;
   const std::string& class_name("K18TrackD2U");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const DCGeomMan&      gGeom   = DCGeomMan::GetInstance();
   const K18TransMatrix& gK18Mtx = K18TransMatrix::GetInstance();
   const double& zK18Target = gGeom.LocalZ("K18Target");
@@ -54,13 +55,13 @@ K18TrackD2U::K18TrackD2U( double local_x, DCLocalTrack *track_out, double p0 )
     m_Xo(0), m_Yo(0), m_Uo(0), m_Vo(0),
     m_status(false), m_good_for_analysis(true)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 K18TrackD2U::~K18TrackD2U( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -1,12 +1,19 @@
 // -*- C++ -*-
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <string>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <std_ostream.hh>
 
 #include "ConfMan.hh"
@@ -20,6 +27,90 @@ namespace
   const ConfMan& gConf = ConfMan::GetInstance();
   const Double_t& valueNMR  = ConfMan::Get<Double_t>("FLDNMR");
   const Double_t& valueCalc = ConfMan::Get<Double_t>("FLDCALC");
+
+  // binary cache written next to the text map:
+  // CacheHeader followed by 3*Nx*Ny*Nz floats.
+  // It is taken for the text map of the same size, mtime and sampled
+  // hash (head and SampleCount blocks spread over the file), so the
+  // startup reads a few hundred kB instead of the whole map.
+  const char CacheMagic[8] = { 'K', 'F', 'M', 'A', 'P', 'B', '0', '2' };
+  const std::size_t SampleHead  = 1<<16;
+  const std::size_t SampleBlock = 1<<12;
+  const Int_t       SampleCount = 16;
+
+  struct CacheHeader
+  {
+    char      magic[8];
+    Int_t     nx, ny, nz, reserved;
+    Double_t  x0, y0, z0;
+    Double_t  dx, dy, dz;
+    Double_t  calc;             // FLDCALC at creation, for information
+    ULong64_t source_size;
+    ULong64_t source_mtime;
+    ULong64_t source_sample;    // sampled hash of the text map
+    ULong64_t source_checksum;  // of the whole text map, for information
+    ULong64_t data_checksum;    // of the float array, for information
+  };
+
+  //____________________________________________________________________________
+  // FNV-1a
+  ULong64_t
+  Checksum( const void* data, std::size_t size,
+	    ULong64_t hash=14695981039346656037ULL )
+  {
+    const UChar_t* p = static_cast<const UChar_t*>( data );
+    for( std::size_t i=0; i<size; ++i ){
+      hash ^= p[i];
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  //____________________________________________________________________________
+  // whole file, only when the cache is written
+  Bool_t
+  FileChecksum( const TString& file_name, ULong64_t& hash )
+  {
+    std::ifstream ifs( file_name, std::ios::binary );
+    if( !ifs.is_open() )
+      return false;
+    std::vector<char> buf( 1<<20 );
+    hash = Checksum( 0, 0 );
+    while( ifs ){
+      ifs.read( buf.data(), buf.size() );
+      hash = Checksum( buf.data(), ifs.gcount(), hash );
+    }
+    return true;
+  }
+
+  //____________________________________________________________________________
+  // size, mtime and hash of the head and of blocks spread over the file
+  Bool_t
+  FileKey( const TString& file_name, ULong64_t& size, ULong64_t& mtime,
+	   ULong64_t& sample )
+  {
+    struct stat st;
+    if( ::stat( file_name, &st )!=0 )
+      return false;
+    std::ifstream ifs( file_name, std::ios::binary );
+    if( !ifs.is_open() )
+      return false;
+    size  = st.st_size;
+    mtime = st.st_mtime;
+    std::vector<char> buf( SampleHead );
+    ifs.read( buf.data(), buf.size() );
+    sample = Checksum( buf.data(), ifs.gcount() );
+    if( size<=SampleHead )
+      return true;
+    const ULong64_t span = size - SampleBlock;
+    for( Int_t i=1; i<=SampleCount; ++i ){
+      ifs.clear();
+      ifs.seekg( span*i/SampleCount );
+      ifs.read( buf.data(), SampleBlock );
+      sample = Checksum( buf.data(), ifs.gcount(), sample );
+    }
+    return true;
+  }
 }
 
 //______________________________________________________________________________
@@ -27,7 +118,14 @@ KuramaFieldMap::KuramaFieldMap( const TString& file_name )
   : TObject(),
     m_is_ready(false),
     m_file_name(file_name),
-    Nx(0), Ny(0), Nz(0)
+    B(0),
+    m_buffer(),
+    m_map_addr(0),
+    m_map_size(0),
+    m_factor(0.),
+    Nx(0), Ny(0), Nz(0),
+    m_inv_dx(0.), m_inv_dy(0.), m_inv_dz(0.),
+    m_stride_x(0), m_stride_y(0)
 {
 }
 
@@ -37,6 +135,13 @@ KuramaFieldMap::~KuramaFieldMap( void )
   ClearField();
 }
 
+//______________________________________________________________________________
+TString
+KuramaFieldMap::CacheFileName( void ) const
+{
+  return m_file_name + ".bin";
+}
+
 //______________________________________________________________________________
 Bool_t
 KuramaFieldMap::Initialize( void )
@@ -56,6 +161,98 @@ KuramaFieldMap::Initialize( void )
 
   ClearField();
 
+  if( valueCalc==0. || !std::isfinite(valueCalc) ||
+      valueNMR==0.  || !std::isfinite(valueNMR)  ){
+    // hddaq::cerr << " KuramaField is zero : "
+    // 	       << " Calc = " << valueCalc
+    // 	       << " NMR = " << valueNMR << std::endl;
+    return true;
+  }
+  m_factor = valueNMR/valueCalc;
+
+  ULong64_t source_size = 0, source_mtime = 0, source_sample = 0;
+  if( !FileKey( m_file_name, source_size, source_mtime, source_sample ) ){
+    hddaq::cerr << "#E " << FUNC_NAME << " file read fail : "
+		<< m_file_name << std::endl;
+    return false;
+  }
+
+  if( LoadCache( source_size, source_mtime, source_sample ) ){
+    hddaq::cout << " fieldmap cache " << CacheFileName() << std::endl;
+    SetGrid();
+    m_is_ready = true;
+    return true;
+  }
+
+  if( !ReadText( ifs ) )
+    return false;
+
+  ULong64_t source_checksum = 0;
+  if( !FileChecksum( m_file_name, source_checksum ) ||
+      !WriteCache( source_size, source_mtime, source_sample,
+		   source_checksum ) ){
+    hddaq::cerr << "#W " << FUNC_NAME << " cannot write cache : "
+		<< CacheFileName() << std::endl;
+  }
+
+  SetGrid();
+  m_is_ready = true;
+  return true;
+}
+
+//______________________________________________________________________________
+Bool_t
+KuramaFieldMap::LoadCache( ULong64_t source_size, ULong64_t source_mtime,
+			   ULong64_t source_sample )
+{
+  const TString cache_name = CacheFileName();
+  Int_t fd = ::open( cache_name, O_RDONLY );
+  if( fd<0 )
+    return false;
+
+  struct stat st;
+  if( ::fstat( fd, &st )!=0 ||
+      static_cast<std::size_t>( st.st_size )<sizeof(CacheHeader) ){
+    ::close( fd );
+    return false;
+  }
+
+  std::size_t size = st.st_size;
+  void* addr = ::mmap( 0, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  ::close( fd );
+  if( addr==MAP_FAILED )
+    return false;
+
+  // the cache is renamed into place complete, the size check catches
+  // a truncated copy. The pages are touched only by GetFieldValue().
+  const CacheHeader* header = static_cast<const CacheHeader*>( addr );
+  const Float_t* data = reinterpret_cast<const Float_t*>( header+1 );
+  const std::size_t n = 3*std::size_t(header->nx)*header->ny*header->nz;
+  const Bool_t status =
+    std::equal( CacheMagic, CacheMagic+sizeof(CacheMagic), header->magic ) &&
+    header->nx>=0 && header->ny>=0 && header->nz>=0 &&
+    size==sizeof(CacheHeader)+n*sizeof(Float_t) &&
+    header->source_size==source_size &&
+    header->source_mtime==source_mtime &&
+    header->source_sample==source_sample;
+  if( !status ){
+    ::munmap( addr, size );
+    return false;
+  }
+
+  Nx = header->nx; Ny = header->ny; Nz = header->nz;
+  X0 = header->x0; Y0 = header->y0; Z0 = header->z0;
+  dX = header->dx; dY = header->dy; dZ = header->dz;
+  B          = data;
+  m_map_addr = addr;
+  m_map_size = size;
+  return true;
+}
+
+//______________________________________________________________________________
+Bool_t
+KuramaFieldMap::ReadText( std::istream& ifs )
+{
   if( !( ifs >> Nx >> Ny >> Nz >> X0 >> Y0 >> Z0 >> dX >> dY >> dZ ) ){
     hddaq::cerr << "#E " << FUNC_NAME << " invalid format" << std::endl;
     return false;
@@ -66,22 +263,8 @@ KuramaFieldMap::Initialize( void )
     return false;
   }
 
-  B.resize( Nx );
-  for( Int_t ix=0; ix<Nx; ++ix ){
-    B[ix].resize( Ny );
-    for( Int_t iy=0; iy<Ny; ++iy ){
-      B[ix][iy].resize( Nz );
-    }
-  }
-
-  if( valueCalc==0. || !std::isfinite(valueCalc) ||
-      valueNMR==0.  || !std::isfinite(valueNMR)  ){
-    // hddaq::cerr << " KuramaField is zero : "
-    // 	       << " Calc = " << valueCalc
-    // 	       << " NMR = " << valueNMR << std::endl;
-    return true;
-  }
-  const Double_t factor    = valueNMR/valueCalc;
+  m_buffer.assign( 3*std::size_t(Nx)*Ny*Nz, 0.f );
+  B = m_buffer.data();
 
   Double_t x, y, z, bx, by, bz;
 
@@ -96,79 +279,170 @@ KuramaFieldMap::Initialize( void )
     Int_t iy = Int_t((y-Y0+0.1*dY)/dY);
     Int_t iz = Int_t((z-Z0+0.1*dZ)/dZ);
     if( ix>=0 && ix<Nx && iy>=0 && iy<Ny && iz>=0 && iz<Nz ){
-      B[ix][iy][iz].x = bx*factor;
-      B[ix][iy][iz].y = by*factor;
-      B[ix][iy][iz].z = bz*factor;
+      std::size_t i = 3*( ( std::size_t(ix)*Ny + iy )*Nz + iz );
+      m_buffer[i]   = bx;
+      m_buffer[i+1] = by;
+      m_buffer[i+2] = bz;
     }
   }
 
   hddaq::cout << " done" << std::endl;
-  m_is_ready = true;
   return true;
 }
 
+//______________________________________________________________________________
+Bool_t
+KuramaFieldMap::WriteCache( ULong64_t source_size, ULong64_t source_mtime,
+			    ULong64_t source_sample,
+			    ULong64_t source_checksum ) const
+{
+  CacheHeader header = {};
+  std::copy( CacheMagic, CacheMagic+sizeof(CacheMagic), header.magic );
+  header.nx = Nx; header.ny = Ny; header.nz = Nz;
+  header.x0 = X0; header.y0 = Y0; header.z0 = Z0;
+  header.dx = dX; header.dy = dY; header.dz = dZ;
+  header.calc            = valueCalc;
+  header.source_size     = source_size;
+  header.source_mtime    = source_mtime;
+  header.source_sample   = source_sample;
+  header.source_checksum = source_checksum;
+  header.data_checksum   = Checksum( m_buffer.data(),
+				     m_buffer.size()*sizeof(Float_t) );
+
+  // written aside and renamed, so a reader never sees a partial file
+  const TString cache_name = CacheFileName();
+  const TString tmp_name = cache_name + Form( ".%d", ::getpid() );
+  {
+    std::ofstream ofs( tmp_name, std::ios::binary );
+    if( !ofs.is_open() )
+      return false;
+    ofs.write( reinterpret_cast<const char*>( &header ), sizeof(header) );
+    ofs.write( reinterpret_cast<const char*>( m_buffer.data() ),
+	       m_buffer.size()*sizeof(Float_t) );
+    if( !ofs.good() ){
+      ofs.close();
+      std::remove( tmp_name );
+      return false;
+    }
+  }
+  if( std::rename( tmp_name, cache_name )!=0 ){
+    std::remove( tmp_name );
+    return false;
+  }
+  return true;
+}
+
+//______________________________________________________________________________
+// index and weights of the two grid points around t along one axis.
+// Outside the grid the edge value is kept (zero derivative), between
+// the first two points Int_t() truncation extrapolates the first cell
+// as before.
+inline void
+KuramaFieldMap::Locate( Double_t t, Double_t t0, Double_t inv_d, Int_t n,
+			Int_t& i1, Int_t& i2, Double_t w[2], Double_t dw[2] )
+{
+  Double_t f = ( t-t0 )*inv_d;
+  i1 = Int_t( f );
+  if( i1<0 ){
+    i1 = i2 = 0;
+    w[0] = 1.; w[1] = 0.; dw[0] = dw[1] = 0.;
+  }
+  else if( i1>=n-1 ){
+    i1 = i2 = n-1;
+    w[0] = 1.; w[1] = 0.; dw[0] = dw[1] = 0.;
+  }
+  else {
+    i2 = i1+1;
+    w[0] = i2-f; w[1] = 1.-w[0];
+    dw[0] = -inv_d; dw[1] = inv_d;
+  }
+}
+
 //______________________________________________________________________________
 Bool_t
 KuramaFieldMap::GetFieldValue( const Double_t pointCM[3],
 			       Double_t *BfieldTesla ) const
 {
-  Double_t xt = pointCM[0];
-  Double_t yt = pointCM[1];
-  Double_t zt = pointCM[2];
+  return GetFieldValue( pointCM, BfieldTesla, 0, 0 );
+}
+
+//______________________________________________________________________________
+// trilinear interpolation of B and, if dBdX/dBdY are given, its exact
+// x/y derivatives (Tesla/cm) from the same 8 grid points
+Bool_t
+KuramaFieldMap::GetFieldValue( const Double_t pointCM[3],
+			       Double_t *BfieldTesla,
+			       Double_t *dBdX, Double_t *dBdY ) const
+{
+  if( !B ){
+    for( Int_t i=0; i<3; ++i ){
+      BfieldTesla[i] = 0.;
+      if( dBdX ) dBdX[i] = 0.;
+      if( dBdY ) dBdY[i] = 0.;
+    }
+    return true;
+  }
 
   Int_t ix1, ix2, iy1, iy2, iz1, iz2;
-  ix1 = Int_t( (xt-X0)/dX );
-  iy1 = Int_t( (yt-Y0)/dY );
-  iz1 = Int_t( (zt-Z0)/dZ );
-
-  Double_t wx1, wx2, wy1, wy2, wz1, wz2;
-  if( ix1<0 ) { ix1=ix2=0; wx1=1.; wx2=0.; }
-  else if( ix1>=Nx-1 ) { ix1=ix2=Nx-1; wx1=1.; wx2=0.; }
-  else { ix2=ix1+1; wx1=(X0+dX*ix2-xt)/dX; wx2=1.-wx1; }
-
-  if( iy1<0 ) { iy1=iy2=0; wy1=1.; wy2=0.; }
-  else if( iy1>=Ny-1 ) { iy1=iy2=Ny-1; wy1=1.; wy2=0.; }
-  else { iy2=iy1+1; wy1=(Y0+dY*iy2-yt)/dY; wy2=1.-wy1; }
-
-  if( iz1<0 ) { iz1=iz2=0; wz1=1.; wz2=0.; }
-  else if( iz1>=Nz-1 ) { iz1=iz2=Nz-1; wz1=1.; wz2=0.; }
-  else { iz2=iz1+1; wz1=(Z0+dZ*iz2-zt)/dZ; wz2=1.-wz1; }
-
-  Double_t bx1 = wx1*wy1*B[ix1][iy1][iz1].x + wx1*wy2*B[ix1][iy2][iz1].x
-    + wx2*wy1*B[ix2][iy1][iz1].x + wx2*wy2*B[ix2][iy2][iz1].x;
-  Double_t bx2 = wx1*wy1*B[ix1][iy1][iz2].x + wx1*wy2*B[ix1][iy2][iz2].x
-    + wx2*wy1*B[ix2][iy1][iz2].x + wx2*wy2*B[ix2][iy2][iz2].x;
-  Double_t bx  = wz1*bx1 + wz2*bx2;
-
-  Double_t by1 = wx1*wy1*B[ix1][iy1][iz1].y + wx1*wy2*B[ix1][iy2][iz1].y
-    + wx2*wy1*B[ix2][iy1][iz1].y + wx2*wy2*B[ix2][iy2][iz1].y;
-  Double_t by2 = wx1*wy1*B[ix1][iy1][iz2].y + wx1*wy2*B[ix1][iy2][iz2].y
-    + wx2*wy1*B[ix2][iy1][iz2].y + wx2*wy2*B[ix2][iy2][iz2].y;
-  Double_t by  = wz1*by1 + wz2*by2;
-
-  Double_t bz1 = wx1*wy1*B[ix1][iy1][iz1].z + wx1*wy2*B[ix1][iy2][iz1].z
-    + wx2*wy1*B[ix2][iy1][iz1].z + wx2*wy2*B[ix2][iy2][iz1].z;
-  Double_t bz2 = wx1*wy1*B[ix1][iy1][iz2].z + wx1*wy2*B[ix1][iy2][iz2].z
-    + wx2*wy1*B[ix2][iy1][iz2].z + wx2*wy2*B[ix2][iy2][iz2].z;
-  Double_t bz  = wz1*bz1 + wz2*bz2;
-
-  //Default
-  BfieldTesla[0] = bx;
-  BfieldTesla[1] = by;
-  BfieldTesla[2] = bz;
+  Double_t wx[2], wy[2], wz[2], dwx[2], dwy[2], dwz[2];
+  Locate( pointCM[0], X0, m_inv_dx, Nx, ix1, ix2, wx, dwx );
+  Locate( pointCM[1], Y0, m_inv_dy, Ny, iy1, iy2, wy, dwy );
+  Locate( pointCM[2], Z0, m_inv_dz, Nz, iz1, iz2, wz, dwz );
+
+  const std::size_t ox[2] = { ix1*m_stride_x, ix2*m_stride_x };
+  const std::size_t oy[2] = { iy1*m_stride_y, iy2*m_stride_y };
+  const std::size_t oz[2] = { 3*std::size_t(iz1), 3*std::size_t(iz2) };
+
+  // corner c = (jx, jy, jz) with jz turning fastest
+  Double_t w[8], wdx[8], wdy[8];
+  const Float_t* b[8];
+  for( Int_t c=0; c<8; ++c ){
+    const Int_t jx = c>>2, jy = (c>>1)&1, jz = c&1;
+    w[c]   = wx[jx]*wy[jy]*wz[jz]*m_factor;
+    wdx[c] = dwx[jx]*wy[jy]*wz[jz]*m_factor;
+    wdy[c] = wx[jx]*dwy[jy]*wz[jz]*m_factor;
+    b[c]   = B + ox[jx] + oy[jy] + oz[jz];
+  }
+
+  // flat loops over fixed sizes, vectorised by the compiler
+  Double_t bf[3] = {}, bx[3] = {}, by[3] = {};
+  for( Int_t c=0; c<8; ++c ){
+    for( Int_t i=0; i<3; ++i ){
+      const Double_t v = b[c][i];
+      bf[i] += w[c]*v;
+      bx[i] += wdx[c]*v;
+      by[i] += wdy[c]*v;
+    }
+  }
+
+  for( Int_t i=0; i<3; ++i ){
+    BfieldTesla[i] = bf[i];
+    if( dBdX ) dBdX[i] = bx[i];
+    if( dBdY ) dBdY[i] = by[i];
+  }
 
   return true;
 }
 
+//______________________________________________________________________________
+void
+KuramaFieldMap::SetGrid( void )
+{
+  m_inv_dx   = ( dX!=0. ) ? 1./dX : 0.;
+  m_inv_dy   = ( dY!=0. ) ? 1./dY : 0.;
+  m_inv_dz   = ( dZ!=0. ) ? 1./dZ : 0.;
+  m_stride_x = 3*std::size_t(Ny)*Nz;
+  m_stride_y = 3*std::size_t(Nz);
+}
+
 //______________________________________________________________________________
 void
 KuramaFieldMap::ClearField( void )
 {
-  for( Int_t ix=0; ix<Nx; ++ix ){
-    for( Int_t iy=0; iy<Ny; ++iy ){
-      B[ix][iy].clear();
-    }
-    B[ix].clear();
-  }
-  B.clear();
+  if( m_map_addr )
+    ::munmap( m_map_addr, m_map_size );
+  m_map_addr = 0;
+  m_map_size = 0;
+  m_buffer.clear();
+  B = 0;
 }
@@ -0,0 +1,170 @@
+/**
+ *  file: KuramaFitCache.cc
+ *  date: 2026.10.17
+ *
+ */
+
+#include "KuramaFitCache.hh"
+
+#include <cmath>
+#include <string>
+
+#include <std_ostream.hh>
+#include <UnpackerManager.hh>
+
+#include "KuramaTrack.hh"
+#include "RungeKuttaUtilities.hh"
+
+namespace
+{
+  const std::string& class_name("KuramaFitCache");
+  // bins of the start point at TOF
+  const double XBin  = 50.;    // [mm]
+  const double UBin  = 0.025;
+  const double VBin  = 0.025;
+  const double PBin  = std::log( 1.05 ); // 5% of the momentum
+  const int    KeyOffset = 1<<15;
+  // fits averaged before a bin is used, and the weight of a new fit
+  // once the bin is full, so the corrections follow the run slowly
+  const int    MinEntry  = 2;
+  const int    MaxWeight = 16;
+  // a run has a few hundred populated bins, this bounds a noisy one
+  const std::size_t MaxNumOfEntry = 1<<16;
+
+  //____________________________________________________________________________
+  inline bool
+  Bin( double value, double width, unsigned long long& key )
+  {
+    const double b = std::floor( value/width ) + KeyOffset;
+    if( !( b>=0. && b<2.*KeyOffset ) )
+      return false;
+    key = ( key<<16 ) | static_cast<unsigned long long>(b);
+    return true;
+  }
+}
+
+//______________________________________________________________________________
+std::atomic<bool> KuramaFitCache::s_is_enabled( false );
+
+//______________________________________________________________________________
+KuramaFitCache&
+KuramaFitCache::GetInstance( void )
+{
+  static thread_local KuramaFitCache g_instance;
+  return g_instance;
+}
+
+//______________________________________________________________________________
+// after ConfMan::Initialize(), which opens the input stream
+bool
+KuramaFitCache::ParseOption( const std::vector<std::string>& argv )
+{
+  static const std::string func_name("["+class_name+"::"+__func__+"()]");
+  static const std::string option("--kurama-warm-start");
+
+  bool is_requested = false;
+  for( std::size_t i=0, n=argv.size(); i<n; ++i )
+    if( argv[i]==option ) is_requested = true;
+  if( !is_requested )
+    return false;
+
+  // the warm start makes the tracks depend on the event history, which
+  // only an online monitor may accept
+  if( !hddaq::unpacker::GUnpacker::get_instance().is_online() ){
+    hddaq::cerr << "#W " << func_name << " " << option
+		<< " is ignored for a replay" << std::endl;
+    return false;
+  }
+  SetEnabled( true );
+  hddaq::cout << "#D " << func_name << " warm start" << std::endl;
+  return true;
+}
+
+//______________________________________________________________________________
+KuramaFitCache::KuramaFitCache( void )
+  : m_entry(),
+    m_n_seed(0),
+    m_n_update(0)
+{
+}
+
+//______________________________________________________________________________
+KuramaFitCache::~KuramaFitCache( void )
+{
+}
+
+//______________________________________________________________________________
+void
+KuramaFitCache::Clear( void )
+{
+  m_entry.clear();
+  m_n_seed   = 0;
+  m_n_update = 0;
+}
+
+//______________________________________________________________________________
+bool
+KuramaFitCache::MakeKey( const RKCordParameter& cord, Key& key )
+{
+  if( cord.Q()==0. )
+    return false;
+  key = 0;
+  return
+    Bin( cord.X(), XBin, key ) &&
+    Bin( cord.U(), UBin, key ) &&
+    Bin( cord.V(), VBin, key ) &&
+    Bin( -std::log( std::abs( cord.Q() ) ), PBin, key );
+}
+
+//______________________________________________________________________________
+bool
+KuramaFitCache::Seed( KuramaTrack* track )
+{
+  const RKCordParameter& guess = track->GuessCord();
+  Key key;
+  if( !MakeKey( guess, key ) )
+    return false;
+  EntryMap::const_iterator itr = m_entry.find( key );
+  if( itr==m_entry.end() || itr->second.n<MinEntry )
+    return false;
+
+  const Entry& e = itr->second;
+  track->SetWarmStart( RKCordParameter( guess.X()+e.dx, guess.Y()+e.dy,
+					guess.Z(),
+					guess.U()+e.du, guess.V()+e.dv,
+					guess.Q()*e.rq ) );
+  ++m_n_seed;
+  return true;
+}
+
+//______________________________________________________________________________
+void
+KuramaFitCache::Update( const KuramaTrack* track )
+{
+  const RKCordParameter& guess = track->GuessCord();
+  const RKCordParameter& fit   = track->GetCordParameter();
+  Key key;
+  if( fit.Z()!=guess.Z() || !MakeKey( guess, key ) )
+    return;
+  const double rq = fit.Q()/guess.Q();
+  if( !( rq>0. ) )
+    return;
+
+  EntryMap::iterator itr = m_entry.find( key );
+  if( itr==m_entry.end() ){
+    if( m_entry.size()>=MaxNumOfEntry )
+      m_entry.clear();
+    const Entry e = { 0, 0., 0., 0., 0., 1. };
+    itr = m_entry.insert( std::make_pair( key, e ) ).first;
+  }
+
+  Entry& e = itr->second;
+  if( e.n<MaxWeight ) ++e.n;
+  const double w = 1./e.n;
+  e.dx += w*( fit.X()-guess.X() - e.dx );
+  e.dy += w*( fit.Y()-guess.Y() - e.dy );
+  e.du += w*( fit.U()-guess.U() - e.du );
+  e.dv += w*( fit.V()-guess.V() - e.dv );
+  e.rq += w*( rq - e.rq );
+  ++m_n_update;
+}
@@ -19,6 +19,7 @@
 #include "DCAnalyzer.hh"
 #include "DCGeomMan.hh"
 #include "DCLocalTrack.hh"
+#include "DebugStageTimer.hh"
 #include "MathTools.hh"
 #include "PrintHelper.hh"
 #include "TrackHit.hh"
@@ -26,6 +27,7 @@
 namespace
 {
   const std::string& class_name("KuramaTrack");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const DCGeomMan& gGeom = DCGeomMan::GetInstance();
   // const int& IdTOF   = gGeom.DetectorId("TOF");
   const int& IdTOFUX = gGeom.DetectorId("TOF-UX");
@@ -53,7 +55,9 @@ KuramaTrack::KuramaTrack( DCLocalTrack *track_in, DCLocalTrack *track_out )
     m_path_length_total( 0. ),
     m_tof_pos( ThreeVector( 0., 0., 0. ) ),
     m_tof_mom( ThreeVector( 0., 0., 0. ) ),
-    m_gfastatus( true )
+    m_gfastatus( true ),
+    m_warm_cord(),
+    m_is_warm( false )
 {
   s_status[kInit]                = "Initialized";
   s_status[kPassed]              = "Passed";
@@ -64,14 +68,14 @@ KuramaTrack::KuramaTrack( DCLocalTrack *track_in, DCLocalTrack *track_out )
   s_status[kFailedSave]          = "Failed to Save";
   s_status[kFatal]               = "Fatal";
   FillHitArray();
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 KuramaTrack::~KuramaTrack( void )
 {
   ClearHitArray();
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -162,6 +166,7 @@ KuramaTrack::ReCalc( bool applyRecursively )
 bool
 KuramaTrack::DoFit( void )
 {
+  debug::StageTimer timer( debug::kKuramaFit );
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   m_status = kInit;
@@ -173,16 +178,7 @@ KuramaTrack::DoFit( void )
     return false;
   }
 
-  static const ThreeVector gTof = gGeom.GetGlobalPosition( "TOF" );
-  const double       xOut   = m_track_out->GetX( gTof.z() );
-  const double       yOut   = m_track_out->GetY( gTof.z() );
-  const ThreeVector& posOut = ThreeVector( xOut, yOut, gTof.z() );
-  const double       uOut   = m_track_out->GetU0();
-  const double       vOut   = m_track_out->GetV0();
-  const double       pzOut  = m_initial_momentum/std::sqrt( 1.+uOut*uOut+vOut*vOut );
-  const ThreeVector& momOut = ThreeVector( pzOut*uOut, pzOut*vOut, pzOut );
-
-  RKCordParameter     iniCord( posOut, momOut );
+  RKCordParameter     iniCord = InitialCord();
   RKCordParameter     prevCord;
   RKHitPointContainer preHPntCont;
 
@@ -313,10 +309,55 @@ KuramaTrack::DoFit( void )
   return true;
 }
 
+//______________________________________________________________________________
+// SdcOut track at TOF with the initial momentum
+RKCordParameter
+KuramaTrack::GuessCord( void ) const
+{
+  static const ThreeVector gTof = gGeom.GetGlobalPosition( "TOF" );
+  const double       xOut   = m_track_out->GetX( gTof.z() );
+  const double       yOut   = m_track_out->GetY( gTof.z() );
+  const ThreeVector& posOut = ThreeVector( xOut, yOut, gTof.z() );
+  const double       uOut   = m_track_out->GetU0();
+  const double       vOut   = m_track_out->GetV0();
+  const double       pzOut  = m_initial_momentum/std::sqrt( 1.+uOut*uOut+vOut*vOut );
+  const ThreeVector& momOut = ThreeVector( pzOut*uOut, pzOut*vOut, pzOut );
+  return RKCordParameter( posOut, momOut );
+}
+
+//______________________________________________________________________________
+// Reduced chi-square linearised at the start point, i.e. one trace
+// and the step of GuessNextParameters() instead of the whole iteration.
+// Only a rough estimate for the pairs far from the solution, but cheap
+// enough to reject the hopeless ones before DoFit().
+// InitialChiSqr if the first trace fails, as DoFit() would.
+double
+KuramaTrack::EstimateChiSqr( void ) const
+{
+  if( m_initial_momentum<0 )
+    return InitialChiSqr;
+
+  // from the guess, not from a warm start, so the pre-filter does not
+  // depend on the events seen before
+  RKCordParameter     cord  = GuessCord();
+  RKHitPointContainer hpCont = RK::MakeHPContainer();
+  if( RK::Trace( cord, hpCont ) != kPassed )
+    return InitialChiSqr;
+
+  const double chiSqr = CalcChiSqr( hpCont );
+  double estDChisqr = 0., lambdaCri = 0.;
+  if( !GuessNextParameters( hpCont, cord, estDChisqr, lambdaCri ) )
+    return chiSqr;
+
+  // estDChisqr counts the decrease twice, see GuessNextParameters()
+  return chiSqr + 0.5*estDChisqr;
+}
+
 //______________________________________________________________________________
 bool
 KuramaTrack::DoFit( RKCordParameter iniCord )
 {
+  debug::StageTimer timer( debug::kKuramaFit );
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   //  ClearHitArray();
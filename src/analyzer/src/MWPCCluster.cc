@@ -21,6 +21,7 @@
 namespace
 {
   const std::string& class_name("MWPCCluster");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
@@ -196,14 +197,14 @@ MWPCCluster::MWPCCluster( void )
     m_first(),
     m_status(false)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 MWPCCluster::~MWPCCluster( void )
 {
   del::DeleteObject( m_hits );
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -2,6 +2,7 @@
 
 #include "MacroBuilder.hh"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -42,6 +43,144 @@ SetText(TLatex* text, Int_t align, Double_t size, Int_t ndc=1)
   text->SetTextAlign(align);
   text->SetTextSize(size);
 }
+
+//_____________________________________________________________________________
+// "eff. 0.xxx" of a multiplicity histogram, 1 - (zero hit)/(entries).
+// The text is drawn once in the pad and only its string is replaced, when
+// the entries of the histogram have changed since the last update.
+struct EffText
+{
+  TH1*     hist;
+  TText*   text;
+  TString  format; // with one %.3f
+  Double_t entries;
+};
+
+//_____________________________________________________________________________
+EffText
+MakeEffText(TH1* h, TText* text, Double_t x, Double_t y, const TString& format)
+{
+  text->SetNDC();
+  text->SetText(x, y, "");
+  text->Draw();
+  EffText e = { h, text, format, -1. };
+  return e;
+}
+
+//_____________________________________________________________________________
+void
+UpdateEffText(EffText& e)
+{
+  if(!e.hist)
+    return;
+  const Double_t all = e.hist->GetEntries();
+  if(all == e.entries)
+    return;
+  e.entries = all;
+  const Double_t eff = 1. - e.hist->GetBinContent(1)/all;
+  e.text->SetTitle(Form(e.format, eff));
+}
+
+//_____________________________________________________________________________
+// Gaussian fit of a TOT peak.
+// The first fit iterates three times from the maximum bin. Later it is
+// skipped until FitMinNewEntries and FitMinNewFraction of new entries
+// have arrived, and then done once from the previous parameters. A reset
+// histogram or a failed refit goes back to the first procedure.
+const Double_t FitMinNewEntries  = 1000.;
+const Double_t FitMinNewFraction = 0.1;
+
+class PeakFitter
+{
+public:
+  PeakFitter(void) : m_func(), m_entries(0.), m_is_fitted(false) {}
+
+private:
+  TF1*     m_func;
+  Double_t m_entries;
+  Bool_t   m_is_fitted;
+
+public:
+  // lower_scale narrows the lower side of the range after the first fit
+  Bool_t   Fit(TH1* h, Double_t p_default, Double_t p_min,
+	       Double_t lower_scale=1.);
+  Double_t GetPeak(void) const { return m_func ? m_func->GetParameter(1) : 0.; }
+};
+
+//_____________________________________________________________________________
+Bool_t
+PeakFitter::Fit(TH1* h, Double_t p_default, Double_t p_min,
+		Double_t lower_scale)
+{
+  if(!m_func)
+    m_func = new TF1(Form("%s_peak", h->GetName()), "gaus", 0., 100.);
+  const Double_t entries = h->GetEntries();
+  if(m_is_fitted && entries >= m_entries &&
+     entries - m_entries < std::max(FitMinNewEntries,
+				    FitMinNewFraction*m_entries))
+    return false;
+
+  if(m_is_fitted && entries >= m_entries){
+    Double_t p = m_func->GetParameter(1);
+    Double_t w = m_func->GetParameter(2);
+    // "B" keeps the previous parameters as the initial values
+    if(w > 0. &&
+       Int_t(h->Fit(m_func, "QB", "", p - w*lower_scale, p + w)) == 0){
+      m_entries = entries;
+      return true;
+    }
+  }
+
+  Double_t p = h->GetBinCenter(h->GetMaximumBin());
+  if(p < p_min) p = p_default;
+  Double_t w = 10.;
+  for(Int_t ifit=0; ifit<3; ++ifit){
+    Double_t fmin = p - w*(ifit>0 ? lower_scale : 1.);
+    Double_t fmax = p + w;
+    h->Fit(m_func, "Q", "", fmin, fmax);
+    p = m_func->GetParameter(1);
+    w = m_func->GetParameter(2) * 1.;
+  }
+  m_entries   = entries;
+  m_is_fitted = true;
+  return true;
+}
+
+//_____________________________________________________________________________
+// Peak value text and reference line of a TOT pad, drawn once.
+struct PeakPad
+{
+  TH1*       hist;
+  PeakFitter fitter;
+  TText*     text;
+  TLine*     line;
+};
+
+//_____________________________________________________________________________
+void
+MakePeakPad(PeakPad& pad, TH1* h, Double_t ref)
+{
+  pad.hist = h;
+  pad.text = new TText;
+  pad.text->SetNDC();
+  pad.text->SetTextSize(0.100);
+  pad.text->SetText(0.200, 0.750, "");
+  pad.text->Draw();
+  pad.line = new TLine(ref, 0., ref, 0.);
+  pad.line->Draw();
+}
+
+//_____________________________________________________________________________
+void
+UpdatePeakPad(PeakPad& pad, Double_t p_default, Double_t p_min,
+	      Double_t lower_scale=1.)
+{
+  if(!pad.hist)
+    return;
+  if(pad.fitter.Fit(pad.hist, p_default, p_min, lower_scale))
+    pad.text->SetTitle(Form("%.2f", pad.fitter.GetPeak()));
+  pad.line->SetY2(pad.hist->GetMaximum());
+}
 }
 
 namespace analyzer
@@ -4063,33 +4202,29 @@ UpdateBcOutEfficiency()
     "BC3_Multi_u0", "BC3_Multi_u1", "BC4_Multi_u0", "BC4_Multi_u1",
     "BC4_Multi_v0", "BC4_Multi_v1", "BC4_Multi_x0", "BC4_Multi_x1"
   };
-  static std::vector<TLatex*> tex(name.size()*2);
-  for(Int_t i=0, n=name.size(); i<n; ++i){
-    c1->cd(i+1);
-    auto h1 = dynamic_cast<TH1*>(gPad->FindObject(name[i]+"_wTDC"));
-    TString n2 = name[i]+"_wTDC";
-    n2.ReplaceAll("_Multi", "_CMulti");
-    auto h2 = dynamic_cast<TH1*>(gPad->FindObject(n2));
-    if(!h1 || !h2)
-      continue;
-    Double_t zero1 = h1->GetBinContent(1);
-    Double_t all1  = h1->GetEntries();
-    Double_t eff1  = 1. - zero1/all1;
-    Double_t zero2 = h2->GetBinContent(1);
-    Double_t all2  = h2->GetEntries();
-    Double_t eff2  = 1. - zero2/all2;
-    if(tex[2*i]) delete tex[2*i];
-    if(tex[2*i+1]) delete tex[2*i+1];
-    tex[2*i] = new TLatex;
-    tex[2*i]->SetNDC();
-    tex[2*i]->SetTextAlign(32);
-    tex[2*i]->SetTextSize(0.150);
-    tex[2*i+1] = dynamic_cast<TLatex*>(tex[2*i]->Clone());
-    tex[2*i]->SetText(0.770, 0.600, Form("eff. %.3f", eff1));
-    tex[2*i+1]->SetText(0.770, 0.500, Form("#color[%d]{%.3f}", kRed+1, eff2));
-    tex[2*i]->Draw();
-    tex[2*i+1]->Draw();
+  static std::vector<EffText> tex;
+  static Bool_t is_initialized = false;
+  if(!is_initialized){
+    is_initialized = true;
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      c1->cd(i+1);
+      auto h1 = dynamic_cast<TH1*>(gPad->FindObject(name[i]+"_wTDC"));
+      TString n2 = name[i]+"_wTDC";
+      n2.ReplaceAll("_Multi", "_CMulti");
+      auto h2 = dynamic_cast<TH1*>(gPad->FindObject(n2));
+      if(!h1 || !h2)
+	continue;
+      auto t = new TLatex;
+      t->SetTextAlign(32);
+      t->SetTextSize(0.150);
+      tex.push_back(MakeEffText(h1, t, 0.770, 0.600, "eff. %.3f"));
+      tex.push_back(MakeEffText(h2, dynamic_cast<TText*>(t->Clone()),
+				0.770, 0.500,
+				Form("#color[%d]{%%.3f}", kRed+1)));
+    }
   }
+  for(auto& e : tex)
+    UpdateEffText(e);
 }
 
 //_____________________________________________________________________________
@@ -4107,42 +4242,38 @@ UpdateSdcInOutEfficiency()
     "SDC4_Multi_y0", "SDC4_Multi_y1", "SDC4_Multi_x0", "SDC4_Multi_x1",
     "SDC5_Multi_y0", "SDC5_Multi_y1", "SDC5_Multi_x0", "SDC5_Multi_x1"
   };
-  static std::vector<TLatex*> tex(name.size()*2);
-  for(Int_t i=0, n=name.size(); i<n; ++i){
-    if(i< NumOfLayersSDC1)
-      c1->cd(1)->cd(i+1);
-    else if(i< NumOfLayersSDC1+NumOfLayersSDC2)
-      c1->cd(2)->cd(i+1-NumOfLayersSDC1);
-    else if(i< NumOfLayersSDC1+NumOfLayersSDC2+NumOfLayersSDC3)
-      c1->cd(3)->cd(i+1-NumOfLayersSDC1-NumOfLayersSDC2);
-    else if(i< NumOfLayersSDC1+NumOfLayersSDC2+NumOfLayersSDC3+NumOfLayersSDC4)
-      c1->cd(4)->cd(i+1-NumOfLayersSDC1-NumOfLayersSDC2-NumOfLayersSDC3);
-    else
-      c1->cd(5)->cd(i+1-NumOfLayersSDC1-NumOfLayersSDC2-NumOfLayersSDC3-NumOfLayersSDC4);
-    auto h1 = dynamic_cast<TH1*>(gPad->FindObject(name[i]+"_wTDC"));
-    TString n2 = name[i]+"_wTDC";
-    n2.ReplaceAll("_Multi", "_CMulti");
-    auto h2 = dynamic_cast<TH1*>(gPad->FindObject(n2));
-    if(!h1 || !h2)
-      continue;
-    Double_t zero1 = h1->GetBinContent(1);
-    Double_t all1  = h1->GetEntries();
-    Double_t eff1  = 1. - zero1/all1;
-    Double_t zero2 = h2->GetBinContent(1);
-    Double_t all2  = h2->GetEntries();
-    Double_t eff2  = 1. - zero2/all2;
-    if(tex[2*i]) delete tex[2*i];
-    if(tex[2*i+1]) delete tex[2*i+1];
-    tex[2*i] = new TLatex;
-    tex[2*i]->SetNDC();
-    tex[2*i]->SetTextAlign(32);
-    tex[2*i]->SetTextSize(0.150);
-    tex[2*i+1] = dynamic_cast<TLatex*>(tex[2*i]->Clone());
-    tex[2*i]->SetText(0.770, 0.600, Form("eff. %.3f", eff1));
-    tex[2*i+1]->SetText(0.770, 0.500, Form("#color[%d]{%.3f}", kRed+1, eff2));
-    tex[2*i]->Draw();
-    tex[2*i+1]->Draw();
+  static std::vector<EffText> tex;
+  static Bool_t is_initialized = false;
+  if(!is_initialized){
+    is_initialized = true;
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      if(i< NumOfLayersSDC1)
+	c1->cd(1)->cd(i+1);
+      else if(i< NumOfLayersSDC1+NumOfLayersSDC2)
+	c1->cd(2)->cd(i+1-NumOfLayersSDC1);
+      else if(i< NumOfLayersSDC1+NumOfLayersSDC2+NumOfLayersSDC3)
+	c1->cd(3)->cd(i+1-NumOfLayersSDC1-NumOfLayersSDC2);
+      else if(i< NumOfLayersSDC1+NumOfLayersSDC2+NumOfLayersSDC3+NumOfLayersSDC4)
+	c1->cd(4)->cd(i+1-NumOfLayersSDC1-NumOfLayersSDC2-NumOfLayersSDC3);
+      else
+	c1->cd(5)->cd(i+1-NumOfLayersSDC1-NumOfLayersSDC2-NumOfLayersSDC3-NumOfLayersSDC4);
+      auto h1 = dynamic_cast<TH1*>(gPad->FindObject(name[i]+"_wTDC"));
+      TString n2 = name[i]+"_wTDC";
+      n2.ReplaceAll("_Multi", "_CMulti");
+      auto h2 = dynamic_cast<TH1*>(gPad->FindObject(n2));
+      if(!h1 || !h2)
+	continue;
+      auto t = new TLatex;
+      t->SetTextAlign(32);
+      t->SetTextSize(0.150);
+      tex.push_back(MakeEffText(h1, t, 0.770, 0.600, "eff. %.3f"));
+      tex.push_back(MakeEffText(h2, dynamic_cast<TText*>(t->Clone()),
+				0.770, 0.500,
+				Form("#color[%d]{%%.3f}", kRed+1)));
+    }
   }
+  for(auto& e : tex)
+    UpdateEffText(e);
 }
 
 //_____________________________________________________________________________
@@ -4160,23 +4291,21 @@ UpdateCFTEfficiency()
     "CFT_CMulti_UV3_wBGO", "CFT_CMulti_PHI3_wBGO",
     "CFT_CMulti_UV4_wBGO", "CFT_CMulti_PHI4_wBGO"
   };
-  static std::vector<TText*> tex(name.size());
-
-  for(Int_t i=0, n=name.size(); i<n; ++i){
-    c1->cd(i+1);
-    TH1 *h = (TH1*)gPad->FindObject(name[i]);
-    if(!h){ std::cout << "!?!?!?" << std::endl; continue; }
-    Double_t zero = h->GetBinContent(1);
-    Double_t all  = h->GetEntries();
-    Double_t eff  = 1. - zero/all;
-    if(tex[i]) delete tex[i];
-    tex[i] = new TText;
-    tex[i]->SetNDC();
-    tex[i]->SetTextSize(0.130);
-    tex[i]->SetText(0.300,0.600,Form("eff. %.3f",
-				     eff));
-    tex[i]->Draw();
+  static std::vector<EffText> tex;
+  static Bool_t is_initialized = false;
+  if(!is_initialized){
+    is_initialized = true;
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      c1->cd(i+1);
+      TH1 *h = (TH1*)gPad->FindObject(name[i]);
+      if(!h){ std::cout << "!?!?!?" << std::endl; continue; }
+      auto t = new TText;
+      t->SetTextSize(0.130);
+      tex.push_back(MakeEffText(h, t, 0.300, 0.600, "eff. %.3f"));
+    }
   }
+  for(auto& e : tex)
+    UpdateEffText(e);
 }
 
 //_____________________________________________________________________________
@@ -4197,23 +4326,21 @@ UpdateAFTEfficiency()
     "AFT_Multi_8_X", "AFT_Multi_8_Y",
     "AFT_Multi_9_X", "AFT_Multi_9_Y",
   };
-  static std::vector<TText*> tex(name.size());
-
-  for(Int_t i=0, n=name.size(); i<n; ++i){
-    c1->cd(i+1);
-    TH1 *h = (TH1*)gPad->FindObject(name[i]);
-    if(!h){ std::cout << "!?!?!?" << std::endl; continue; }
-    Double_t zero = h->GetBinContent(1);
-    Double_t all  = h->GetEntries();
-    Double_t eff  = 1. - zero/all;
-    if(tex[i]) delete tex[i];
-    tex[i] = new TText;
-    tex[i]->SetNDC();
-    tex[i]->SetTextSize(0.130);
-    tex[i]->SetText(0.300,0.600,Form("eff. %.3f",
-				     eff));
-    tex[i]->Draw();
+  static std::vector<EffText> tex;
+  static Bool_t is_initialized = false;
+  if(!is_initialized){
+    is_initialized = true;
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      c1->cd(i+1);
+      TH1 *h = (TH1*)gPad->FindObject(name[i]);
+      if(!h){ std::cout << "!?!?!?" << std::endl; continue; }
+      auto t = new TText;
+      t->SetTextSize(0.130);
+      tex.push_back(MakeEffText(h, t, 0.300, 0.600, "eff. %.3f"));
+    }
   }
+  for(auto& e : tex)
+    UpdateEffText(e);
 }
 
 //_____________________________________________________________________________
@@ -4227,22 +4354,21 @@ UpdateSSDEfficiency()
     "SSD1_CMulti_y0", "SSD1_CMulti_x0", "SSD1_CMulti_y1", "SSD1_CMulti_x1",
     "SSD2_CMulti_x0", "SSD2_CMulti_y0", "SSD2_CMulti_x1", "SSD2_CMulti_y1"
   };
-  static std::vector<TText*> tex(name.size());
-  for(Int_t i=0, n=name.size(); i<n; ++i){
-    c1->cd(i+1);
-    TH1 *h = (TH1*)gPad->FindObject(name[i]);
-    if(!h) continue;
-    Double_t zero = h->GetBinContent(1);
-    Double_t all  = h->GetEntries();
-    Double_t eff  = 1. - zero/all;
-    if(tex[i]) delete tex[i];
-    tex[i] = new TText;
-    tex[i]->SetNDC();
-    tex[i]->SetTextSize(0.100);
-    tex[i]->SetText(0.500,0.600,Form("eff. %.3f",
-				     eff));
-    tex[i]->Draw();
+  static std::vector<EffText> tex;
+  static Bool_t is_initialized = false;
+  if(!is_initialized){
+    is_initialized = true;
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      c1->cd(i+1);
+      TH1 *h = (TH1*)gPad->FindObject(name[i]);
+      if(!h) continue;
+      auto t = new TText;
+      t->SetTextSize(0.100);
+      tex.push_back(MakeEffText(h, t, 0.500, 0.600, "eff. %.3f"));
+    }
   }
+  for(auto& e : tex)
+    UpdateEffText(e);
 }
 
 //_____________________________________________________________________________
@@ -4308,33 +4434,20 @@ UpdateTOTPeakFittingE70()
     gUser.GetParameter("TotRefAFT"), gUser.GetParameter("TotRefBFT"),
     gUser.GetParameter("TotRefAFT"), gUser.GetParameter("TotRefAFT"),
   };
-  static std::vector<TLine*> line(name.size());
-  static std::vector<TText*> tex(name.size());
-  for(Int_t i=0, n=name.size(); i<n; ++i){
-    c1->cd(i+1);
-    auto h = dynamic_cast<TH1*>(gPad->FindObject(name[i]));
-    TF1 f("f", "gaus", 0., 100.);
-    Double_t p = h->GetBinCenter(h->GetMaximumBin());
-    if(p < 30.) p = optval[i];
-    Double_t w = 10.;
-    for(Int_t ifit=0; ifit<3; ++ifit){
-      Double_t fmin = p - w;
-      Double_t fmax = p + w;
-      h->Fit("f", "Q", "", fmin, fmax);
-      p = f.GetParameter(1);
-      w = f.GetParameter(2) * 1.;
+  static std::vector<PeakPad> pad(name.size());
+  static Bool_t is_initialized = false;
+  if(!is_initialized){
+    is_initialized = true;
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      c1->cd(i+1);
+      auto h = dynamic_cast<TH1*>(gPad->FindObject(name[i]));
+      if(!h) continue;
+      MakePeakPad(pad[i], h, optval[i]);
     }
-    if(tex[i]) delete tex[i];
-    tex[i] = new TText;
-    tex[i]->SetNDC();
-    tex[i]->SetTextSize(0.100);
-    tex[i]->SetText(0.200, 0.750, Form("%.2f", p));
-    tex[i]->Draw();
-    if(line[i]) delete line[i];
-    line[i] = new TLine(optval[i], 0., optval[i], h->GetMaximum());
-    line[i]->Draw();
   }
-
+  for(Int_t i=0, n=name.size(); i<n; ++i){
+    UpdatePeakPad(pad[i], optval[i], 30.);
+  }
 }
 
 //_____________________________________________________________________________
@@ -4352,32 +4465,19 @@ UpdateTOTPeakFittingE03()
     gUser.GetParameter("TotRefBFT"),
     gUser.GetParameter("TotRefBFT"),
   };
-  static std::vector<TLine*> line(name.size());
-  static std::vector<TText*> tex(name.size());
-  for(Int_t i=0, n=name.size(); i<n; ++i){
-    c1->cd(i+1);
-    auto h = dynamic_cast<TH1*>(gPad->FindObject(name[i]));
-    if(!h) continue;
-    TF1 f("f", "gaus", 0., 100.);
-    Double_t p = h->GetBinCenter(h->GetMaximumBin());
-    if(p < 30.) p = 60.;
-    Double_t w = 10.;
-    for(Int_t ifit=0; ifit<3; ++ifit){
-      Double_t fmin = p - w;
-      Double_t fmax = p + w;
-      h->Fit("f", "Q", "", fmin, fmax);
-      p = f.GetParameter(1);
-      w = f.GetParameter(2) * 1.;
+  static std::vector<PeakPad> pad(name.size());
+  static Bool_t is_initialized = false;
+  if(!is_initialized){
+    is_initialized = true;
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      c1->cd(i+1);
+      auto h = dynamic_cast<TH1*>(gPad->FindObject(name[i]));
+      if(!h) continue;
+      MakePeakPad(pad[i], h, optval[i]);
     }
-    if(tex[i]) delete tex[i];
-    tex[i] = new TText;
-    tex[i]->SetNDC();
-    tex[i]->SetTextSize(0.100);
-    tex[i]->SetText(0.200, 0.750, Form("%.2f", p));
-    tex[i]->Draw();
-    if(line[i]) delete line[i];
-    line[i] = new TLine(optval[i], 0., optval[i], h->GetMaximum());
-    line[i]->Draw();
+  }
+  for(Int_t i=0, n=name.size(); i<n; ++i){
+    UpdatePeakPad(pad[i], 60., 30.);
   }
 }
 
@@ -4397,34 +4497,20 @@ UpdateTOTPeakFittingE40()
       41.0, 41.0, 65.0, 65.0,
       67.5, 67.5, 42.0, 54.0
     };
-    static std::vector<TLine*> line(name.size());
-    static std::vector<TText*> tex(name.size());
-    for(Int_t i=0, n=name.size(); i<n; ++i){
-      c1->cd(i+1);
-      TH1 *h = (TH1*)gPad->FindObject(name[i]);
-      if(!h) continue;
-      TF1 f("f", "gaus", 0., 100.);
-      Double_t p = h->GetBinCenter(h->GetMaximumBin());
-      if(p < 30.) p = 60.;
-      Double_t w = 10.;
-      for(Int_t ifit=0; ifit<3; ++ifit){
-	Double_t fmin = p - w;
-	Double_t fmax = p + w;
-	if(name[i].Contains("SFT_CTOT") && ifit>0)
-	  fmin = p - w*0.75;
-	h->Fit("f", "Q", "", fmin, fmax);
-	p = f.GetParameter(1);
-	w = f.GetParameter(2) * 1.;
+    static std::vector<PeakPad> pad(name.size());
+    static Bool_t is_initialized = false;
+    if(!is_initialized){
+      is_initialized = true;
+      for(Int_t i=0, n=name.size(); i<n; ++i){
+	c1->cd(i+1);
+	TH1 *h = (TH1*)gPad->FindObject(name[i]);
+	if(!h) continue;
+	MakePeakPad(pad[i], h, optval[i]);
       }
-      if(tex[i]) delete tex[i];
-      tex[i] = new TText;
-      tex[i]->SetNDC();
-      tex[i]->SetTextSize(0.100);
-      tex[i]->SetText(0.200, 0.750, Form("%.2f", p));
-      tex[i]->Draw();
-      if(line[i]) delete line[i];
-      line[i] = new TLine(optval[i], 0., optval[i], h->GetMaximum());
-      line[i]->Draw();
+    }
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      UpdatePeakPad(pad[i], 60., 30.,
+		    name[i].Contains("SFT_CTOT") ? 0.75 : 1.);
     }
   }
   {
@@ -4437,30 +4523,19 @@ UpdateTOTPeakFittingE40()
       58.0, 60.0, 58.0, 60.0,
       60.0, 60.0, 60.0, 60.0
     };
-    static std::vector<TLine*> line(name.size());
-    static std::vector<TText*> tex(name.size());
-    for(Int_t i=0, n=name.size(); i<n; ++i){
-      c1->cd(i+1);
-      TH1 *h = (TH1*)gPad->FindObject(name[i]);
-      if(!h) continue;
-      TF1 f("f", "gaus", 0., 100.);
-      Double_t p = h->GetBinCenter(h->GetMaximumBin());
-      if(p < 40.) p = 60.;
-      Double_t w = 10.;
-      for(Int_t ifit=0; ifit<3; ++ifit){
-	h->Fit("f", "Q", "", p-w, p+w);
-	p = f.GetParameter(1);
-	w = f.GetParameter(2) * 1.;
+    static std::vector<PeakPad> pad(name.size());
+    static Bool_t is_initialized = false;
+    if(!is_initialized){
+      is_initialized = true;
+      for(Int_t i=0, n=name.size(); i<n; ++i){
+	c1->cd(i+1);
+	TH1 *h = (TH1*)gPad->FindObject(name[i]);
+	if(!h) continue;
+	MakePeakPad(pad[i], h, optval[i]);
       }
-      if(tex[i]) delete tex[i];
-      tex[i] = new TText;
-      tex[i]->SetNDC();
-      tex[i]->SetTextSize(0.100);
-      tex[i]->SetText(0.200, 0.750, Form("%.2f", p));
-      tex[i]->Draw();
-      if(line[i]) delete line[i];
-      line[i] = new TLine(optval[i], 0., optval[i], h->GetMaximum());
-      line[i]->Draw();
+    }
+    for(Int_t i=0, n=name.size(); i<n; ++i){
+      UpdatePeakPad(pad[i], 60., 40.);
     }
   }
 }
@@ -9,11 +9,13 @@
 #include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <std_ostream.hh>
 
 #include "ConfMan.hh"
 #include "DebugCounter.hh"
+#include "DebugStageTimer.hh"
 #include "DeleteUtility.hh"
 #include "DetectorID.hh"
 #include "DCRawHit.hh"
@@ -27,6 +29,7 @@ namespace
 {
   using namespace hddaq::unpacker;
   const std::string& class_name("RawData");
+  debug::ObjectCounter::Counter gCounter( class_name );
   const UnpackerManager& gUnpacker = GUnpacker::get_instance();
   const UserParamMan&    gUser     = UserParamMan::GetInstance();
   enum EUorD { kOneSide=1, kBothSide=2 };
@@ -36,25 +39,150 @@ namespace
   const int  MaxMultiHitDC  = 16;
 #endif
 
+  //______________________________________________________________________________
+  // Dense channel -> raw hit tables for the containers being filled, one
+  // set per thread. A table is booked per detector (or DC plane) with the
+  // sizes of DetectorID.hh, and only the slots used by the current
+  // decoding are reset, so the cost does not depend on the table size.
+  template <typename Hit>
+  class RawHitIndex
+  {
+  public:
+    RawHitIndex( void )
+      : m_offset(), m_n_plane(), m_n_seg(), m_hit(), m_used()
+    {}
+
+  private:
+    std::vector<std::size_t> m_offset;   // [id]
+    std::vector<int>         m_n_plane;  // [id]
+    std::vector<int>         m_n_seg;    // [id]
+    std::vector<Hit*>        m_hit;
+    std::vector<std::size_t> m_used;
+
+  public:
+    //__________________________________________________________________________
+    void
+    Book( int id, int n_plane, int n_seg )
+    {
+      if( id>=(int)m_offset.size() ){
+	m_offset.resize( id+1, 0 );
+	m_n_plane.resize( id+1, 0 );
+	m_n_seg.resize( id+1, 0 );
+      }
+      m_offset[id]  = m_hit.size();
+      m_n_plane[id] = n_plane;
+      m_n_seg[id]   = n_seg;
+      m_hit.resize( m_hit.size() + std::size_t(n_plane)*n_seg, 0 );
+    }
+
+    //__________________________________________________________________________
+    // slot of the channel, 0 if it is not booked
+    Hit**
+    Find( int id, int plane, int seg )
+    {
+      if( id<0 || id>=(int)m_offset.size() ||
+	  plane<0 || plane>=m_n_plane[id] ||
+	  seg<0 || seg>=m_n_seg[id] )
+	return 0;
+      return &m_hit[ m_offset[id] + std::size_t(plane)*m_n_seg[id] + seg ];
+    }
+
+    //__________________________________________________________________________
+    void
+    Insert( Hit** slot, Hit* hit )
+    {
+      *slot = hit;
+      m_used.push_back( slot - &m_hit[0] );
+    }
+
+    //__________________________________________________________________________
+    void
+    Reset( void )
+    {
+      for( std::size_t i=0, n=m_used.size(); i<n; ++i )
+	m_hit[m_used[i]] = 0;
+      m_used.clear();
+    }
+  };
+
+  //______________________________________________________________________________
+  RawHitIndex<HodoRawHit>&
+  HodoIndex( void )
+  {
+    static thread_local RawHitIndex<HodoRawHit> g_index;
+    static thread_local bool is_booked = false;
+    if( !is_booked ){
+      g_index.Book( DetIdBH1,       1,                  NumOfSegBH1 );
+      g_index.Book( DetIdBH2,       1,                  NumOfSegBH2 );
+      g_index.Book( DetIdTOF,       1,                  NumOfSegTOF );
+      g_index.Book( DetIdBFT,       NumOfPlaneBFT,      NumOfSegBFT );
+      g_index.Book( DetIdSCH,       1,                  NumOfSegSCH );
+#ifdef E40
+      g_index.Book( DetIdSAC,       1,                  NumOfSegSAC );
+      g_index.Book( DetIdHtTOF,     1,                  NumOfSegHtTOF );
+      g_index.Book( DetIdLC,        1,                  NumOfSegLC );
+      g_index.Book( DetIdSFT,       NumOfPlaneSFT,      NumOfSegSFT_UV );
+      g_index.Book( DetIdCFT,       NumOfPlaneCFT,      NumOfSegCFT_PHI4 );
+      g_index.Book( DetIdBGO,       1,                  NumOfSegBGO );
+      g_index.Book( DetIdPiID,      1,                  NumOfSegPiID );
+      // U and D go to separate containers, plane = 2*layer+UorD
+      g_index.Book( DetIdFHT1,      2*NumOfLayersFHT1,  MaxSegFHT1 );
+      g_index.Book( DetIdFHT2,      2*NumOfLayersFHT2,  MaxSegFHT2 );
+#endif
+      g_index.Book( DetIdScaler,    NumOfScaler,        NumOfSegScaler );
+      g_index.Book( DetIdTrig,      1,                  NumOfSegTrig );
+      g_index.Book( DetIdFpgaBH2Mt, 1,                  NumOfSegBH2 );
+      g_index.Book( DetIdVmeCalib,  NumOfPlaneVmeCalib, NumOfSegVmeCalib );
+      is_booked = true;
+    }
+    return g_index;
+  }
+
+  //______________________________________________________________________________
+  // indexed by DC plane id, wire ids start from 1
+  RawHitIndex<DCRawHit>&
+  DCIndex( void )
+  {
+    static thread_local RawHitIndex<DCRawHit> g_index;
+    static thread_local bool is_booked = false;
+    if( !is_booked ){
+      for( int plane=PlMinBcOut; plane<=PlMaxBcOut; ++plane )
+	g_index.Book( plane, 1, std::max( MaxWireBC3, MaxWireBC4 )+1 );
+      for( int plane=0; plane<NumOfLayersSDC1; ++plane )
+	g_index.Book( plane+1, 1, MaxWireSDC1+1 );
+      for( int plane=PlMinSdcOut; plane<=PlMaxSdcOut; ++plane )
+	g_index.Book( plane, 1, std::max( MaxWireSDC3, MaxWireSDC4 )+1 );
+      is_booked = true;
+    }
+    return g_index;
+  }
+
   //______________________________________________________________________________
   inline bool
   AddHodoRawHit( HodoRHitContainer& cont,
-		 int id, int plane, int seg, int UorD, int type, int data )
+		 int id, int plane, int seg, int UorD, int type, int data,
+		 int index_plane=-1 )
   {
     static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
-    HodoRawHit *p = 0;
-    for( std::size_t i=0, n=cont.size(); i<n; ++i ){
-      HodoRawHit *q = cont[i];
-      if( q->DetectorId()==id &&
-	  q->PlaneId()==plane &&
-	  q->SegmentId()==seg ){
-	p=q; break;
+    RawHitIndex<HodoRawHit>& index = HodoIndex();
+    HodoRawHit **slot = index.Find( id, index_plane<0 ? plane : index_plane, seg );
+    HodoRawHit *p = slot ? *slot : 0;
+    if( !slot ){
+      // not booked, look for it in the container
+      for( std::size_t i=0, n=cont.size(); i<n; ++i ){
+	HodoRawHit *q = cont[i];
+	if( q->DetectorId()==id &&
+	    q->PlaneId()==plane &&
+	    q->SegmentId()==seg ){
+	  p=q; break;
+	}
       }
     }
     if( !p ){
       p = new HodoRawHit( id, plane, seg );
       cont.push_back(p);
+      if( slot ) index.Insert( slot, p );
     }
 
     switch(type){
@@ -92,17 +220,22 @@ namespace
   {
     static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
-    DCRawHit *p = 0;
-    for( std::size_t i=0, n=cont.size(); i<n; ++i ){
-      DCRawHit *q = cont[i];
-      if( q->PlaneId()==plane &&
-	  q->WireId()==wire ){
-	p=q; break;
+    RawHitIndex<DCRawHit>& index = DCIndex();
+    DCRawHit **slot = index.Find( plane, 0, wire );
+    DCRawHit *p = slot ? *slot : 0;
+    if( !slot ){
+      for( std::size_t i=0, n=cont.size(); i<n; ++i ){
+	DCRawHit *q = cont[i];
+	if( q->PlaneId()==plane &&
+	    q->WireId()==wire ){
+	  p=q; break;
+	}
       }
     }
     if( !p ){
       p = new DCRawHit( plane, wire );
       cont.push_back(p);
+      if( slot ) index.Insert( slot, p );
     }
 
     switch(type){
@@ -181,14 +314,14 @@ RawData::RawData( void )
     m_VmeCalibRawHC(),
     m_FpgaBH2MtRawHC()
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 RawData::~RawData( void )
 {
   ClearAll();
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -238,6 +371,7 @@ RawData::ClearAll( void )
 bool
 RawData::DecodeHits( void )
 {
+  debug::StageTimer timer( debug::kRawDecode );
   static const std::string func_name("["+class_name+"::"+__func__+"()]");
 
   static const double MinBC3_TDC  = gUser.GetParameter("BC3_TDC", 0);
@@ -260,6 +394,8 @@ RawData::DecodeHits( void )
   }
 
   ClearAll();
+  HodoIndex().Reset();
+  DCIndex().Reset();
 
   // BH1
   DecodeHodo( DetIdBH1, NumOfSegBH1, kBothSide, m_BH1RawHC );
@@ -435,7 +571,8 @@ RawData::DecodeHits( void )
 	  int nhit = gUnpacker.get_entries( DetIdFHT1, layer, seg, UorD, LorT);
 	  for(int i = 0; i<nhit; ++i){
 	    int time  = gUnpacker.get( DetIdFHT1, layer, seg, UorD, LorT, i )  ;
-	    AddHodoRawHit( m_FHT1RawHC[2*layer + UorD], DetIdFHT1, layer, seg , UorD, kHodoLeading+LorT, time );
+	    AddHodoRawHit( m_FHT1RawHC[2*layer + UorD], DetIdFHT1, layer, seg , UorD, kHodoLeading+LorT, time,
+			   2*layer + UorD );
 	  }// multihit
 	}// LorT
       }// UorD
@@ -450,7 +587,8 @@ RawData::DecodeHits( void )
 	  int nhit = gUnpacker.get_entries( DetIdFHT2, layer, seg, UorD, LorT);
 	  for(int i = 0; i<nhit; ++i){
 	    int time  = gUnpacker.get( DetIdFHT2, layer, seg, UorD, LorT, i )  ;
-	    AddHodoRawHit( m_FHT2RawHC[2*layer + UorD], DetIdFHT2, layer, seg , UorD, kHodoLeading+LorT, time );
+	    AddHodoRawHit( m_FHT2RawHC[2*layer + UorD], DetIdFHT2, layer, seg , UorD, kHodoLeading+LorT, time,
+			   2*layer + UorD );
 	  }// multihit
 	}// LorT
       }// UorD
@@ -579,6 +717,9 @@ RawData::DecodeHits( void )
     }// for(seg)
   }
 
+  HodoIndex().Reset();
+  DCIndex().Reset();
+
   m_is_decoded = true;
   return true;
 }
@@ -588,11 +729,14 @@ bool
 RawData::DecodeCalibHits( void )
 {
   del::ClearContainer( m_VmeCalibRawHC );
+  HodoIndex().Reset();
 
   for( int plane=0; plane<NumOfPlaneVmeCalib; ++plane ){
     DecodeHodo( DetIdVmeCalib, plane, NumOfSegVmeCalib,
   		kOneSide, m_VmeCalibRawHC );
   }
 
+  HodoIndex().Reset();
+
   return true;
 }
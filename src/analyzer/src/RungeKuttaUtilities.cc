@@ -8,6 +8,7 @@
 
 #include "RungeKuttaUtilities.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -40,6 +41,39 @@ namespace
   const double CHLB     = 2.99792458E-4;
   // const double Polarity = 1.;
   const double Polarity = -1.;
+
+  // adaptive step of RK::Trace(), the mode is per thread
+  thread_local RK::EStepMode StepMode = RK::kAdaptiveStep;
+  const double  MinStepSize  = 1.;     // mm
+  const double  MaxStepSize  = 100.;   // mm
+  const double  Tolerance    = 1.e-4;  // mm, position error of one step
+  const double  MaxSagitta   = 1.e-3;  // mm, linear interpolation in CheckCrossing()
+  const double  StepSafety   = 0.9;
+  const double  MinStepScale = 0.1;
+  const double  MaxStepScale = 4.;
+
+  //____________________________________________________________________________
+  // factor to the next step from the errors of the last one,
+  // the error goes as h^4 and the sagitta as h^2
+  inline double
+  StepScale( double error, double sagitta )
+  {
+    double scale = MaxStepScale;
+    if( error>0. )
+      scale = std::min( scale, StepSafety*std::pow( Tolerance/error, 0.25 ) );
+    if( sagitta>0. )
+      scale = std::min( scale, StepSafety*std::sqrt( MaxSagitta/sagitta ) );
+    return std::max( scale, MinStepScale );
+  }
+
+  //____________________________________________________________________________
+  // step points for the event display, reused by the calls of one thread
+  inline std::vector<ThreeVector>&
+  StepPointBuffer( void )
+  {
+    static thread_local std::vector<ThreeVector> g_buffer;
+    return g_buffer;
+  }
 }
 
 #define WARNOUT 0
@@ -259,9 +293,32 @@ RK::CalcDeltaFieldIntegral( const RKTrajectoryPoint    &prevPoint,
 			       dkyx, dkyy, dkyu, dkyv, dkyq );
 }
 
+//______________________________________________________________________________
+RK::EStepMode
+RK::GetStepMode( void )
+{
+  return StepMode;
+}
+
+//______________________________________________________________________________
+void
+RK::SetStepMode( EStepMode mode )
+{
+  StepMode = mode;
+}
+
 //______________________________________________________________________________
 RKTrajectoryPoint
 RK::TraceOneStep( double StepSize, const RKTrajectoryPoint &prevPoint )
+{
+  double error, sagitta;
+  return RK::TraceOneStep( StepSize, prevPoint, error, sagitta );
+}
+
+//______________________________________________________________________________
+RKTrajectoryPoint
+RK::TraceOneStep( double StepSize, const RKTrajectoryPoint &prevPoint,
+		  double &error, double &sagitta )
 {
   static const std::string func_name = "[RK::TraceOneStep()]";
 
@@ -274,14 +331,14 @@ RK::TraceOneStep( double StepSize, const RKTrajectoryPoint &prevPoint )
   double dr    = StepSize/std::sqrt( 1.+pre_u*pre_u+pre_v*pre_v );
 
   ThreeVector Z1 = prevPoint.PositionInGlobal();
-  ThreeVector B1 = gField.GetField( Z1 );
 #ifdef ExactFFTreat
-  ThreeVector dBdX1 = gField.GetdBdX( Z1 );
-  ThreeVector dBdY1 = gField.GetdBdY( Z1 );
+  ThreeVector B1, dBdX1, dBdY1;
+  gField.GetFieldAndGradient( Z1, B1, dBdX1, dBdY1 );
   RKFieldIntegral f1 =
     RK::CalcFieldIntegral( pre_u, pre_v, pre_q,
 			   B1, dBdX1, dBdY1 );
 #else
+  ThreeVector B1 = gField.GetField( Z1 );
   RKFieldIntegral f1 =
     RK::CalcFieldIntegral( pre_u, pre_v, pre_q, B1 );
 #endif
@@ -292,15 +349,15 @@ RK::TraceOneStep( double StepSize, const RKTrajectoryPoint &prevPoint )
     ThreeVector( 0.5*dr,
                  0.5*dr*pre_u + 0.125*dr*dr*f1.kx,
                  0.5*dr*pre_v + 0.125*dr*dr*f1.ky );
-  ThreeVector B2 = gField.GetField( Z2 );
 #ifdef ExactFFTreat
-  ThreeVector dBdX2 = gField.GetdBdX( Z2 );
-  ThreeVector dBdY2 = gField.GetdBdY( Z2 );
+  ThreeVector B2, dBdX2, dBdY2;
+  gField.GetFieldAndGradient( Z2, B2, dBdX2, dBdY2 );
   RKFieldIntegral f2 =
     RK::CalcFieldIntegral( pre_u + 0.5*dr*f1.kx,
 			   pre_v + 0.5*dr*f1.ky,
 			   pre_q, B2, dBdX2, dBdY2 );
 #else
+  ThreeVector B2 = gField.GetField( Z2 );
   RKFieldIntegral f2 =
     RK::CalcFieldIntegral( pre_u + 0.5*dr*f1.kx,
 			   pre_v + 0.5*dr*f1.ky,
@@ -327,15 +384,15 @@ RK::TraceOneStep( double StepSize, const RKTrajectoryPoint &prevPoint )
     ThreeVector( dr,
                  dr*pre_u + 0.5*dr*dr*f3.kx,
                  dr*pre_v + 0.5*dr*dr*f3.ky );
-  ThreeVector B4 = gField.GetField( Z4 );
 #ifdef ExactFFTreat
-  ThreeVector dBdX4 = gField.GetdBdX( Z4 );
-  ThreeVector dBdY4 = gField.GetdBdY( Z4 );
+  ThreeVector B4, dBdX4, dBdY4;
+  gField.GetFieldAndGradient( Z4, B4, dBdX4, dBdY4 );
   RKFieldIntegral f4 =
     RK::CalcFieldIntegral( pre_u + dr*f3.kx,
 			   pre_v + dr*f3.ky,
 			   pre_q, B4, dBdX4, dBdY4 );
 #else
+  ThreeVector B4 = gField.GetField( Z4 );
   RKFieldIntegral f4 =
     RK::CalcFieldIntegral( pre_u + dr*f3.kx,
                          pre_v + dr*f3.ky,
@@ -398,6 +455,11 @@ RK::TraceOneStep( double StepSize, const RKTrajectoryPoint &prevPoint )
 
   double dl = (ThreeVector(x,y,z)-Z1).Mag()*StepSize/std::abs(StepSize);
 
+  // embedded estimate of the Nystrom stages, no more field evaluation
+  error = dr*dr*( std::abs( f1.kx-f2.kx-f3.kx+f4.kx ) +
+		  std::abs( f1.ky-f2.ky-f3.ky+f4.ky ) );
+  sagitta = 0.125*std::abs(dr)*( std::abs( u-pre_u ) + std::abs( v-pre_v ) );
+
 #if 0
   {
     PrintHelper helper( 2, std::ios::fixed );
@@ -643,21 +705,40 @@ RK::Trace( const RKCordParameter &initial, RKHitPointContainer &hitContainer )
   int    MaxStep        = 40000;
   static const double MaxPathLength  = 6000.; // mm
   static const double NormalStepSize = - 10.;   // mm
-  double MinStepSize = 2.;     // mm
+  double FixedMinStepSize = 2.;     // mm
 
   /*for EventDisplay*/
-  ThreeVector StepPoint[MaxStep];
+  const bool record = gEvDisp.IsReady();
+  std::vector<ThreeVector>& StepPoint = StepPointBuffer();
+  StepPoint.clear();
+
+  const bool adaptive = ( StepMode==kAdaptiveStep );
+  double StepSize = NormalStepSize;
 
   int iStep = 0;
 
   while( ++iStep < MaxStep ){
     //    std::cout << "step#: " << iStep << std::endl;
-    double StepSize = gField.StepSize( prevPoint.PositionInGlobal(),
-				       NormalStepSize, MinStepSize );
-    RKTrajectoryPoint nextPoint = RK::TraceOneStep( StepSize, prevPoint );
+    if( !adaptive )
+      StepSize = gField.StepSize( prevPoint.PositionInGlobal(),
+				  NormalStepSize, FixedMinStepSize );
+    double error = 0., sagitta = 0.;
+    RKTrajectoryPoint nextPoint =
+      RK::TraceOneStep( StepSize, prevPoint, error, sagitta );
+    if( adaptive ){
+      // shorter steps until both errors are within the limits
+      while( ( error>Tolerance || sagitta>MaxSagitta ) &&
+	     std::abs(StepSize)>MinStepSize ){
+	StepSize *= StepScale( error, sagitta );
+	if( std::abs(StepSize)<MinStepSize )
+	  StepSize = std::copysign( MinStepSize, StepSize );
+	nextPoint = RK::TraceOneStep( StepSize, prevPoint, error, sagitta );
+      }
+    }
 
     /*for EventDisplay*/
-    StepPoint[iStep-1] = nextPoint.PositionInGlobal();
+    if( record )
+      StepPoint.push_back( nextPoint.PositionInGlobal() );
 
     while( RK::CheckCrossing( hitContainer[iPlane].first,
 			      prevPoint, nextPoint,
@@ -699,9 +780,9 @@ RK::Trace( const RKCordParameter &initial, RKHitPointContainer &hitContainer )
 #endif
       --iPlane;
       if( iPlane<0 ) {
-	if( gEvDisp.IsReady() ){
+	if( record && !StepPoint.empty() ){
 	  double q = hitContainer[0].second.MomentumInGlobal().z();
-	  gEvDisp.DrawKuramaTrack( iStep, StepPoint, q );
+	  gEvDisp.DrawKuramaTrack( StepPoint.size(), &StepPoint[0], q );
         }
 	return KuramaTrack::kPassed;
       }
@@ -718,6 +799,11 @@ RK::Trace( const RKCordParameter &initial, RKHitPointContainer &hitContainer )
       return KuramaTrack::kExceedMaxPathLength;
     }
     prevPoint = nextPoint;
+    if( adaptive ){
+      StepSize *= StepScale( error, sagitta );
+      if( std::abs(StepSize)>MaxStepSize )
+	StepSize = std::copysign( MaxStepSize, StepSize );
+    }
   }// while( ++iStep )
 
 #if WARNOUT
@@ -761,22 +847,15 @@ RK::TraceToLast( RKHitPointContainer &hitContainer )
 
   iPlane += 1;
 
-  ThreeVector StepPoint[MaxStep];
   int iStep = 0;
   while( ++iStep < MaxStep ){
     RKTrajectoryPoint
       nextPoint = RK::TraceOneStep( -StepSize, prevPoint );
 
-    StepPoint[iStep-1] = nextPoint.PositionInGlobal();
-
     while( RK::CheckCrossing( hitContainer[iPlane].first,
 			      prevPoint, nextPoint,
 			      hitContainer[iPlane].second ) ){
       if( ++iPlane>=nPlane ){
-	// if( gEvDisp.IsReady() ){
-	//   double q = hitContainer[0].second.MomentumInGlobal().z();
-	//   gEvDisp.DrawKuramaTrack( iStep, StepPoint, q );
-        // }
 	return true;
       }
     }
@@ -786,56 +865,69 @@ RK::TraceToLast( RKHitPointContainer &hitContainer )
   return false;
 }
 
-//______________________________________________________________________________
-RKHitPointContainer
-RK::MakeHPContainer( void )
+namespace
 {
-  std::vector<int> IdList   = gGeom.GetDetectorIDList();
-  static const std::size_t size = IdList.size();
-  RKHitPointContainer container;
-  container.reserve( size );
-
-  // for( std::size_t i=0; i<size; ++i ){
-  //   if( IdList[i]<IdTOF )
-  //     container.push_back( std::make_pair( IdList[i], RKcalcHitPoint() ) );
-  // }
-
-  /*** From Upstream ***/
-  container.push_back( std::make_pair( IdTarget, RKcalcHitPoint() ) );
-  
-  for( std::size_t i=0; i<NumOfLayersSFT; ++i ){
-    std::size_t plid = i +PlOffsSft +1;
-    container.push_back( std::make_pair( plid, RKcalcHitPoint() ) );
-  }
-  for( std::size_t i=0; i<NumOfLayersSDC1; ++i ){
-    std::size_t plid = i +PlOffsSdcIn +1;
-    container.push_back( std::make_pair( plid, RKcalcHitPoint() ) );
-  }
-  for( std::size_t i=0; i<NumOfLayersVP; ++i ){
-    std::size_t plid = i +PlOffsVP +1;
-    container.push_back( std::make_pair( plid, RKcalcHitPoint() ) );
-  }
-  for( std::size_t i=0; i<NumOfLayersSdcOut; ++i ){
-    std::size_t plid = 80;
-    if( i<4 ){
-      plid = i +PlOffsFbt;
+  //____________________________________________________________________________
+  RKHitPointContainer
+  MakeLayerContainer( void )
+  {
+    std::vector<int> IdList   = gGeom.GetDetectorIDList();
+    const std::size_t size = IdList.size();
+    RKHitPointContainer container;
+    container.reserve( size );
+
+    // for( std::size_t i=0; i<size; ++i ){
+    //   if( IdList[i]<IdTOF )
+    //     container.push_back( std::make_pair( IdList[i], RKcalcHitPoint() ) );
+    // }
+
+    /*** From Upstream ***/
+    container.push_back( std::make_pair( IdTarget, RKcalcHitPoint() ) );
+
+    for( std::size_t i=0; i<NumOfLayersSFT; ++i ){
+      std::size_t plid = i +PlOffsSft +1;
+      container.push_back( std::make_pair( plid, RKcalcHitPoint() ) );
     }
-    else if( i<12 ){
-      plid = i -3 +PlOffsSdcOut;
+    for( std::size_t i=0; i<NumOfLayersSDC1; ++i ){
+      std::size_t plid = i +PlOffsSdcIn +1;
+      container.push_back( std::make_pair( plid, RKcalcHitPoint() ) );
     }
-    else{
-      plid = i -8 +PlOffsFbt;
+    for( std::size_t i=0; i<NumOfLayersVP; ++i ){
+      std::size_t plid = i +PlOffsVP +1;
+      container.push_back( std::make_pair( plid, RKcalcHitPoint() ) );
     }
-    
-    container.push_back( std::make_pair( plid, RKcalcHitPoint() ) );
+    for( std::size_t i=0; i<NumOfLayersSdcOut; ++i ){
+      std::size_t plid = 80;
+      if( i<4 ){
+        plid = i +PlOffsFbt;
+      }
+      else if( i<12 ){
+        plid = i -3 +PlOffsSdcOut;
+      }
+      else{
+        plid = i -8 +PlOffsFbt;
+      }
+
+      container.push_back( std::make_pair( plid, RKcalcHitPoint() ) );
+    }
+
+    container.push_back( std::make_pair( IdTOF_UX, RKcalcHitPoint() ) );
+    container.push_back( std::make_pair( IdTOF_UY, RKcalcHitPoint() ) );
+    container.push_back( std::make_pair( IdTOF_DX, RKcalcHitPoint() ) );
+    container.push_back( std::make_pair( IdTOF_DY, RKcalcHitPoint() ) );
+
+    return container;
   }
-  
-  container.push_back( std::make_pair( IdTOF_UX, RKcalcHitPoint() ) );
-  container.push_back( std::make_pair( IdTOF_UY, RKcalcHitPoint() ) );
-  container.push_back( std::make_pair( IdTOF_DX, RKcalcHitPoint() ) );
-  container.push_back( std::make_pair( IdTOF_DY, RKcalcHitPoint() ) );
+}
 
-  return container;
+//______________________________________________________________________________
+RKHitPointContainer
+RK::MakeHPContainer( void )
+{
+  // the layers are fixed once the geometry is read, so the container is
+  // built by the first fit and only copied by the others, from any thread
+  static const RKHitPointContainer g_container = MakeLayerContainer();
+  return g_container;
 }
 
 //______________________________________________________________________________
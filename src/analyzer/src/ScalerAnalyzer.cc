@@ -32,6 +32,27 @@ namespace
 {
   using namespace hddaq::unpacker;
   const UnpackerManager& gUnpacker = GUnpacker::get_instance();
+
+  //____________________________________________________________________________
+  // *-SUM channels, filled from the sheet entries named term%02d
+  struct SumDef
+  {
+    const char* sum;
+    const char* term;
+    Int_t       n_term;
+  };
+  const SumDef SumDefs[] = {
+    { "BH1-SUM", "BH1-%02d", NumOfSegBH1 },
+    // { "BH2-SUM", "BH2-%02d", GetFlag(kScalerE42) ? NumOfSegBH2_E42 : NumOfSegBH2 },
+    { "BH2-SUM", "BH2-%02d", NumOfSegBH2 },
+    { "SCH-SUM", "SCH-%02d", NumOfSegSCH },
+    { "LAC-SUM", "LAC-%02d", NumOfSegLAC/2 },
+  };
+
+  // [ScalerAnalyzer::eKey]
+  const char* KeyName[] = {
+    "BH2", "TM", "L1-Req", "L1-Acc", "L2-Acc", "Live-Time", "Real-Time"
+  };
 }
 
 //______________________________________________________________________________
@@ -43,13 +64,20 @@ ScalerAnalyzer::ScalerAnalyzer()
     m_is_spill_end(false),
     m_is_spill_on_end(false),
     m_run_number(-1),
-    m_canvas()
+    m_canvas(),
+    m_handle(),
+    m_decode_list(),
+    m_sum_list(),
+    m_key(nKey, -1),
+    m_spill(-1),
+    m_is_first(true)
 {
   for (Int_t i=0; i<MaxColumn; ++i){
     for (Int_t j=0; j<MaxRow; ++j){
       m_info[i][j] = ScalerInfo("n/a", i, j, false);
     }
   }
+  Compile();
 }
 
 //______________________________________________________________________________
@@ -61,10 +89,10 @@ ScalerAnalyzer::~ScalerAnalyzer()
 void
 ScalerAnalyzer::Clear(Option_t* opt)
 {
+  const Bool_t all = TString(opt).EqualTo("all");
   for (Int_t i=0; i<MaxColumn; ++i){
     for (Int_t j=0; j<MaxRow; ++j){
-      if (!TString(opt).EqualTo("all") &&
-	 m_info[i][j].name.EqualTo("Spill")){
+      if (!all && i*MaxRow+j == m_spill){
 	continue;
       }
       m_info[i][j].data = 0;
@@ -72,6 +100,53 @@ ScalerAnalyzer::Clear(Option_t* opt)
   }
 }
 
+//______________________________________________________________________________
+// Resolves the sheet into handles once, so that Decode() and Print() do
+// not look up any name per event.
+void
+ScalerAnalyzer::Compile()
+{
+  m_handle.clear();
+  m_decode_list.clear();
+  m_sum_list.clear();
+  m_spill = -1;
+  m_is_first = true;
+
+  for (Int_t i=0; i<MaxColumn; ++i){
+    for (Int_t j=0; j<MaxRow; ++j){
+      const ScalerInfo& info = m_info[i][j];
+      const ScalerHandle handle = i*MaxRow+j;
+      // the first one wins as the linear search did
+      m_handle.insert(std::make_pair(info.name, handle));
+      if (info.name.EqualTo("Spill")){
+	if (m_spill<0)
+	  m_spill = handle;
+	continue;
+      }
+      if (!info.flag_disp || info.module_id < 0 || info.channel < 0)
+	continue;
+      m_decode_list.push_back(handle);
+    }
+  }
+
+  for (const auto& def : SumDefs){
+    SumList list;
+    list.sum = GetHandle(def.sum);
+    if (list.sum < 0)
+      continue;
+    for (Int_t i=0; i<def.n_term; ++i){
+      ScalerHandle term = GetHandle(Form(def.term, i+1));
+      if (term >= 0)
+	list.term.push_back(term);
+    }
+    m_sum_list.push_back(list);
+  }
+
+  for (Int_t i=0; i<nKey; ++i){
+    m_key[i] = GetHandle(KeyName[i]);
+  }
+}
+
 //______________________________________________________________________________
 Bool_t
 ScalerAnalyzer::Decode()
@@ -134,96 +209,49 @@ ScalerAnalyzer::Decode()
   {
     static const Int_t device_id  = gUnpacker.get_device_id("Scaler");
 
-    for (Int_t i=0; i<MaxColumn; ++i){
-      for (Int_t j=0; j<MaxRow; ++j){
-	if (!m_info[i][j].flag_disp)
-	  continue;
-	if (m_info[i][j].name.EqualTo("Spill"))
-	  continue;
+    for (const auto handle : m_decode_list){
+      ScalerInfo& info = m_info[handle/MaxRow][handle%MaxRow];
+      Int_t module_id = info.module_id;
+      Int_t channel   = info.channel;
 
-	Int_t module_id = m_info[i][j].module_id;
-	Int_t channel   = m_info[i][j].channel;
-
-	if (module_id < 0 || channel < 0)
-	  continue;
-
-	Int_t nhit = gUnpacker.get_entries(device_id, module_id, 0, channel, 0);
-	if (nhit<=0) continue;
-	Scaler val = gUnpacker.get(device_id, module_id, 0, channel, 0);
-
-	if (m_info[i][j].prev > val){
-	  m_spill_increment = true;
-	  m_info[i][j].prev = 0;
-	}
-
-	m_info[i][j].curr  = val;
-    	if (m_flag[kSpillBySpill] && m_spill_increment)
-    	  m_info[i][j].data = val;
-	else
-	  m_info[i][j].data += val - m_info[i][j].prev;
-	m_info[i][j].prev  = m_info[i][j].curr;
-      }
-    }
-  }
-
-  //////////////////// for BH1 SUM
-  {
-    if (Has("BH1-SUM")){
-      static Channel ch = Find("BH1-SUM");
-      m_info[ch.first][ch.second].data = 0;
-      for (Int_t i=0; i<NumOfSegBH1; ++i){
-	m_info[ch.first][ch.second].data += Get(Form("BH1-%02d", i+1));
-      }
-    }
-  }
+      Int_t nhit = gUnpacker.get_entries(device_id, module_id, 0, channel, 0);
+      if (nhit<=0) continue;
+      Scaler val = gUnpacker.get(device_id, module_id, 0, channel, 0);
 
-  //////////////////// for BH2 SUM
-  {
-    if (Has("BH2-SUM")){
-      static Channel ch = Find("BH2-SUM");
-      m_info[ch.first][ch.second].data = 0;
-      // static const Int_t n = GetFlag(kScalerE42) ? NumOfSegBH2_E42 : NumOfSegBH2;
-      static const Int_t n = NumOfSegBH2;
-      for (Int_t i=0; i<n; ++i){
-	m_info[ch.first][ch.second].data += Get(Form("BH2-%02d", i+1));
+      if (info.prev > val){
+	m_spill_increment = true;
+	info.prev = 0;
       }
-    }
-  }
 
-  //////////////////// for SCH SUM
-  {
-    if (Has("SCH-SUM")){
-      static Channel ch = Find("SCH-SUM");
-      m_info[ch.first][ch.second].data = 0;
-      for (Int_t i=0; i<NumOfSegSCH; ++i){
-	m_info[ch.first][ch.second].data += Get(Form("SCH-%02d", i+1));
-      }
+      info.curr  = val;
+      if (m_flag[kSpillBySpill] && m_spill_increment)
+	info.data = val;
+      else
+	info.data += val - info.prev;
+      info.prev  = info.curr;
     }
   }
 
-  //////////////////// for LAC SUM
-  {
-    if (Has("LAC-SUM")){
-      static Channel ch = Find("LAC-SUM");
-      m_info[ch.first][ch.second].data = 0;
-      for (Int_t i=0; i<NumOfSegLAC/2; ++i){
-	m_info[ch.first][ch.second].data += Get(Form("LAC-%02d", i+1));
-      }
+  //////////////////// for BH1/BH2/SCH/LAC SUM
+  for (const auto& list : m_sum_list){
+    Scaler& sum = m_info[list.sum/MaxRow][list.sum%MaxRow].data;
+    sum = 0;
+    for (const auto term : list.term){
+      sum += Get(term);
     }
   }
 
   //////////////////// Spill
   {
-    if (Has("Spill")){
-      static Bool_t first = true;
-      static Channel p = Find("Spill");
-      if (first && !m_flag[kScalerSheet]){
-	m_info[p.first][p.second].data++;
-	first = false;
+    if (m_spill >= 0){
+      Scaler& spill = m_info[m_spill/MaxRow][m_spill%MaxRow].data;
+      if (m_is_first && !m_flag[kScalerSheet]){
+	spill++;
+	m_is_first = false;
       }
       if (m_spill_increment ||
 	 (m_flag[kScalerSheet] && m_is_spill_end)){
-	m_info[p.first][p.second].data++;
+	spill++;
       }
     }
   }
@@ -234,8 +262,8 @@ ScalerAnalyzer::Decode()
 Double_t
 ScalerAnalyzer::Duty() const
 {
-  Double_t daq_eff  = Fraction("L1-Acc","L1-Req");
-  Double_t live_eff = Fraction("Live-Time","Real-Time");
+  Double_t daq_eff  = Fraction(m_key[kKeyL1Acc], m_key[kKeyL1Req]);
+  Double_t live_eff = Fraction(m_key[kKeyLiveTime], m_key[kKeyRealTime]);
   Double_t duty = daq_eff/(1.-daq_eff)*(1./live_eff-1.);
   if (duty > 1. || TMath::IsNaN(duty))
     return 1.;
@@ -323,13 +351,9 @@ ScalerAnalyzer::DrawOneLine(const TString& title1,
 Channel
 ScalerAnalyzer::Find(const TString& name) const
 {
-  for (Int_t i=0; i<MaxColumn; ++i){
-    for (Int_t j=0; j<MaxRow; ++j){
-      if (m_info[i][j].name.EqualTo(name)){
-	return Channel(i, j);
-      }
-    }
-  }
+  ScalerHandle handle = GetHandle(name);
+  if (handle >= 0)
+    return Channel(handle/MaxRow, handle%MaxRow);
 
   m_ost << "#W " << FUNC_NAME << " "
 	<< "no such name : " << name << std::endl;
@@ -344,17 +368,20 @@ ScalerAnalyzer::Fraction(const TString& num, const TString& den) const
   return (Double_t)Get(num) / Get(den);
 }
 
+//______________________________________________________________________________
+Double_t
+ScalerAnalyzer::Fraction(ScalerHandle num, ScalerHandle den) const
+{
+  return (Double_t)Get(num) / Get(den);
+}
+
 //______________________________________________________________________________
 Scaler
 ScalerAnalyzer::Get(const TString& name) const
 {
-  for (Int_t i=0; i<MaxColumn; ++i){
-    for (Int_t j=0; j<MaxRow; ++j){
-      if (m_info[i][j].name.EqualTo(name)){
-	return m_info[i][j].data;
-      }
-    }
-  }
+  ScalerHandle handle = GetHandle(name);
+  if (handle >= 0)
+    return Get(handle);
 
   m_ost << "#W " << FUNC_NAME << " "
 	<< "no such ScalerInfo : " << name << std::endl;
@@ -362,19 +389,21 @@ ScalerAnalyzer::Get(const TString& name) const
   return 0;
 }
 
+//______________________________________________________________________________
+ScalerHandle
+ScalerAnalyzer::GetHandle(const TString& name) const
+{
+  auto itr = m_handle.find(name);
+  if (itr == m_handle.end())
+    return -1;
+  return itr->second;
+}
+
 //______________________________________________________________________________
 Bool_t
 ScalerAnalyzer::Has(const TString& name) const
 {
-  for (Int_t i=0; i<MaxColumn; ++i){
-    for (Int_t j=0; j<MaxRow; ++j){
-      if (m_info[i][j].name.EqualTo(name)){
-	return true;
-      }
-    }
-  }
-
-  return false;
+  return (GetHandle(name) >= 0);
 }
 
 //______________________________________________________________________________
@@ -459,11 +488,11 @@ ScalerAnalyzer::Print(Option_t*) const
     if (GetFlag(kScalerDaq)){
       m_ost << std::endl  << std::setprecision(6) << std::fixed
 	    << std::left  << std::setw(16) << "Live/Real"
-	    << std::right << std::setw(16) << Fraction("Live-Time","Real-Time") << std::endl
+	    << std::right << std::setw(16) << Fraction(m_key[kKeyLiveTime], m_key[kKeyRealTime]) << std::endl
 	    << std::left  << std::setw(16) << "DAQ-Eff"
-	    << std::right << std::setw(16) << Fraction("L1-Acc","L1-Req") << std::endl
+	    << std::right << std::setw(16) << Fraction(m_key[kKeyL1Acc], m_key[kKeyL1Req]) << std::endl
 	    << std::left  << std::setw(16) << "L2-Eff"
-	    << std::right << std::setw(16) << Fraction("L2-Acc","L1-Acc") << std::endl
+	    << std::right << std::setw(16) << Fraction(m_key[kKeyL2Acc], m_key[kKeyL1Acc]) << std::endl
 	    << std::left  << std::setw(16) << "Duty-Factor"
 	    << std::right << std::setw(16) << Duty() << std::endl;
     }
@@ -491,15 +520,15 @@ ScalerAnalyzer::Print(Option_t*) const
     if (!GetFlag(kScalerSch) && !GetFlag(kScalerE42) && !GetFlag(kScalerHBX)){
       m_ost << std::endl  << std::setprecision(6) << std::fixed
 	    << std::left  << std::setw(16) << "BH2/TM"
-	    << std::right << std::setw(16) << Fraction("BH2", "TM") << " : "
+	    << std::right << std::setw(16) << Fraction(m_key[kKeyBH2], m_key[kKeyTM]) << " : "
 	    << std::left  << std::setw(16) << "Live/Real"
-	    << std::right << std::setw(16) << Fraction("Live-Time","Real-Time") << " : "
+	    << std::right << std::setw(16) << Fraction(m_key[kKeyLiveTime], m_key[kKeyRealTime]) << " : "
 	    << std::left  << std::setw(16) << "DAQ-Eff"
-	    << std::right << std::setw(16) << Fraction("L1-Acc","L1-Req") << std::endl
+	    << std::right << std::setw(16) << Fraction(m_key[kKeyL1Acc], m_key[kKeyL1Req]) << std::endl
 	    << std::left  << std::setw(16) << "L1Req/BH2"
-	    << std::right << std::setw(16) << Fraction("L1-Req", "BH2") << " : "
+	    << std::right << std::setw(16) << Fraction(m_key[kKeyL1Req], m_key[kKeyBH2]) << " : "
 	    << std::left  << std::setw(16) << "L2-Eff"
-	    << std::right << std::setw(16) << Fraction("L2-Acc","L1-Acc") << " : "
+	    << std::right << std::setw(16) << Fraction(m_key[kKeyL2Acc], m_key[kKeyL1Acc]) << " : "
 	    << std::left  << std::setw(16) << "Duty-Factor"
 	    << std::right << std::setw(16) << Duty() << std::endl
 	    << std::endl;
@@ -626,5 +655,6 @@ ScalerAnalyzer::Set(Int_t i, Int_t j, const ScalerInfo& info)
     throw Exception(FUNC_NAME+" "+info.name);
   } else {
     m_info[i][j] = info;
+    Compile();
   }
 }
@@ -0,0 +1,161 @@
+/**
+ *  file: TaskPool.cc
+ *  date: 2026.10.17
+ *
+ */
+
+#include "TaskPool.hh"
+
+#include <cstdlib>
+#include <string>
+
+#include <std_ostream.hh>
+
+namespace
+{
+  const std::string& class_name("TaskPool");
+}
+
+//______________________________________________________________________________
+TaskPool::TaskPool( void )
+  : m_thread(),
+    m_job(),
+    m_mutex(),
+    m_cond_job(),
+    m_cond_done(),
+    m_is_end(false)
+{
+}
+
+//______________________________________________________________________________
+TaskPool::~TaskPool( void )
+{
+  Stop();
+}
+
+//______________________________________________________________________________
+// Takes one index of the job and runs it with the lock released.
+// Returns false if no index is left. The job is removed from the queue
+// when its last index is taken, and may be gone as soon as n_done is
+// counted up.
+bool
+TaskPool::Execute( std::unique_lock<std::mutex>& lock, Job* job )
+{
+  if( job->next>=job->n )
+    return false;
+
+  const std::size_t i = job->next++;
+  if( job->next==job->n ){
+    for( std::deque<Job*>::iterator itr=m_job.begin(), end=m_job.end();
+	 itr!=end; ++itr ){
+      if( *itr==job ){
+	m_job.erase( itr );
+	break;
+      }
+    }
+  }
+
+  std::exception_ptr error;
+  lock.unlock();
+  try {
+    (*job->task)( i );
+  } catch( ... ){
+    error = std::current_exception();
+  }
+  lock.lock();
+
+  if( error && !job->error )
+    job->error = error;
+  if( ++job->n_done==job->n )
+    m_cond_done.notify_all();
+  return true;
+}
+
+//______________________________________________________________________________
+void
+TaskPool::Run( std::size_t n, const Task& task )
+{
+  if( n==0 )
+    return;
+
+  if( m_thread.empty() || n==1 ){
+    for( std::size_t i=0; i<n; ++i )
+      task( i );
+    return;
+  }
+
+  Job job = { &task, n, 0, 0, std::exception_ptr() };
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_job.push_back( &job );
+  m_cond_job.notify_all();
+
+  while( Execute( lock, &job ) ){}
+  m_cond_done.wait( lock, [&job]{ return job.n_done==job.n; } );
+  lock.unlock();
+
+  if( job.error )
+    std::rethrow_exception( job.error );
+}
+
+//______________________________________________________________________________
+void
+TaskPool::RunWorker( void )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( true ){
+    m_cond_job.wait( lock, [this]{ return !m_job.empty() || m_is_end; } );
+    if( m_is_end )
+      return;
+    Execute( lock, m_job.front() );
+  }
+}
+
+//______________________________________________________________________________
+// --fit-thread=N of the command line, the pool is left as it is without
+bool
+TaskPool::ParseOption( const std::vector<std::string>& argv )
+{
+  static const std::string option("--fit-thread=");
+  for( std::size_t i=0, n=argv.size(); i<n; ++i ){
+    if( argv[i].find( option )==0 ){
+      SetNThread( std::atoi( argv[i].substr( option.size() ).c_str() ) );
+      return true;
+    }
+  }
+  return false;
+}
+
+//______________________________________________________________________________
+void
+TaskPool::SetNThread( int n )
+{
+  static const std::string func_name("["+class_name+"::"+__func__+"()]");
+
+  if( n<1 ) n = 1;
+  if( static_cast<std::size_t>(n)==GetNThread() )
+    return;
+
+  Stop();
+
+  m_is_end = false;
+  for( int i=1; i<n; ++i )
+    m_thread.push_back( std::thread( &TaskPool::RunWorker, this ) );
+
+  hddaq::cout << "#D " << func_name << " " << GetNThread()
+	      << " threads" << std::endl;
+}
+
+//______________________________________________________________________________
+void
+TaskPool::Stop( void )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_is_end = true;
+  }
+  m_cond_job.notify_all();
+  for( std::size_t i=0, n=m_thread.size(); i<n; ++i )
+    m_thread[i].join();
+  m_thread.clear();
+}
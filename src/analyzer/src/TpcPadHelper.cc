@@ -84,8 +84,20 @@ TpcPadParam::Print( void ) const
 
 //_____________________________________________________________________________
 TpcPadHelper::TpcPadHelper( void )
-  : m_map()
+  : m_map(),
+    m_n_row( 0 ),
+    m_layer_row_table(),
+    m_pad_table(),
+    m_pad_list(),
+    m_point_table()
 {
+  // pad positions only depend on PadParameter
+  Int_t n_pad = 0;
+  for( Int_t layer=0; layer<NumOfLayersTPC; ++layer )
+    n_pad += PadParameter[layer][kNumOfPad];
+  m_point_table.reserve( n_pad );
+  for( Int_t pad=0; pad<n_pad; ++pad )
+    m_point_table.push_back( CalcPoint( pad ) );
 }
 
 //_____________________________________________________________________________
@@ -136,11 +148,11 @@ TpcPadHelper::GetParam( Int_t asad, Int_t aget, Int_t channel ) const
 TpcPadParam*
 TpcPadHelper::GetParam( Int_t layer, Int_t row ) const
 {
-  for( const auto& p : m_map ){
-    if( p.second->LayerId() == layer &&
-        p.second->RowId() == row ){
-      return p.second;
-    }
+  if( 0 <= layer && layer < NumOfLayersTPC &&
+      0 <= row && row < m_n_row ){
+    TpcPadParam* param = m_layer_row_table[layer*m_n_row+row];
+    if( param )
+      return param;
   }
 #if 0
   std::cerr << FUNC_NAME << " No parameter, Layer=" << layer
@@ -153,10 +165,8 @@ TpcPadHelper::GetParam( Int_t layer, Int_t row ) const
 TpcPadParam*
 TpcPadHelper::GetParam( Int_t pad ) const
 {
-  for( const auto& p : m_map ){
-    if( p.second->PadId() == pad )
-      return p.second;
-  }
+  if( 0 <= pad && pad < (Int_t)m_pad_table.size() && m_pad_table[pad] )
+    return m_pad_table[pad];
 #if 0
   std::cerr << FUNC_NAME << " No parameter, Pad=" << pad << std::endl;
 #endif
@@ -166,6 +176,25 @@ TpcPadHelper::GetParam( Int_t pad ) const
 //_____________________________________________________________________________
 TVector3
 TpcPadHelper::GetPoint( Int_t pad ) const
+{
+  if( 0 <= pad && pad < (Int_t)m_point_table.size() )
+    return m_point_table[pad];
+  return CalcPoint( pad );
+}
+
+//_____________________________________________________________________________
+void
+TpcPadHelper::GetPoints( const std::vector<Int_t>& pad_list,
+                         std::vector<TVector3>& point_list ) const
+{
+  point_list.resize( pad_list.size() );
+  for( std::size_t i=0, n=pad_list.size(); i<n; ++i )
+    point_list[i] = GetPoint( pad_list[i] );
+}
+
+//_____________________________________________________________________________
+TVector3
+TpcPadHelper::CalcPoint( Int_t pad )
 {
   TVector3 vec;
   Int_t layer, row;
@@ -225,8 +254,38 @@ TpcPadHelper::Initialize( const TString &file_name )
       continue;
       // return false;
     }
-    m_map[key] = new TpcPadParam( asad, aget, channel,
-                                  pad, layer, row );
+    TpcPadParam* param = new TpcPadParam( asad, aget, channel,
+                                          pad, layer, row );
+    m_map[key] = param;
+    if( pad >= 0 ){
+      if( pad >= (Int_t)m_pad_table.size() )
+        m_pad_table.resize( pad+1, nullptr );
+      m_pad_table[pad] = param;
+    }
+  }
+
+  // (layer,row) table, the first parameter of a (layer,row) wins as in
+  // the former linear search over m_map
+  m_n_row = 0;
+  for( const auto& p : m_map ){
+    if( m_n_row <= p.second->RowId() )
+      m_n_row = p.second->RowId() + 1;
+  }
+  m_layer_row_table.assign( NumOfLayersTPC*m_n_row, nullptr );
+  for( const auto& p : m_map ){
+    Int_t layer = p.second->LayerId();
+    Int_t row   = p.second->RowId();
+    if( layer < 0 || NumOfLayersTPC <= layer || row < 0 )
+      continue;
+    TpcPadParam*& cell = m_layer_row_table[layer*m_n_row+row];
+    if( !cell )
+      cell = p.second;
+  }
+  // mapped channels without a pad (PadId()<0) are not listed
+  m_pad_list.clear();
+  for( const auto& param : m_layer_row_table ){
+    if( param && param->PadId() >= 0 )
+      m_pad_list.push_back( param );
   }
 #if 0
   std::cout << FUNC_NAME << " " << file_name
@@ -17,19 +17,20 @@
 namespace
 {
   const std::string& class_name("TrackHit");
+  debug::ObjectCounter::Counter gCounter( class_name );
 }
 
 //______________________________________________________________________________
 TrackHit::TrackHit( DCLTrackHit *hit )
   : m_dcltrack_hit(hit)
 {
-  debug::ObjectCounter::increase(class_name);
+  debug::ObjectCounter::increase(gCounter);
 }
 
 //______________________________________________________________________________
 TrackHit::~TrackHit( void )
 {
-  debug::ObjectCounter::decrease(class_name);
+  debug::ObjectCounter::decrease(gCounter);
 }
 
 //______________________________________________________________________________
@@ -6,19 +6,53 @@
 
 #include "TrackMaker.hh"
 
+#include <cmath>
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
 
 #include <std_ostream.hh>
 
+#include "DCGeomMan.hh"
+#include "DCGeomRecord.hh"
 #include "DCLocalTrack.hh"
 #include "DCLTrackHit.hh"
 #include "DCPairHitCluster.hh"
+#include "MathTools.hh"
 
 namespace
 {
   const std::string& class_name("TrackMaker");
+  const DCGeomMan& gGeom = DCGeomMan::GetInstance();
+  // below this pivot (relative to the diagonal) the branch is not
+  // constrained yet and is not cut
+  const double SingularPivot = 1.e-12;
+  // rounding of the chi-square from the sums
+  const double ChiSquareTolerance = 1.e-9;
+
+  //____________________________________________________________________________
+  inline int
+  Index( int i, int j )
+  {
+    // upper triangle of a 4x4 matrix, i<=j
+    static const int index[4][4] = { { 0, 1, 2, 3 },
+				     { 1, 4, 5, 6 },
+				     { 2, 5, 7, 8 },
+				     { 3, 6, 8, 9 } };
+    return index[i][j];
+  }
+}
+
+//______________________________________________________________________________
+TrackMaker::NormalSum&
+TrackMaker::NormalSum::operator +=( const NormalSum& other )
+{
+  for( int i=0; i<10; ++i ) m[i] += other.m[i];
+  for( int i=0; i<4; ++i )  b[i] += other.b[i];
+  ss     += other.ss;
+  nhit   += other.nhit;
+  linear  = linear && other.linear;
+  return *this;
 }
 
 //______________________________________________________________________________
@@ -33,7 +67,12 @@ TrackMaker::TrackMaker( const std::vector<ClusterList>& candCont,
     m_nCombi(0),
     m_maxChiSquare(maxChiSquare),
     m_maxCombi(maxCombi),
-    m_minNumOfHits(minNumOfHits)
+    m_minNumOfHits(minNumOfHits),
+    m_maxNumOfCluster(-1),
+    m_isTruncated(false),
+    m_sum(),
+    m_maxBelow(),
+    m_index()
 {
 }
 
@@ -48,27 +87,65 @@ TrackMaker::MakeTracks( std::vector<DCLocalTrack*>& trackList )
 {
   static const std::string funcname("["+class_name+"::"+__func__+"]");
 
-  std::vector<int> nCombi(m_npp);
-  for( int i=0; i<static_cast<int>(m_npp); ++i ){
-    nCombi[i] = m_candidates[i].size();
-  }
+  const NormalSum zero = { {}, {}, 0., 0, true };
+
+  m_sum.assign( m_npp, std::vector<NormalSum>() );
+  m_maxBelow.assign( m_npp+1, 0 );
+  m_index.assign( m_npp, -1 );
+  m_nCombi      = 0;
+  m_isTruncated = false;
 
-  std::vector< std::vector<int> >
-    CombiIndex = MakeIndex( m_npp, nCombi );
-  const std::size_t nnCombi = CombiIndex.size();
-
-  for( std::size_t i=0; i<nnCombi; ++i ){
-    DCLocalTrack *track = MakeOneTrack( m_candidates, CombiIndex[i] );
-    if( !track ) continue;
-    if( track->GetNHit()>=m_minNumOfHits
-	&& track->DoFit()
-	&& track->GetChiSquare()<m_maxChiSquare ){
-      trackList.push_back(track);
+  for( std::size_t i=0; i<m_npp; ++i ){
+    const ClusterList& cand = m_candidates[i];
+    int maxHit = 0;
+    if( m_maxNumOfCluster<0 ||
+	static_cast<int>(cand.size())<=m_maxNumOfCluster ){
+      m_sum[i].assign( cand.size(), zero );
+      for( std::size_t j=0, n=cand.size(); j<n; ++j ){
+	const DCPairHitCluster* cluster = cand[j];
+	if( !cluster ) continue;
+	NormalSum& sum = m_sum[i][j];
+	for( int k=0, nh=cluster->NumberOfHits(); k<nh; ++k ){
+	  const DCLTrackHit* hitp = cluster->GetHit(k);
+	  if( !hitp ) continue;
+	  const DCGeomRecord* record = gGeom.GetRecord( hitp->GetLayer() );
+	  if( !record ){
+	    hddaq::cerr << funcname << ": No record. Layer#="
+			<< hitp->GetLayer() << std::endl;
+	    continue;
+	  }
+	  const double w    = record->Weight();
+	  const double tilt = hitp->GetTiltAngle();
+	  const double aa   = tilt*math::Deg2Rad();
+	  const bool   geom = ( tilt==record->TiltAngle() );
+	  const double ct   = geom ? record->CosTilt() : std::cos(aa);
+	  const double st   = geom ? record->SinTilt() : std::sin(aa);
+	  const double z    = hitp->GetZ();
+	  const double s    = hitp->GetLocalHitPos();
+	  const double a[4] = { ct, z*ct, st, z*st };
+	  for( int p=0; p<4; ++p ){
+	    for( int q=p; q<4; ++q )
+	      sum.m[Index(p,q)] += w*a[p]*a[q];
+	    sum.b[p] += w*s*a[p];
+	  }
+	  sum.ss += w*s*s;
+	  ++sum.nhit;
+	  sum.linear = sum.linear && !hitp->IsHoneycomb();
+	}
+	if( sum.nhit>maxHit ) maxHit = sum.nhit;
+      }
     }
-    else
-      delete track;
+    m_maxBelow[i+1] = m_maxBelow[i] + maxHit;
   }
 
+  if( m_npp>0 )
+    Search( m_npp-1, zero, trackList );
+
+#if 0
+  if( m_isTruncated )
+    hddaq::cout << funcname << " too much combinations..." << std::endl;
+#endif
+
   return;
 }
 
@@ -85,52 +162,40 @@ TrackMaker::IsGood( const DCLocalTrack* track ) const
 }
 
 //______________________________________________________________________________
-std::vector<TrackMaker::IndexList>
-TrackMaker::MakeIndex( int ndim, const int *index1 )
+// true if no track of this branch, with at most maxHit hits, can pass
+// the chi-square cut
+bool
+TrackMaker::IsHopeless( const NormalSum& sum, int maxHit ) const
 {
-  static const std::string func_name("["+class_name+"::"+__func__+"()]");
+  if( !sum.linear || sum.nhit<=4 || maxHit<=4 )
+    return false;
 
-  if( ndim==1 ){
-    std::vector<IndexList> index2;
-    for( int i=-1; i<index1[0]; ++i ){
-      IndexList elem(1,i);
-      index2.push_back(elem);
+  // Cholesky decomposition, M = L L^T
+  double l[4][4] = {};
+  for( int j=0; j<4; ++j ){
+    double d = sum.m[Index(j,j)];
+    for( int k=0; k<j; ++k ) d -= l[j][k]*l[j][k];
+    if( !( d>SingularPivot*sum.m[Index(j,j)] ) )
+      return false;
+    l[j][j] = std::sqrt(d);
+    for( int i=j+1; i<4; ++i ){
+      double e = sum.m[Index(j,i)];
+      for( int k=0; k<j; ++k ) e -= l[i][k]*l[j][k];
+      l[i][j] = e/l[j][j];
     }
-    return index2;
   }
-
-  std::vector< std::vector<int> >
-    index2 = MakeIndex( ndim-1, index1+1 );
-
-  std::vector< std::vector<int> > index;
-  int n2=index2.size();
-  for( int j=0; j<n2; ++j ){
-    for( int i=-1; i<index1[0]; ++i ){
-      IndexList elem;
-      int n3=index2[j].size();
-      elem.reserve(n3+1);
-      elem.push_back(i);
-      for( int k=0; k<n3; ++k )
-	elem.push_back(index2[j][k]);
-      index.push_back(elem);
-      int size1=index.size();
-      if( size1>m_maxCombi ){
-#if 0
-	hddaq::cout << func_name << " too much combinations..." << std::endl;
-#endif
-	return std::vector<IndexList>();
-      }
-    }
+  // chi2 = ss - b^T M^-1 b = ss - |L^-1 b|^2
+  double y[4];
+  double chisqr = sum.ss;
+  for( int i=0; i<4; ++i ){
+    double e = sum.b[i];
+    for( int k=0; k<i; ++k ) e -= l[i][k]*y[k];
+    y[i] = e/l[i][i];
+    chisqr -= y[i]*y[i];
   }
 
-  return index;
-}
-
-//______________________________________________________________________________
-std::vector<TrackMaker::IndexList>
-TrackMaker::MakeIndex( int ndim, const IndexList& index1 )
-{
-  return MakeIndex( ndim, &(index1[0]) );
+  return chisqr >
+    m_maxChiSquare*(maxHit-4) + ChiSquareTolerance*sum.ss;
 }
 
 //______________________________________________________________________________
@@ -161,3 +226,45 @@ TrackMaker::MakeOneTrack( const std::vector<ClusterList>& CandCont,
   }
   return tp;
 }
+
+//______________________________________________________________________________
+// chooses the cluster of plane, -1 (none) first, then the lower planes
+void
+TrackMaker::Search( int plane, const NormalSum& sum,
+		    std::vector<DCLocalTrack*>& trackList )
+{
+  if( m_isTruncated )
+    return;
+
+  if( plane<0 ){
+    if( sum.nhit<m_minNumOfHits )
+      return;
+    if( ++m_nCombi>m_maxCombi ){
+      m_isTruncated = true;
+      return;
+    }
+    DCLocalTrack *track = MakeOneTrack( m_candidates, m_index );
+    if( IsGood( track ) )
+      trackList.push_back( track );
+    else
+      delete track;
+    return;
+  }
+
+  const int maxHit = sum.nhit + m_maxBelow[plane];
+  if( maxHit>=m_minNumOfHits )
+    Search( plane-1, sum, trackList );
+
+  for( std::size_t j=0, n=m_sum[plane].size(); j<n; ++j ){
+    const NormalSum& add = m_sum[plane][j];
+    if( add.nhit==0 || maxHit+add.nhit<m_minNumOfHits )
+      continue;
+    NormalSum next = sum;
+    next += add;
+    if( IsHopeless( next, maxHit+add.nhit ) )
+      continue;
+    m_index[plane] = j;
+    Search( plane-1, next, trackList );
+  }
+  m_index[plane] = -1;
+}
@@ -34,8 +34,10 @@
 #include "HodoAnalyzer.hh"
 #include "HodoParamMan.hh"
 #include "HodoPHCMan.hh"
+#include "KuramaFitCache.hh"
 #include "MacroBuilder.hh"
 #include "RawData.hh"
+#include "TaskPool.hh"
 #include "UserParamMan.hh"
 
 #define BH2FILTER 1
@@ -75,6 +77,9 @@ process_begin( const std::vector<std::string>& argv )
   gConfMan.InitializeParameter<EventDisplay>();
   if( !gConfMan.IsGood() ) return -1;
 
+  TaskPool::GetInstance().ParseOption( argv );
+  KuramaFitCache::ParseOption( argv );
+
   gBH2Filter.Print();
   // gBH2Filter.SetVerbose();
 
@@ -33,10 +33,12 @@
 
 #include "ConfMan.hh"
 #include "DetectorID.hh"
+#include "DAQNodeTable.hh"
 #include "DCAnalyzer.hh"
 #include "DCDriftParamMan.hh"
 #include "DCGeomMan.hh"
 #include "DCTdcCalibMan.hh"
+#include "DetectorMonitor.hh"
 #include "EMCParamMan.hh"
 #include "EventAnalyzer.hh"
 #include "FiberCluster.hh"
@@ -69,6 +71,20 @@ auto&       gMatrix   = MatrixParamMan::GetInstance();
       auto& gTpcPad   = TpcPadHelper::GetInstance();
 auto&       gMsT      = MsTParamMan::GetInstance();
 const auto& gUser     = UserParamMan::GetInstance();
+auto&       gMonitor  = DetectorMonitor::GetInstance();
+// raw histograms filled by DetectorMonitor
+const DetectorMonitor::Spec MonitorSpec[] = {
+  { "BH1", kBH1, NumOfSegBH1, kUorD, DetectorMonitor::kHodoscope,
+    "fpga_leading", "BH1_TDC" },
+  { "BH2", kBH2, NumOfSegBH2, kUorD, DetectorMonitor::kHodoscope,
+    "fpga_leading", "BH2_TDC" },
+  { "BVH", kBVH, NumOfSegBVH, 1,     DetectorMonitor::kTdcCounter,
+    "tdc", "BVH_TDC" },
+  { "TOF", kTOF, NumOfSegTOF, kUorD, DetectorMonitor::kHodoscope,
+    "fpga_leading", "TOF_TDC" },
+  { "BAC", kBAC, NumOfSegBAC, 1,     DetectorMonitor::kCounter,
+    "tdc", "BAC_TDC" },
+};
 }
 
 namespace analyzer
@@ -138,6 +154,8 @@ process_begin( const std::vector<std::string>& argv )
   // gHttp.Register(gHist.createMatrix());
 
   if(0 != gHist.setHistPtr(hptr_array)){ return -1; }
+  for(const auto& spec : MonitorSpec)
+    gMonitor.Add(spec);
 
   //___ Macro for HttpServer
   gHttp.Register(http::BH1ADC());
@@ -313,23 +331,8 @@ process_event( void )
   { ///// DAQ
     //___ node id
     static const Int_t k_eb = gUnpacker.get_fe_id("k18eb");
-    std::vector<Int_t> vme_fe_id;
-    std::vector<Int_t> hul_fe_id;
-    std::vector<Int_t> ea0c_fe_id;
-    std::vector<Int_t> cobo_fe_id;
-    for(auto&& c : gUnpacker.get_root()->get_child_list()){
-      if(!c.second) continue;
-      TString n = c.second->get_name();
-      auto id = c.second->get_id();
-      if(n.Contains("vme"))
-	vme_fe_id.push_back(id);
-      if(n.Contains("hul"))
-	hul_fe_id.push_back(id);
-      if(n.Contains("easiroc"))
-	ea0c_fe_id.push_back(id);
-      if(n.Contains("cobo"))
-	cobo_fe_id.push_back(id);
-    }
+    DAQNodeTable& node_table = DAQNodeTable::GetInstance();
+    node_table.Update();
 
     //___ sequential id
     static const Int_t eb_hid = gHist.getSequentialID(kDAQ, kEB, kHitPat);
@@ -344,32 +347,19 @@ process_event( void )
     }
 
     { //___ VME
-      for(Int_t i=0, n=vme_fe_id.size(); i<n; ++i){
-	auto data_size = gUnpacker.get_node_header(vme_fe_id[i], DAQNode::k_data_size);
-        hptr_array[vme_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kVME, hptr_array[vme_hid]);
     }
 
     { // EASIROC & VMEEASIROC node
-      for(Int_t i=0, n=ea0c_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(ea0c_fe_id[i], DAQNode::k_data_size);
-        hptr_array[ea0c_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kEASIROC, hptr_array[ea0c_hid]);
     }
 
     { //___ HUL node
-      for(Int_t i=0, n=hul_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(hul_fe_id[i], DAQNode::k_data_size);
-        hptr_array[hul_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kHUL, hptr_array[hul_hid]);
     }
 
     { //___ CoBo node
-      for(Int_t i=0, n=cobo_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(cobo_fe_id[i], DAQNode::k_data_size);
-        hptr_array[cobo_hid]->Fill(i, data_size);
-	cobo_data_size += data_size;
-      }
+      cobo_data_size += node_table.FillDataSize(gUnpacker, DAQNodeTable::kCoBo, hptr_array[cobo_hid]);
     }
   }
 
@@ -445,57 +435,8 @@ process_event( void )
 
   std::vector<Int_t> hitseg_bh1;
   { ///// BH1
-    static const auto device_id = gUnpacker.get_device_id("BH1");
-    static const auto adc_id = gUnpacker.get_data_id("BH1", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("BH1", "fpga_leading");
-    static const auto tdc_min = gUser.GetParameter("BH1_TDC", 0);
-    static const auto tdc_max = gUser.GetParameter("BH1_TDC", 1);
-    static const auto adc_hid = gHist.getSequentialID(kBH1, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kBH1, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kBH1, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBH1, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBH1, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegBH1);
-    UInt_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBH1; ++seg){
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<kUorD; ++ud){
-	hit_flag[seg][ud] = 0;
-	///// ADC
-	UInt_t adc = 0;
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	if(nhit != 0){
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + seg + ud*NumOfSegBH1]->Fill(adc);
-	}
-	///// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m){
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if(tdc != 0){
-	    hptr_array[tdc_hid + seg + ud*NumOfSegBH1]->Fill(tdc);
-	    // ADC wTDC
-	    if( tdc > tdc_min && tdc < tdc_max && adc > 0 ){
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if(hit_flag[seg][ud] == 1){
-	  hptr_array[awt_hid + seg + ud*NumOfSegBH1]->Fill(adc);
-	}
-      }
-      if(hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1){
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_bh1.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BH1");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_bh1);
   }// BH1
 
 #if DEBUG
@@ -825,54 +766,8 @@ process_event( void )
 
   std::vector<Int_t> hitseg_bh2;
   { ///// BH2
-    static const auto device_id = gUnpacker.get_device_id("BH2");
-    static const auto adc_id = gUnpacker.get_data_id("BH2", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("BH2", "fpga_leading");
-    static const auto tdc_min = gUser.GetParameter("BH2_TDC", 0);
-    static const auto tdc_max = gUser.GetParameter("BH2_TDC", 1);
-    static const auto adc_hid = gHist.getSequentialID(kBH2, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kBH2, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kBH2, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBH2, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBH2, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegBH2);
-    UInt_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBH2; ++seg){
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<2; ++ud){
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	UInt_t adc = 0;
-	if(nhit != 0){
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + seg + ud*NumOfSegBH2]->Fill(adc);
-	}
-	// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m){
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if(tdc != 0){
-	    hptr_array[tdc_hid + seg + ud*NumOfSegBH2]->Fill(tdc);
-	    if(tdc_min < tdc && tdc < tdc_max && adc > 0){
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if(hit_flag[seg][ud] == 1){
-	  hptr_array[awt_hid + seg + ud*NumOfSegBH2]->Fill(adc);
-	}
-      }
-      if(hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1){
-	  ++multiplicity;
-	  hptr_array[hit_hid]->Fill(seg);
-	  hitseg_bh2.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BH2");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_bh2);
   }
 
 #if DEBUG
@@ -1538,34 +1433,8 @@ process_event( void )
 
   std::vector<Int_t> hitseg_bvh;
   { ///// BVH
-    static const auto k_device = gUnpacker.get_device_id("BVH");
-    static const auto k_tdc    = gUnpacker.get_data_id("BVH", "tdc");
-    static const auto tdc_hid = gHist.getSequentialID(kBVH, 0, kTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBVH, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBVH, 0, kMulti);
-    static const auto tdc_min = gUser.GetParameter("BVH_TDC", 0);
-    static const auto tdc_max = gUser.GetParameter("BVH_TDC", 1);
-    Int_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBVH; ++seg){
-      Bool_t is_in_gate = false;
-      for(Int_t m=0, n=gUnpacker.get_entries(k_device, 0, seg, kU, k_tdc);
-	  m<n; ++m){
-	auto tdc = gUnpacker.get(k_device, 0, seg, kU, k_tdc, m);
-	hptr_array[tdc_hid + seg]->Fill(tdc);
-	if(tdc_min < tdc && tdc < tdc_max) is_in_gate = true;
-      }
-      if(is_in_gate){
-	hptr_array[hit_hid]->Fill(seg);
-	++multiplicity;
-	hitseg_bvh.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BVH");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_bvh);
   }
 
 #if DEBUG
@@ -1574,56 +1443,8 @@ process_event( void )
 
   std::vector<Int_t> hitseg_tof;
   { ///// TOF
-    static const auto device_id = gUnpacker.get_device_id("TOF");
-    static const auto adc_id = gUnpacker.get_data_id("TOF", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("TOF", "fpga_leading");
-    static const auto tdc_min = gUser.GetParameter("TOF_TDC", 0);
-    static const auto tdc_max = gUser.GetParameter("TOF_TDC", 1);
-    static const auto adc_hid = gHist.getSequentialID(kTOF, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kTOF, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kTOF, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kTOF, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kTOF, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegTOF);
-    Int_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegTOF; ++seg){
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<kUorD; ++ud){
-	hit_flag[seg][ud] = 0;
-	// ADC
-	UInt_t adc = 0;
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	if(nhit != 0){
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + ud*NumOfSegTOF + seg]->Fill(adc);
-	}
-	// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m){
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if(tdc != 0){
-	    hptr_array[tdc_hid + ud*NumOfSegTOF + seg]->Fill(tdc);
-	    if(tdc_min<tdc && tdc<tdc_max && adc > 0){
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-        if(hit_flag[seg][ud] == 1){
-          hptr_array[awt_hid + ud*NumOfSegTOF + seg]->Fill(adc);
-        }
-      }
-      if(hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1){
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_tof.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TOF");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_tof);
   }
 
 #if DEBUG
@@ -2015,53 +1836,9 @@ process_event( void )
 
   // BAC -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("BAC");
-    static const Int_t k_adc    = gUnpacker.get_data_id("BAC","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("BAC","tdc");
-    static const Int_t baca_id   = gHist.getSequentialID(kBAC, 0, kADC);
-    static const Int_t bact_id   = gHist.getSequentialID(kBAC, 0, kTDC);
-    static const Int_t bacawt_id = gHist.getSequentialID(kBAC, 0, kADCwTDC);
-    static const Int_t bach_id   = gHist.getSequentialID(kBAC, 0, kHitPat);
-    static const Int_t bacm_id   = gHist.getSequentialID(kBAC, 0, kMulti);
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("BAC_TDC", 0);
-    static const Int_t tdc_max = gUser.GetParameter("BAC_TDC", 1);
-    Int_t multiplicity = 0;
-    for(Int_t seg = 0; seg<NumOfSegBAC; ++seg){
-      // ADC
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-      if( nhit_a!=0 ){
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	hptr_array[baca_id + seg]->Fill( adc );
-      }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-      for(Int_t m = 0; m<nhit_t; ++m){
-	Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-	hptr_array[bact_id + seg]->Fill( tdc );
-	if(tdc_min < tdc && tdc < tdc_max){
-	  is_in_gate = true;
-	}// tdc range is ok
-      }// for(m)
-      if( is_in_gate ){
-	// ADC w/TDC
-	if( gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0 ){
-	  Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	  hptr_array[bacawt_id + seg]->Fill( adc );
-	}
-	hptr_array[bach_id]->Fill(seg);
-	++multiplicity;
-      }// flag is OK
-    }
-
-    hptr_array[bacm_id]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BAC");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg);
   }//BAC
 
   { ///// TPC
@@ -2106,77 +1883,77 @@ process_event( void )
       Int_t max_tb  = -1;
       Int_t max_pad = -1;
       Int_t cluster_size[42] = {0};
-      for( Int_t layer=0; layer<NumOfLayersTPC; ++layer ){
-	for( Int_t ch=0; ch<272; ++ch ){
-	  Int_t pad = gTpcPad.GetPadId( layer, ch );
-	  if( pad < 0 ) continue;
-	  Int_t nhit = gUnpacker.get_entries( k_device, layer, 0, ch, k_adc );
-	  // if( nhit == 0 ){
-	  if( nhit != NumOfTimeBucket ){
-	    // hptr_array[tpca2d_id]->SetBinContent( pad + 1, 0 );
-	    // hptr_array[tpca2d_id+1]->SetBinContent( pad + 1, 0 );
-	    // hptr_array[tpca2d_id+2]->SetBinContent( pad + 1, 0 );
-	    continue;
-	  }
-	  std::vector<Double_t> fadc( nhit );
-	  for( Int_t i=0; i<nhit; ++i ){
-	    Int_t adc = gUnpacker.get( k_device, layer, 0, ch, k_adc, i );
-	    fadc[i] = adc;
-	    if( max_adc < adc && nhit == NumOfTimeBucket ){
-	      max_adc = adc;
-	      max_tb  = i;
-	      max_pad = pad;
-	    }
+      for( const auto& param : gTpcPad.GetPadList() ){
+	Int_t layer = param->LayerId();
+	Int_t ch = param->RowId();
+	Int_t pad = param->PadId();
+	Int_t nhit = gUnpacker.get_entries( k_device, layer, 0, ch, k_adc );
+	// if( nhit == 0 ){
+	if( nhit != NumOfTimeBucket ){
+	  // hptr_array[tpca2d_id]->SetBinContent( pad + 1, 0 );
+	  // hptr_array[tpca2d_id+1]->SetBinContent( pad + 1, 0 );
+	  // hptr_array[tpca2d_id+2]->SetBinContent( pad + 1, 0 );
+	  continue;
+	}
+	std::vector<Double_t> fadc( nhit );
+	for( Int_t i=0; i<nhit; ++i ){
+	  Int_t adc = gUnpacker.get( k_device, layer, 0, ch, k_adc, i );
+	  fadc[i] = adc;
+	  if( max_adc < adc && nhit == NumOfTimeBucket ){
+	    max_adc = adc;
+	    max_tb  = i;
+	    max_pad = pad;
 	  }
-	  if( max_pad == pad ){
-	    max_fadc = fadc;
+	}
+	if( max_pad == pad ){
+	  max_fadc = fadc;
+	}
+	Double_t mean = TMath::Mean( nhit, fadc.data() );
+	Double_t rms = TMath::RMS( nhit, fadc.data() );
+	Double_t max_adc = TMath::MaxElement( nhit, fadc.data() );
+	Int_t loc_max = TMath::LocMax( nhit, fadc.data() );
+	if( max_adc - mean <= 0 ) continue;
+	Int_t aget = param->AGetId();
+	Int_t asad = param->AsAdId();
+	hptr_array[agetmul_id]->Fill( asad*4+aget );
+	hptr_array[tpca_id]->Fill( max_adc - mean );
+	hptr_array[rms_id]->Fill( rms );
+	hptr_array[tpct_id]->Fill( loc_max );
+	hptr_array[tpca2d_id]->SetBinContent( pad + 1, max_adc - mean );
+	hptr_array[tpca2d_id+1]->SetBinContent( pad + 1, rms );
+	hptr_array[tpca2d_id+2]->SetBinContent( pad + 1, loc_max );
+	TVector3 pad_pos = gTpcPad.GetPoint( pad );
+	Double_t pad_z = pad_pos.Z();
+	Double_t pad_x = pad_pos.X();
+	//Double_t pad_y = (max_tb+6)*4.-312;
+	if( max_adc - mean > 0 ){
+	  if(max_adc-mean>300 && max_tb>35 && max_tb<155)
+	    hptr_array[tpca2d_id+3]->Fill( pad_z, pad_x );
+	 // hptr_array[tpczy_id]->Fill( pad_z, pad_y );
+	 // hptr_array[tpcxy_id]->Fill( pad_x, pad_y );
+	  hptr_array[tpczy_id]->Fill( pad_z, max_tb );
+	  hptr_array[tpcxy_id]->Fill( pad_x, max_tb );
+	  hptr_array[tpczy_id+2]->Fill( pad_z, max_tb );
+	  hptr_array[tpcxy_id+2]->Fill( pad_x, max_tb );
+	  ++n_active_pad;
+	  if( max_tb >= 60 && max_tb < 100
+	      && pad_z >= -153-40 && pad_z <= -153
+	      && max_adc - mean > 300
+	      ){
+	    hptr_array[tpcbp_id]->Fill( pad_x );
 	  }
-	  Double_t mean = TMath::Mean( nhit, fadc.data() );
-	  Double_t rms = TMath::RMS( nhit, fadc.data() );
-	  Double_t max_adc = TMath::MaxElement( nhit, fadc.data() );
-	  Int_t loc_max = TMath::LocMax( nhit, fadc.data() );
-	  if( max_adc - mean <= 0 ) continue;
-	  Int_t aget = gTpcPad.GetParam( layer, ch )->AGetId();
-	  Int_t asad = gTpcPad.GetParam( layer, ch )->AsAdId();
-	  hptr_array[agetmul_id]->Fill( asad*4+aget );
-	  hptr_array[tpca_id]->Fill( max_adc - mean );
-	  hptr_array[rms_id]->Fill( rms );
-	  hptr_array[tpct_id]->Fill( loc_max );
-	  hptr_array[tpca2d_id]->SetBinContent( pad + 1, max_adc - mean );
-	  hptr_array[tpca2d_id+1]->SetBinContent( pad + 1, rms );
-	  hptr_array[tpca2d_id+2]->SetBinContent( pad + 1, loc_max );
-	  Double_t pad_z = gTpcPad.GetPoint( pad ).Z();
-	  Double_t pad_x = gTpcPad.GetPoint( pad ).X();
-	  //Double_t pad_y = (max_tb+6)*4.-312;
-	  if( max_adc - mean > 0 ){
-            if(max_adc-mean>300 && max_tb>35 && max_tb<155)
-              hptr_array[tpca2d_id+3]->Fill( pad_z, pad_x );
-	   // hptr_array[tpczy_id]->Fill( pad_z, pad_y );
-	   // hptr_array[tpcxy_id]->Fill( pad_x, pad_y );
-	    hptr_array[tpczy_id]->Fill( pad_z, max_tb );
-	    hptr_array[tpcxy_id]->Fill( pad_x, max_tb );
-	    hptr_array[tpczy_id+2]->Fill( pad_z, max_tb );
-	    hptr_array[tpcxy_id+2]->Fill( pad_x, max_tb );
-	    ++n_active_pad;
-	    if( max_tb >= 60 && max_tb < 100
-   		&& pad_z >= -153-40 && pad_z <= -153
-		&& max_adc - mean > 300
-		){
-              hptr_array[tpcbp_id]->Fill( pad_x );
-	    }
 
-	    if( max_tb >= 70 && max_tb < 85 ){
-	      if( layer < 10 && pad_z < -143 ){
-		  cluster_size[-layer-1+10]++;
-	      } else {
-		cluster_size[layer+10]++;
-	      }
+	  if( max_tb >= 70 && max_tb < 85 ){
+	    if( layer < 10 && pad_z < -143 ){
+		cluster_size[-layer-1+10]++;
+	    } else {
+	      cluster_size[layer+10]++;
 	    }
-
-	    //for( Int_t i=0; i<34; ++i ){
-	    //  if( tpcbp_padid[i] == pad ) hptr_array[tpcbp_id]->Fill( i );
-	    //}
 	  }
+
+	  //for( Int_t i=0; i<34; ++i ){
+	  //  if( tpcbp_padid[i] == pad ) hptr_array[tpcbp_id]->Fill( i );
+	  //}
 	}
       }
 	hptr_array[amulmax_id]->Fill( hptr_array[agetmul_id]->GetMaximum() );
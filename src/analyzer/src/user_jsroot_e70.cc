@@ -4,6 +4,7 @@
 #include <iostream>
 #include <iterator>
 #include <fstream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -34,10 +35,12 @@
 #include "AftHelper.hh"
 #include "ConfMan.hh"
 #include "DetectorID.hh"
+#include "DAQNodeTable.hh"
 #include "DCAnalyzer.hh"
 #include "DCDriftParamMan.hh"
 #include "DCGeomMan.hh"
 #include "DCTdcCalibMan.hh"
+#include "DetectorMonitor.hh"
 #include "EMCParamMan.hh"
 #include "EventAnalyzer.hh"
 #include "FiberCluster.hh"
@@ -48,6 +51,7 @@
 #include "HodoPHCMan.hh"
 #include "HodoRawHit.hh"
 #include "HttpServer.hh"
+#include "JsRootUpdater.hh"
 #include "MacroBuilder.hh"
 #include "MatrixParamMan.hh"
 #include "MsTParamMan.hh"
@@ -70,6 +74,57 @@ auto&       gMatrix   = MatrixParamMan::GetInstance();
 const auto& gAftHelper = AftHelper::GetInstance();
 auto&       gMsT      = MsTParamMan::GetInstance();
 const auto& gUser     = UserParamMan::GetInstance();
+auto&       gMonitor  = DetectorMonitor::GetInstance();
+// raw histograms filled by DetectorMonitor
+const DetectorMonitor::Spec MonitorSpec[] = {
+  { "BH1",    kBH1,    NumOfSegBH1,    kUorD, DetectorMonitor::kHodoscope },
+  { "BH2",    kBH2,    NumOfSegBH2,    kUorD, DetectorMonitor::kHodoscope },
+  { "TOF",    kTOF,    NumOfSegTOF,    kUorD, DetectorMonitor::kHodoscope },
+  { "BAC",    kBAC,    NumOfSegBAC,    1, DetectorMonitor::kCounter },
+  { "T1",     kT1,     NumOfSegT1,     1,
+    DetectorMonitor::kFillTDC|DetectorMonitor::kFillMulti },
+  { "T2",     kT2,     NumOfSegT2,     1,
+    DetectorMonitor::kFillTDC|DetectorMonitor::kFillMulti },
+  { "TF_TF",  kTF_TF,  NumOfSegTF_TF,  1,
+    DetectorMonitor::kFillADC|DetectorMonitor::kFillTDC },
+  { "TF_GN1", kTF_GN1, NumOfSegTF_GN1, 1, DetectorMonitor::kFillTDC },
+  { "TF_GN2", kTF_GN2, NumOfSegTF_GN2, 1, DetectorMonitor::kFillTDC },
+};
+
+// tag summary built by the event loop, published by UpdateTag()
+std::mutex  g_tag_mutex;
+std::string g_tag;
+Bool_t      g_tag_is_new = false;
+
+//____________________________________________________________________________
+// run by the JSROOT publisher after each snapshot
+void
+UpdateTag(void)
+{
+  std::string tag;
+  {
+    std::lock_guard<std::mutex> lock(g_tag_mutex);
+    if(!g_tag_is_new) return;
+    tag.swap(g_tag);
+    g_tag_is_new = false;
+  }
+  gHttp.SetItemField("/Tag", "value", tag.c_str());
+}
+
+//____________________________________________________________________________
+// run by the JSROOT publisher after each snapshot
+void
+UpdateEfficiency(void)
+{
+  auto prev_level = gErrorIgnoreLevel;
+  gErrorIgnoreLevel = kError;
+  http::UpdateBcOutEfficiency();
+  http::UpdateSdcInOutEfficiency();
+  // http::UpdateT0PeakFitting();
+  http::UpdateTOTPeakFitting();
+  http::UpdateAFTEfficiency();
+  gErrorIgnoreLevel = prev_level;
+}
 }
 
 namespace analyzer
@@ -140,6 +195,8 @@ process_begin(const std::vector<std::string>& argv)
   // gHttp.Register(gHist.createMatrix());
 
   if(0 != gHist.setHistPtr(hptr_array)){ return -1; }
+  for(const auto& spec : MonitorSpec)
+    gMonitor.Add(spec);
 
   //___ Macro for HttpServer
   gHttp.Register(http::BH1ADC());
@@ -212,6 +269,12 @@ process_begin(const std::vector<std::string>& argv)
     hptr_array[i]->SetDirectory(0);
   }
 
+  // the event loop fills private copies, the publisher serves snapshots
+  auto& gJsRoot = analyzer::JsRootUpdater::getInstance();
+  gJsRoot.setHistBuffer(hptr_array);
+  gJsRoot.addTask(UpdateEfficiency);
+  gJsRoot.addTask(UpdateTag);
+
   return 0;
 }
 
@@ -264,7 +327,9 @@ process_event(void)
 	ss << Form("Failed to read %s", tout.Data());
       }
       ss << "</div>";
-      gHttp.SetItemField("/Tag", "value", ss.str().c_str());
+      std::lock_guard<std::mutex> lock(g_tag_mutex);
+      g_tag = ss.str();
+      g_tag_is_new = true;
     }
   }
 
@@ -326,23 +391,8 @@ process_event(void)
   { ///// DAQ
     //___ node id
     static const Int_t k_eb = gUnpacker.get_fe_id("k18eb");
-    std::vector<Int_t> vme_fe_id;
-    std::vector<Int_t> hul_fe_id;
-    std::vector<Int_t> ea0c_fe_id;
-    std::vector<Int_t> vea0c_fe_id;
-    for(auto&& c : gUnpacker.get_root()->get_child_list()){
-      if(!c.second) continue;
-      TString n = c.second->get_name();
-      auto id = c.second->get_id();
-      if(n.Contains("vme"))
-	vme_fe_id.push_back(id);
-      if(n.Contains("hul"))
-	hul_fe_id.push_back(id);
-      if(n.Contains("easiroc"))
-	ea0c_fe_id.push_back(id);
-      if(n.Contains("aft"))
-	vea0c_fe_id.push_back(id);
-    }
+    DAQNodeTable& node_table = DAQNodeTable::GetInstance();
+    node_table.Update();
 
     //___ sequential id
     static const Int_t eb_hid = gHist.getSequentialID(kDAQ, kEB, kHitPat);
@@ -359,31 +409,19 @@ process_event(void)
     }
 
     { //___ VME
-      for(Int_t i=0, n=vme_fe_id.size(); i<n; ++i){
-	auto data_size = gUnpacker.get_node_header(vme_fe_id[i], DAQNode::k_data_size);
-        hptr_array[vme_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kVME, hptr_array[vme_hid]);
     }
 
     { // EASIROC
-      for(Int_t i=0, n=ea0c_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(ea0c_fe_id[i], DAQNode::k_data_size);
-        hptr_array[ea0c_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kEASIROC, hptr_array[ea0c_hid]);
     }
 
     { //___ HUL node
-      for(Int_t i=0, n=hul_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(hul_fe_id[i], DAQNode::k_data_size);
-        hptr_array[hul_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kHUL, hptr_array[hul_hid]);
     }
 
     { //___ VMEEASIROC node
-      for(Int_t i=0, n=vea0c_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(vea0c_fe_id[i], DAQNode::k_data_size);
-        hptr_array[vea0c_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kAFT, hptr_array[vea0c_hid]);
     }
     { //___ MultiHitTdc
       { // BC3
@@ -441,57 +479,8 @@ process_event(void)
 
   std::vector<Int_t> hitseg_bh1;
   { ///// BH1
-    static const auto device_id = gUnpacker.get_device_id("BH1");
-    static const auto adc_id = gUnpacker.get_data_id("BH1", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("BH1", "tdc");
-    static const auto tdc_min = gUser.GetParameter("TdcBH1", 0);
-    static const auto tdc_max = gUser.GetParameter("TdcBH1", 1);
-    static const auto adc_hid = gHist.getSequentialID(kBH1, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kBH1, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kBH1, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBH1, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBH1, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegBH1);
-    UInt_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBH1; ++seg) {
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<kUorD; ++ud) {
-	hit_flag[seg][ud] = 0;
-	///// ADC
-	UInt_t adc = 0;
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	if (nhit != 0) {
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + seg + ud*NumOfSegBH1]->Fill(adc);
-	}
-	///// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m) {
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if (tdc != 0) {
-	    hptr_array[tdc_hid + seg + ud*NumOfSegBH1]->Fill(tdc);
-	    // ADC wTDC
-	    if (tdc > tdc_min && tdc < tdc_max && adc > 0) {
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if (hit_flag[seg][ud] == 1) {
-	  hptr_array[awt_hid + seg + ud*NumOfSegBH1]->Fill(adc);
-	}
-      }
-      if (hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1) {
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_bh1.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BH1");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_bh1);
   }// BH1
 
 #if DEBUG
@@ -822,54 +811,8 @@ process_event(void)
 
   std::vector<Int_t> hitseg_bh2;
   { ///// BH2
-    static const auto device_id = gUnpacker.get_device_id("BH2");
-    static const auto adc_id = gUnpacker.get_data_id("BH2", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("BH2", "tdc");
-    static const auto tdc_min = gUser.GetParameter("TdcBH2", 0);
-    static const auto tdc_max = gUser.GetParameter("TdcBH2", 1);
-    static const auto adc_hid = gHist.getSequentialID(kBH2, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kBH2, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kBH2, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBH2, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBH2, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegBH2);
-    UInt_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBH2; ++seg) {
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<2; ++ud) {
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	UInt_t adc = 0;
-	if (nhit != 0) {
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + seg + ud*NumOfSegBH2]->Fill(adc);
-	}
-	// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m) {
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if (tdc != 0) {
-	    hptr_array[tdc_hid + seg + ud*NumOfSegBH2]->Fill(tdc);
-	    if (tdc_min < tdc && tdc < tdc_max && adc > 0) {
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if (hit_flag[seg][ud] == 1) {
-	  hptr_array[awt_hid + seg + ud*NumOfSegBH2]->Fill(adc);
-	}
-      }
-      if (hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1) {
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_bh2.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BH2");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_bh2);
   }
 
 #if DEBUG
@@ -1725,56 +1668,8 @@ process_event(void)
 
   std::vector<Int_t> hitseg_tof;
   { ///// TOF
-    static const auto device_id = gUnpacker.get_device_id("TOF");
-    static const auto adc_id = gUnpacker.get_data_id("TOF", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("TOF", "tdc");
-    static const auto tdc_min = gUser.GetParameter("TdcTOF", 0);
-    static const auto tdc_max = gUser.GetParameter("TdcTOF", 1);
-    static const auto adc_hid = gHist.getSequentialID(kTOF, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kTOF, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kTOF, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kTOF, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kTOF, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegTOF);
-    Int_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegTOF; ++seg) {
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<kUorD; ++ud) {
-	hit_flag[seg][ud] = 0;
-	// ADC
-	UInt_t adc = 0;
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	if (nhit != 0) {
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + ud*NumOfSegTOF + seg]->Fill(adc);
-	}
-	// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m) {
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if (tdc != 0) {
-	    hptr_array[tdc_hid + ud*NumOfSegTOF + seg]->Fill(tdc);
-	    if (tdc_min<tdc && tdc<tdc_max && adc > 0) {
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if (hit_flag[seg][ud] == 1) {
-	  hptr_array[awt_hid + ud*NumOfSegTOF + seg]->Fill(adc);
-	}
-      }
-      if (hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1) {
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_tof.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TOF");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_tof);
   }
 
 #if DEBUG
@@ -2393,112 +2288,17 @@ process_event(void)
 
   // BAC -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("BAC");
-    static const Int_t k_adc    = gUnpacker.get_data_id("BAC","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("BAC","tdc");
-
-    // sequential id
-    /*
-      static const Int_t baca_id   = gHist.getSequentialID(kBAC, 0, kADC,     2);
-      static const Int_t bact_id   = gHist.getSequentialID(kBAC, 0, kTDC,     2);
-      static const Int_t bacawt_id = gHist.getSequentialID(kBAC, 0, kADCwTDC, 2);
-      static const Int_t bach_id   = gHist.getSequentialID(kBAC, 0, kHitPat,  1);
-      static const Int_t bacm_id   = gHist.getSequentialID(kBAC, 0, kMulti,   1);
-    */
-
-    static const Int_t baca_id   = gHist.getSequentialID(kBAC, 0, kADC);
-    static const Int_t bact_id   = gHist.getSequentialID(kBAC, 0, kTDC);
-    static const Int_t bacawt_id = gHist.getSequentialID(kBAC, 0, kADCwTDC);
-    static const Int_t bach_id   = gHist.getSequentialID(kBAC, 0, kHitPat);
-    static const Int_t bacm_id   = gHist.getSequentialID(kBAC, 0, kMulti);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcBAC", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcBAC", 1);
-
-    Int_t multiplicity = 0;
-    for(Int_t seg = 0; seg<NumOfSegBAC; ++seg) {
-      // ADC
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-      if (nhit_a!=0) {
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	hptr_array[baca_id + seg]->Fill(adc);
-      }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m) {
-	Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-	hptr_array[bact_id + seg]->Fill(tdc);
-
-	if (tdc_min < tdc && tdc < tdc_max) {
-	  is_in_gate = true;
-	}// tdc range is ok
-      }// for(m)
-
-      if (is_in_gate) {
-	// ADC w/TDC
-	if (gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0) {
-	  Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	  hptr_array[bacawt_id + seg]->Fill(adc);
-	}
-	hptr_array[bach_id]->Fill(seg);
-	++multiplicity;
-      }// flag is OK
-    }
-
-    hptr_array[bacm_id]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BAC");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg);
   }//BAC
 
 
   // TF_TF  -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("TF_TF");
-    static const Int_t k_adc    = gUnpacker.get_data_id("TF_TF","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("TF_TF","tdc");
-
-    static const Int_t a_id   = gHist.getSequentialID(kTF_TF, 0, kADC);
-    static const Int_t t_id   = gHist.getSequentialID(kTF_TF, 0, kTDC);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcTF_TF", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcTF_TF", 1);
-
-    for(Int_t seg = 0; seg<NumOfSegTF_TF; ++seg) {
-      // ADC
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-      if (nhit_a!=0) {
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	hptr_array[a_id + seg]->Fill(adc);
-      }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m) {
-        Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-        hptr_array[t_id + seg]->Fill(tdc);
-
-        if (tdc_min < tdc && tdc < tdc_max) {
-          is_in_gate = true;
-        }// tdc range is ok
-      }// for(m)
-
-    }
-
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TF_TF");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg);
   }//TF_TF
 
 #if DEBUG
@@ -2508,45 +2308,9 @@ process_event(void)
 
   // TF_GN1  -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("TF_GN1");
-    //static const Int_t k_adc    = gUnpacker.get_data_id("TF_GN1","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("TF_GN1","tdc");
-
-    //static const Int_t a_id   = gHist.getSequentialID(kTF_GN1, 0, kADC);
-    static const Int_t t_id   = gHist.getSequentialID(kTF_GN1, 0, kTDC);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcTF_GN1", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcTF_GN1", 1);
-
-    for(Int_t seg = 0; seg<NumOfSegTF_GN1; ++seg) {
-      // ADC
-    //  Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-    //  if (nhit_a!=0) {
-    //    Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-    //    hptr_array[a_id + seg]->Fill(adc);
-    //  }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m) {
-        Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-        hptr_array[t_id + seg]->Fill(tdc);
-
-        if (tdc_min < tdc && tdc < tdc_max) {
-          is_in_gate = true;
-        }// tdc range is ok
-      }// for(m)
-
-    }
-
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TF_GN1");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg);
   }//TF_GN1
 
 #if DEBUG
@@ -2556,45 +2320,9 @@ process_event(void)
 
   // TF_GN2  -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("TF_GN2");
-    //static const Int_t k_adc    = gUnpacker.get_data_id("TF_GN2","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("TF_GN2","tdc");
-
-    //static const Int_t a_id   = gHist.getSequentialID(kTF_GN2, 0, kADC);
-    static const Int_t t_id   = gHist.getSequentialID(kTF_GN2, 0, kTDC);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcTF_GN2", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcTF_GN2", 1);
-
-    for(Int_t seg = 0; seg<NumOfSegTF_GN2; ++seg) {
-      // ADC
-    //  Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-    //  if (nhit_a!=0) {
-    //    Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-    //    hptr_array[a_id + seg]->Fill(adc);
-    //  }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m) {
-        Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-        hptr_array[t_id + seg]->Fill(tdc);
-
-        if (tdc_min < tdc && tdc < tdc_max) {
-          is_in_gate = true;
-        }// tdc range is ok
-      }// for(m)
-
-    }
-
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TF_GN2");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg);
   }//TF_GN2
 
 #if DEBUG
@@ -2613,65 +2341,15 @@ process_event(void)
   Bool_t is_BH2_fired = false;
   // T1 -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("T1");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("T1","tdc");
-
-    // sequential id
-    static const Int_t t_id   = gHist.getSequentialID(kT1, 0, kTDC);
-    static const Int_t m_id   = gHist.getSequentialID(kT1, 0, kMulti);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcT1", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcT1", 1);
-
-    Int_t multiplicity = 0;
-    Int_t seg = 0;
-    // TDC
-    auto nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-
-    for(Int_t m = 0; m<nhit_t; ++m) {
-      Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-      hptr_array[t_id + seg]->Fill(tdc);
-      if (tdc_min < tdc && tdc < tdc_max) {
-	is_T1_fired = true;
-      }// tdc range is ok
-    }// for(m)
-    if (is_T1_fired) {
-      ++multiplicity;
-    }
-    hptr_array[m_id]->Fill(multiplicity);
+    static const auto index = gMonitor.GetIndex("T1");
+    std::vector<Int_t> hitseg;
+    is_T1_fired = (gMonitor.Fill(index, gUnpacker, hptr_array, hitseg) > 0);
   }//T1
   // T2 -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("T2");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("T2","tdc");
-
-    // sequential id
-    static const Int_t t_id   = gHist.getSequentialID(kT2, 0, kTDC);
-    static const Int_t m_id   = gHist.getSequentialID(kT2, 0, kMulti);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcT2", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcT2", 1);
-
-    Int_t multiplicity = 0;
-    Int_t seg = 0;
-    // TDC
-    auto nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-
-    for(Int_t m = 0; m<nhit_t; ++m) {
-      Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-      hptr_array[t_id + seg]->Fill(tdc);
-      if (tdc_min < tdc && tdc < tdc_max) {
-	is_T2_fired = true;
-      }// tdc range is ok
-    }// for(m)
-    if (is_T2_fired) {
-      ++multiplicity;
-    }
-    hptr_array[m_id]->Fill(multiplicity);
+    static const auto index = gMonitor.GetIndex("T2");
+    std::vector<Int_t> hitseg;
+    is_T2_fired = (gMonitor.Fill(index, gUnpacker, hptr_array, hitseg) > 0);
   }//T2
 
   // E42BH2  -----------------------------------------------------------
@@ -3204,18 +2882,6 @@ process_event(void)
   std::cout << __FILE__ << " " << __LINE__ << std::endl;
 #endif
 
-  // Update
-  if(gUnpacker.get_counter()%100 == 0){
-    auto prev_level = gErrorIgnoreLevel;
-    gErrorIgnoreLevel = kError;
-    http::UpdateBcOutEfficiency();
-    http::UpdateSdcInOutEfficiency();
-    // http::UpdateT0PeakFitting();
-    http::UpdateTOTPeakFitting();
-    http::UpdateAFTEfficiency();
-    gErrorIgnoreLevel = prev_level;
-  }
-
   // if(!gUnpacker.is_good()){
   //   std::cout << "[Warning] Tag is not good." << std::endl;
   //   static const TString host(gSystem->Getenv("HOSTNAME"));
@@ -3229,8 +2895,6 @@ process_event(void)
   //   prev_time = curr_time;
   // }
 
-  gSystem->ProcessEvents();
-
   return 0;
 }
 
@@ -0,0 +1,249 @@
+// -*- C++ -*-
+
+// KuramaTrack::DoFit() with the fixed and the adaptive step of RK::Trace()
+// on the same SdcIn x SdcOut pairs of a recorded run. The fit time, the
+// iterations and the difference of the results are summed per thread
+// and added up at process_end().
+
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <UnpackerManager.hh>
+
+#include "user_analyzer.hh"
+
+#include "BH2Filter.hh"
+#include "ConfMan.hh"
+#include "DCAnalyzer.hh"
+#include "DCDriftParamMan.hh"
+#include "DCGeomMan.hh"
+#include "DCLocalTrack.hh"
+#include "DCTdcCalibMan.hh"
+#include "EventAnalyzer.hh"
+#include "FieldMan.hh"
+#include "HodoParamMan.hh"
+#include "HodoPHCMan.hh"
+#include "KuramaTrack.hh"
+#include "RungeKuttaUtilities.hh"
+#include "TaskPool.hh"
+#include "UserParamMan.hh"
+
+namespace analyzer
+{
+  using namespace hddaq::unpacker;
+  using namespace hddaq;
+
+  namespace
+  {
+    const int NMode = 2;
+    const RK::EStepMode Mode[NMode]     = { RK::kFixedStep, RK::kAdaptiveStep };
+    const char*         ModeName[NMode] = { "Fixed", "Adaptive" };
+
+    struct BenchSum
+    {
+      long   nfit;
+      long   npassed;
+      long   niteration;
+      double time;     // [ns]
+      double max_time;
+    };
+
+    struct BenchStat
+    {
+      BenchSum sum[NMode];
+      long     npair;
+      long     nboth;
+      double   sum_dp;      // |p_adaptive - p_fixed|/p_fixed
+      double   max_dp;
+      double   sum_dchisqr;
+      double   max_dchisqr;
+
+      void Add( const BenchStat& other );
+    };
+
+    // one per filling thread, added up at process_end()
+    std::mutex                              gStatMutex;
+    std::vector<std::unique_ptr<BenchStat>> gStatList;
+
+    //__________________________________________________________________________
+    void
+    BenchStat::Add( const BenchStat& other )
+    {
+      for( int m=0; m<NMode; ++m ){
+	sum[m].nfit       += other.sum[m].nfit;
+	sum[m].npassed    += other.sum[m].npassed;
+	sum[m].niteration += other.sum[m].niteration;
+	sum[m].time       += other.sum[m].time;
+	if( other.sum[m].max_time>sum[m].max_time )
+	  sum[m].max_time = other.sum[m].max_time;
+      }
+      npair       += other.npair;
+      nboth       += other.nboth;
+      sum_dp      += other.sum_dp;
+      sum_dchisqr += other.sum_dchisqr;
+      if( other.max_dp>max_dp )           max_dp      = other.max_dp;
+      if( other.max_dchisqr>max_dchisqr ) max_dchisqr = other.max_dchisqr;
+    }
+
+    //__________________________________________________________________________
+    BenchStat&
+    ThreadStat( void )
+    {
+      thread_local BenchStat* stat = 0;
+      if( !stat ){
+	std::lock_guard<std::mutex> lock( gStatMutex );
+	gStatList.emplace_back( new BenchStat() );
+	stat = gStatList.back().get();
+      }
+      return *stat;
+    }
+
+    //__________________________________________________________________________
+    inline double
+    Now( void )
+    {
+      ::timespec t;
+      ::clock_gettime( CLOCK_MONOTONIC, &t );
+      return t.tv_sec*1.e9 + t.tv_nsec;
+    }
+  }
+
+//____________________________________________________________________________
+int
+process_begin( const std::vector<std::string>& argv )
+{
+  ConfMan& gConfMan = ConfMan::GetInstance();
+  gConfMan.Initialize(argv);
+  gConfMan.InitializeParameter<BH2Filter>("BH2FLT");
+  gConfMan.InitializeParameter<DCGeomMan>("DCGEOM");
+  gConfMan.InitializeParameter<DCTdcCalibMan>("TDCCALIB");
+  gConfMan.InitializeParameter<DCDriftParamMan>("DRFTPM");
+  gConfMan.InitializeParameter<HodoParamMan>("HDPRM");
+  gConfMan.InitializeParameter<HodoPHCMan>("HDPHC");
+  gConfMan.InitializeParameter<FieldMan>("KURAMA");
+  gConfMan.InitializeParameter<UserParamMan>("USER");
+  if( !gConfMan.IsGood() ) return -1;
+
+  TaskPool::GetInstance().ParseOption( argv );
+
+  return 0;
+}
+
+//____________________________________________________________________________
+int
+process_end( void )
+{
+  BenchStat total = {};
+  {
+    std::lock_guard<std::mutex> lock( gStatMutex );
+    for( const auto& stat : gStatList )
+      total.Add( *stat );
+  }
+  const BenchSum* sum = total.sum;
+
+  std::cout << "#D kurama_bench " << total.npair << " pairs" << std::endl
+	    << "   " << std::left << std::setw(10) << "Step"
+	    << std::right << std::setw(10) << "Fit"
+	    << std::setw(10) << "Passed"
+	    << std::setw(12) << "Iteration"
+	    << std::setw(14) << "Mean [us]"
+	    << std::setw(14) << "Max [us]" << std::endl;
+  for( int m=0; m<NMode; ++m ){
+    const BenchSum& s = sum[m];
+    const double n = s.nfit>0 ? s.nfit : 1.;
+    std::cout << "   " << std::left << std::setw(10) << ModeName[m]
+	      << std::right << std::setw(10) << s.nfit
+	      << std::setw(10) << s.npassed
+	      << std::setw(12) << std::fixed << std::setprecision(2)
+	      << s.niteration/n
+	      << std::setw(14) << s.time/n*1.e-3
+	      << std::setw(14) << s.max_time*1.e-3 << std::endl;
+  }
+  if( sum[1].time>0. )
+    std::cout << "   speed-up : " << sum[0].time/sum[1].time << std::endl;
+  if( total.nboth>0 )
+    std::cout << "   both passed " << total.nboth << std::endl
+	      << std::scientific << std::setprecision(3)
+	      << "   dp/p     mean " << total.sum_dp/total.nboth
+	      << " max " << total.max_dp << std::endl
+	      << "   dchisqr  mean " << total.sum_dchisqr/total.nboth
+	      << " max " << total.max_dchisqr << std::endl;
+  return 0;
+}
+
+//____________________________________________________________________________
+int
+process_event( void )
+{
+  EventAnalyzer event;
+  event.DecodeRawData();
+  event.DecodeDCAnalyzer();
+  event.DecodeHodoAnalyzer();
+  event.ApplyBH2Filter();
+  event.TrackSearchSdcIn();
+  event.TrackSearchSdcOut();
+
+  BenchStat& stat = ThreadStat();
+  const DCAnalyzer* const dcAna = event.GetDCAnalyzer();
+  const int nIn  = dcAna->GetNtracksSdcIn();
+  const int nOut = dcAna->GetNtracksSdcOut();
+  for( int iIn=0; iIn<nIn; ++iIn ){
+    DCLocalTrack *trIn = dcAna->GetTrackSdcIn( iIn );
+    if( !trIn->GoodForTracking() ) continue;
+    for( int iOut=0; iOut<nOut; ++iOut ){
+      DCLocalTrack *trOut = dcAna->GetTrackSdcOut( iOut );
+      if( !trOut->GoodForTracking() ) continue;
+      ++stat.npair;
+
+      // initial momentum as DCAnalyzer::TrackSearchKurama()
+      const double bending = trOut->GetU0() - trIn->GetU0();
+      const double p[3] = { 0.08493, 0.2227, 0.01572 };
+      double initial_momentum = p[0] + p[1]/( bending-p[2] );
+      if( !( bending>0. && initial_momentum>0. ) )
+	initial_momentum = 1.;
+
+      bool   passed[NMode] = {};
+      double mom[NMode]    = {};
+      double chisqr[NMode] = {};
+      for( int m=0; m<NMode; ++m ){
+	RK::SetStepMode( Mode[m] );
+	KuramaTrack track( trIn, trOut );
+	track.SetInitialMomentum( initial_momentum );
+	const double start = Now();
+	passed[m] = track.DoFit();
+	const double time = Now() - start;
+	BenchSum& s = stat.sum[m];
+	++s.nfit;
+	s.time += time;
+	if( time>s.max_time ) s.max_time = time;
+	s.niteration += track.Niteration();
+	if( passed[m] ){
+	  ++s.npassed;
+	  mom[m]    = track.PrimaryMomMag();
+	  chisqr[m] = track.chisqr();
+	}
+      }
+      if( passed[0] && passed[1] && mom[0]>0. ){
+	const double dp = std::abs( mom[1]-mom[0] )/mom[0];
+	const double dc = std::abs( chisqr[1]-chisqr[0] );
+	++stat.nboth;
+	stat.sum_dp      += dp;
+	stat.sum_dchisqr += dc;
+	if( dp>stat.max_dp )      stat.max_dp      = dp;
+	if( dc>stat.max_dchisqr ) stat.max_dchisqr = dc;
+      }
+    }
+  }
+
+  RK::SetStepMode( RK::kAdaptiveStep );
+
+  return 0;
+}
+
+}
@@ -0,0 +1,94 @@
+// -*- C++ -*-
+
+// Kurama tracks of a recorded run printed with the exact bits of the
+// fitted values, one line per track. script/kurama_determinism runs it
+// with 1 and N fit threads and compares the outputs, which must be
+// identical.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <UnpackerManager.hh>
+
+#include "user_analyzer.hh"
+
+#include "BH2Filter.hh"
+#include "ConfMan.hh"
+#include "DCAnalyzer.hh"
+#include "DCDriftParamMan.hh"
+#include "DCGeomMan.hh"
+#include "DCTdcCalibMan.hh"
+#include "EventAnalyzer.hh"
+#include "FieldMan.hh"
+#include "HodoParamMan.hh"
+#include "HodoPHCMan.hh"
+#include "KuramaTrack.hh"
+#include "TaskPool.hh"
+#include "UserParamMan.hh"
+
+namespace analyzer
+{
+  using namespace hddaq::unpacker;
+
+  namespace
+  {
+    const UnpackerManager& gUnpacker = GUnpacker::get_instance();
+  }
+
+//____________________________________________________________________________
+int
+process_begin( const std::vector<std::string>& argv )
+{
+  ConfMan& gConfMan = ConfMan::GetInstance();
+  gConfMan.Initialize(argv);
+  gConfMan.InitializeParameter<BH2Filter>("BH2FLT");
+  gConfMan.InitializeParameter<DCGeomMan>("DCGEOM");
+  gConfMan.InitializeParameter<DCTdcCalibMan>("TDCCALIB");
+  gConfMan.InitializeParameter<DCDriftParamMan>("DRFTPM");
+  gConfMan.InitializeParameter<HodoParamMan>("HDPRM");
+  gConfMan.InitializeParameter<HodoPHCMan>("HDPHC");
+  gConfMan.InitializeParameter<FieldMan>("KURAMA");
+  gConfMan.InitializeParameter<UserParamMan>("USER");
+  if( !gConfMan.IsGood() ) return -1;
+
+  TaskPool::GetInstance().ParseOption( argv );
+
+  return 0;
+}
+
+//____________________________________________________________________________
+int
+process_end( void )
+{
+  return 0;
+}
+
+//____________________________________________________________________________
+int
+process_event( void )
+{
+  EventAnalyzer event;
+  event.DecodeRawData();
+  event.DecodeDCAnalyzer();
+  event.DecodeHodoAnalyzer();
+  event.ApplyBH2Filter();
+  event.TrackSearchSdcIn();
+  event.TrackSearchSdcOut();
+  event.TrackSearchKurama();
+
+  const DCAnalyzer* const dcAna = event.GetDCAnalyzer();
+  const int event_number = gUnpacker.get_event_number();
+  for( int i=0, n=dcAna->GetNTracksKurama(); i<n; ++i ){
+    const KuramaTrack* track = dcAna->GetKuramaTrack( i );
+    const ThreeVector& pos = track->TofPos();
+    std::printf( "TRACK %d %d %d %a %a %a %a %a\n",
+		 event_number, i, track->Niteration(),
+		 track->PrimaryMomMag(), track->chisqr(),
+		 pos.x(), pos.y(), pos.z() );
+  }
+
+  return 0;
+}
+
+}
@@ -22,6 +22,7 @@
 #include "user_analyzer.hh"
 
 #include "ConfMan.hh"
+#include "DAQNodeTable.hh"
 #include "DCDriftParamMan.hh"
 #include "DCGeomMan.hh"
 #include "DCTdcCalibMan.hh"
@@ -294,21 +295,8 @@ process_event( void )
   {
     //___ node id
     static const Int_t k_eb = gUnpacker.get_fe_id( "k18eb" );
-    std::vector<Int_t> vme_fe_id;
-    std::vector<Int_t> hul_fe_id;
-    std::vector<Int_t> ea0c_fe_id;
-    for( auto&& c : gUnpacker.get_root()->get_child_list() ){
-      if( !c.second )
-	continue;
-      TString n = c.second->get_name();
-      auto id = c.second->get_id();
-      if( n.Contains( "vme" ) )
-	vme_fe_id.push_back( id );
-      if( n.Contains( "hul" ) )
-	hul_fe_id.push_back( id );
-      if( n.Contains( "easiroc" ) )
-	ea0c_fe_id.push_back( id );
-    }
+    DAQNodeTable& node_table = DAQNodeTable::GetInstance();
+    node_table.Update();
 
     //___ sequential id
     static const Int_t eb_hid   = gHist.getSequentialID( kDAQ, kEB, kHitPat );
@@ -322,24 +310,15 @@ process_event( void )
     }
 
     { //___ VME
-      for( Int_t i=0, n=vme_fe_id.size(); i<n; ++i ){
-	auto data_size = gUnpacker.get_node_header( vme_fe_id[i], DAQNode::k_data_size );
-        hptr_array[vme_hid]->Fill( i, data_size );
-      }
+      node_table.FillDataSize( gUnpacker, DAQNodeTable::kVME, hptr_array[vme_hid] );
     }
 
     { // EASIROC & VMEEASIROC node
-      for( Int_t i=0, n=ea0c_fe_id.size(); i<n; ++i ){
-        auto data_size = gUnpacker.get_node_header( ea0c_fe_id[i], DAQNode::k_data_size );
-        hptr_array[ea0c_hid]->Fill( i, data_size );
-      }
+      node_table.FillDataSize( gUnpacker, DAQNodeTable::kEASIROC, hptr_array[ea0c_hid] );
     }
 
     { //___ HUL node
-      for( Int_t i=0, n=hul_fe_id.size(); i<n; ++i ){
-        auto data_size = gUnpacker.get_node_header( hul_fe_id[i], DAQNode::k_data_size );
-        hptr_array[hul_hid]->Fill( i, data_size );
-      }
+      node_table.FillDataSize( gUnpacker, DAQNodeTable::kHUL, hptr_array[hul_hid] );
     }
 
     // { //___ Misc node
@@ -22,9 +22,11 @@
 #include "user_analyzer.hh"
 
 #include "ConfMan.hh"
+#include "DAQNodeTable.hh"
 #include "DCDriftParamMan.hh"
 #include "DCGeomMan.hh"
 #include "DCTdcCalibMan.hh"
+#include "DetectorMonitor.hh"
 #include "DetectorID.hh"
 #include "GuiPs.hh"
 #include "HistMaker.hh"
@@ -52,7 +54,21 @@ const auto& gUnpacker = GUnpacker::get_instance();
 const auto& gMatrix   = MatrixParamMan::GetInstance();
       auto& gTpcPad   = TpcPadHelper::GetInstance();
 const auto& gUser     = UserParamMan::GetInstance();
+      auto& gMonitor  = DetectorMonitor::GetInstance();
 std::vector<TH1*> hptr_array;
+// raw histograms filled by DetectorMonitor
+const DetectorMonitor::Spec MonitorSpec[] = {
+  { "BH1", kBH1, NumOfSegBH1, kUorD, DetectorMonitor::kHodoscope,
+    "fpga_leading", "BH1_TDC" },
+  { "BH2", kBH2, NumOfSegBH2, kUorD, DetectorMonitor::kHodoscope,
+    "fpga_leading", "BH2_TDC" },
+  { "BVH", kBVH, NumOfSegBVH, 1,     DetectorMonitor::kTdcCounter,
+    "tdc", "BVH_TDC" },
+  { "TOF", kTOF, NumOfSegTOF, kUorD, DetectorMonitor::kHodoscope,
+    "fpga_leading", "TOF_TDC" },
+  { "BAC", kBAC, NumOfSegBAC, 1,     DetectorMonitor::kCounter,
+    "tdc", "BAC_TDC" },
+};
 Bool_t flag_event_cut = false;
 Int_t event_cut_factor = 1; // for fast semi-online analysis
 }
@@ -170,6 +186,8 @@ process_begin( const std::vector<std::string>& argv )
   // This vector contains both TH1 and TH2.
   // Then you need to do down cast when you use TH2.
   if(0 != gHist.setHistPtr(hptr_array)){ return -1; }
+  for(const auto& spec : MonitorSpec)
+    gMonitor.Add(spec);
 
   // Users don't have to touch this section (Make Ps tab),
   // but the file path should be changed.
@@ -271,23 +289,8 @@ process_event( void )
   { ///// DAQ
     //___ node id
     static const Int_t k_eb = gUnpacker.get_fe_id("k18eb");
-    std::vector<Int_t> vme_fe_id;
-    std::vector<Int_t> hul_fe_id;
-    std::vector<Int_t> ea0c_fe_id;
-    std::vector<Int_t> cobo_fe_id;
-    for(auto&& c : gUnpacker.get_root()->get_child_list()){
-      if(!c.second) continue;
-      TString n = c.second->get_name();
-      auto id = c.second->get_id();
-      if(n.Contains("vme"))
-	vme_fe_id.push_back(id);
-      if(n.Contains("hul"))
-	hul_fe_id.push_back(id);
-      if(n.Contains("easiroc"))
-	ea0c_fe_id.push_back(id);
-      if(n.Contains("cobo"))
-	cobo_fe_id.push_back(id);
-    }
+    DAQNodeTable& node_table = DAQNodeTable::GetInstance();
+    node_table.Update();
 
     //___ sequential id
     static const Int_t eb_hid = gHist.getSequentialID(kDAQ, kEB, kHitPat);
@@ -302,32 +305,19 @@ process_event( void )
     }
 
     { //___ VME
-      for(Int_t i=0, n=vme_fe_id.size(); i<n; ++i){
-	auto data_size = gUnpacker.get_node_header(vme_fe_id[i], DAQNode::k_data_size);
-        hptr_array[vme_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kVME, hptr_array[vme_hid]);
     }
 
     { // EASIROC & VMEEASIROC node
-      for(Int_t i=0, n=ea0c_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(ea0c_fe_id[i], DAQNode::k_data_size);
-        hptr_array[ea0c_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kEASIROC, hptr_array[ea0c_hid]);
     }
 
     { //___ HUL node
-      for(Int_t i=0, n=hul_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(hul_fe_id[i], DAQNode::k_data_size);
-        hptr_array[hul_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(gUnpacker, DAQNodeTable::kHUL, hptr_array[hul_hid]);
     }
 
     { //___ CoBo node
-      for(Int_t i=0, n=cobo_fe_id.size(); i<n; ++i){
-        auto data_size = gUnpacker.get_node_header(cobo_fe_id[i], DAQNode::k_data_size);
-        hptr_array[cobo_hid]->Fill(i, data_size);
-	cobo_data_size += data_size;
-      }
+      cobo_data_size += node_table.FillDataSize(gUnpacker, DAQNodeTable::kCoBo, hptr_array[cobo_hid]);
     }
   }
 
@@ -403,57 +393,8 @@ process_event( void )
 
   std::vector<Int_t> hitseg_bh1;
   { ///// BH1
-    static const auto device_id = gUnpacker.get_device_id("BH1");
-    static const auto adc_id = gUnpacker.get_data_id("BH1", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("BH1", "fpga_leading");
-    static const auto tdc_min = gUser.GetParameter("BH1_TDC", 0);
-    static const auto tdc_max = gUser.GetParameter("BH1_TDC", 1);
-    static const auto adc_hid = gHist.getSequentialID(kBH1, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kBH1, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kBH1, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBH1, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBH1, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegBH1);
-    UInt_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBH1; ++seg){
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<kUorD; ++ud){
-	hit_flag[seg][ud] = 0;
-	///// ADC
-	UInt_t adc = 0;
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	if(nhit != 0){
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + seg + ud*NumOfSegBH1]->Fill(adc);
-	}
-	///// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m){
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if(tdc != 0){
-	    hptr_array[tdc_hid + seg + ud*NumOfSegBH1]->Fill(tdc);
-	    // ADC wTDC
-	    if( tdc > tdc_min && tdc < tdc_max && adc > 0 ){
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if(hit_flag[seg][ud] == 1){
-	  hptr_array[awt_hid + seg + ud*NumOfSegBH1]->Fill(adc);
-	}
-      }
-      if(hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1){
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_bh1.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BH1");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_bh1);
   }// BH1
 
 #if DEBUG
@@ -784,54 +725,8 @@ process_event( void )
 
   std::vector<Int_t> hitseg_bh2;
   { ///// BH2
-    static const auto device_id = gUnpacker.get_device_id("BH2");
-    static const auto adc_id = gUnpacker.get_data_id("BH2", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("BH2", "fpga_leading");
-    static const auto tdc_min = gUser.GetParameter("BH2_TDC", 0);
-    static const auto tdc_max = gUser.GetParameter("BH2_TDC", 1);
-    static const auto adc_hid = gHist.getSequentialID(kBH2, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kBH2, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kBH2, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBH2, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBH2, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegBH2);
-    UInt_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBH2; ++seg){
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<2; ++ud){
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	UInt_t adc = 0;
-	if(nhit != 0){
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + seg + ud*NumOfSegBH2]->Fill(adc);
-	}
-	// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m){
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if(tdc != 0){
-	    hptr_array[tdc_hid + seg + ud*NumOfSegBH2]->Fill(tdc);
-	    if(tdc_min < tdc && tdc < tdc_max && adc > 0){
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if(hit_flag[seg][ud] == 1){
-	  hptr_array[awt_hid + seg + ud*NumOfSegBH2]->Fill(adc);
-	}
-      }
-      if(hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1){
-	  ++multiplicity;
-	  hptr_array[hit_hid]->Fill(seg);
-	  hitseg_bh2.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BH2");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_bh2);
   }
 
 #if DEBUG
@@ -1506,34 +1401,8 @@ process_event( void )
 
   std::vector<Int_t> hitseg_bvh;
   { ///// BVH
-    static const auto device_id = gUnpacker.get_device_id("BVH");
-    static const auto tdc_id    = gUnpacker.get_data_id("BVH", "tdc");
-    static const auto tdc_hid = gHist.getSequentialID(kBVH, 0, kTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBVH, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBVH, 0, kMulti);
-    static const auto tdc_min = gUser.GetParameter("BVH_TDC", 0);
-    static const auto tdc_max = gUser.GetParameter("BVH_TDC", 1);
-    Int_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBVH; ++seg){
-      Bool_t is_in_gate = false;
-      for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, kU, tdc_id);
-	  m<n; ++m){
-	auto tdc = gUnpacker.get(device_id, 0, seg, kU, tdc_id, m);
-	hptr_array[tdc_hid + seg]->Fill(tdc);
-	if(tdc_min < tdc && tdc < tdc_max) is_in_gate = true;
-      }
-      if(is_in_gate){
-	hptr_array[hit_hid]->Fill(seg);
-	++multiplicity;
-	hitseg_bvh.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BVH");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_bvh);
   }
 
 #if DEBUG
@@ -1542,56 +1411,8 @@ process_event( void )
 
   std::vector<Int_t> hitseg_tof;
   { ///// TOF
-    static const auto device_id = gUnpacker.get_device_id("TOF");
-    static const auto adc_id = gUnpacker.get_data_id("TOF", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("TOF", "fpga_leading");
-    static const auto tdc_min = gUser.GetParameter("TOF_TDC", 0);
-    static const auto tdc_max = gUser.GetParameter("TOF_TDC", 1);
-    static const auto adc_hid = gHist.getSequentialID(kTOF, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kTOF, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kTOF, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kTOF, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kTOF, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegTOF);
-    Int_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegTOF; ++seg){
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<kUorD; ++ud){
-	hit_flag[seg][ud] = 0;
-	// ADC
-	UInt_t adc = 0;
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	if(nhit != 0){
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + ud*NumOfSegTOF + seg]->Fill(adc);
-	}
-	// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m){
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if(tdc != 0){
-	    hptr_array[tdc_hid + ud*NumOfSegTOF + seg]->Fill(tdc);
-	    if(tdc_min<tdc && tdc<tdc_max && adc > 0){
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-        if(hit_flag[seg][ud] == 1){
-          hptr_array[awt_hid + ud*NumOfSegTOF + seg]->Fill(adc);
-        }
-      }
-      if(hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1){
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_tof.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TOF");
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg_tof);
   }
 
 #if DEBUG
@@ -1981,68 +1802,9 @@ process_event( void )
 
   // BAC -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("BAC");
-    static const Int_t k_adc    = gUnpacker.get_data_id("BAC","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("BAC","tdc");
-
-    // sequential id
-    /*
-    static const Int_t baca_id   = gHist.getSequentialID(kBAC, 0, kADC,     2);
-    static const Int_t bact_id   = gHist.getSequentialID(kBAC, 0, kTDC,     2);
-    static const Int_t bacawt_id = gHist.getSequentialID(kBAC, 0, kADCwTDC, 2);
-    static const Int_t bach_id   = gHist.getSequentialID(kBAC, 0, kHitPat,  1);
-    static const Int_t bacm_id   = gHist.getSequentialID(kBAC, 0, kMulti,   1);
-    */
-
-    static const Int_t baca_id   = gHist.getSequentialID(kBAC, 0, kADC);
-    static const Int_t bact_id   = gHist.getSequentialID(kBAC, 0, kTDC);
-    static const Int_t bacawt_id = gHist.getSequentialID(kBAC, 0, kADCwTDC);
-    static const Int_t bach_id   = gHist.getSequentialID(kBAC, 0, kHitPat);
-    static const Int_t bacm_id   = gHist.getSequentialID(kBAC, 0, kMulti);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("BAC_TDC", 0);
-    static const Int_t tdc_max = gUser.GetParameter("BAC_TDC", 1);
-
-    Int_t multiplicity = 0;
-    for(Int_t seg = 0; seg<NumOfSegBAC; ++seg){
-      // ADC
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-      if( nhit_a!=0 ){
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	hptr_array[baca_id + seg]->Fill( adc );
-      }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m){
-	Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-	hptr_array[bact_id + seg]->Fill( tdc );
-
-	if(tdc_min < tdc && tdc < tdc_max){
-	  is_in_gate = true;
-	}// tdc range is ok
-      }// for(m)
-
-      if( is_in_gate ){
-	// ADC w/TDC
-	if( gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0 ){
-	  Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	  hptr_array[bacawt_id + seg]->Fill( adc );
-	}
-	hptr_array[bach_id]->Fill(seg);
-	++multiplicity;
-      }// flag is OK
-    }
-
-    hptr_array[bacm_id]->Fill( multiplicity );
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BAC");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, gUnpacker, hptr_array, hitseg);
   }//BAC
 
   return 0;
@@ -2063,39 +1825,38 @@ process_event( void )
 
       // FADC
       Int_t n_active_pad = 0;
-      for( Int_t layer=0; layer<32; ++layer ){
-	for( Int_t ch=0; ch<272; ++ch ){
-	  Int_t pad = gTpcPad.GetPadId( layer, ch );
-	  if( pad < 0 ) continue;
-	  Int_t nhit = gUnpacker.get_entries( k_device, layer, 0, ch, k_adc );
-	  if( nhit == 0 ){
-	    hptr_array[tpca2d_id]->SetBinContent( pad+1, 0 );
-	    hptr_array[tpca2d_id+1]->SetBinContent( pad+1, 0 );
-	    hptr_array[tpca2d_id+2]->SetBinContent( pad+1, 0 );
-	    continue;
-	  }
-	  // if( nhit != 200 ){
-	  //   hddaq::cerr << "#W NumOfTimeBucket is wrong " << nhit << "/200 "
-	  //               << "(layer=" << layer << ", row=" << ch << ", pad="
-	  //               << pad << ")" << std::endl;
-	  // }
-	  std::vector<Double_t> fadc( nhit );
-	  for( Int_t i=0; i<nhit; ++i ){
-	    Int_t adc = gUnpacker.get( k_device, layer, 0, ch, k_adc, i );
-	    fadc[i] = adc;
-	  }
-	  Double_t mean = TMath::Mean( nhit, fadc.data() );
-	  Double_t rms = TMath::RMS( nhit, fadc.data() );
-	  Double_t max_adc = TMath::MaxElement( nhit, fadc.data() );
-	  Int_t loc_max = TMath::LocMax( nhit, fadc.data() );
-	  hptr_array[tpca_id]->Fill( max_adc );
-	  hptr_array[tpct_id]->Fill( loc_max );
-	  hptr_array[rms_id]->Fill( rms );
-	  hptr_array[tpca2d_id]->SetBinContent( pad+1, max_adc - mean );
-	  hptr_array[tpca2d_id+1]->SetBinContent( pad+1, rms );
-	  hptr_array[tpca2d_id+2]->SetBinContent( pad+1, loc_max );
-	  if( max_adc - mean > 0 ) ++n_active_pad;
+      for( const auto& param : gTpcPad.GetPadList() ){
+	Int_t layer = param->LayerId();
+	Int_t ch = param->RowId();
+	Int_t pad = param->PadId();
+	Int_t nhit = gUnpacker.get_entries( k_device, layer, 0, ch, k_adc );
+	if( nhit == 0 ){
+	  hptr_array[tpca2d_id]->SetBinContent( pad+1, 0 );
+	  hptr_array[tpca2d_id+1]->SetBinContent( pad+1, 0 );
+	  hptr_array[tpca2d_id+2]->SetBinContent( pad+1, 0 );
+	  continue;
+	}
+	// if( nhit != 200 ){
+	//   hddaq::cerr << "#W NumOfTimeBucket is wrong " << nhit << "/200 "
+	//               << "(layer=" << layer << ", row=" << ch << ", pad="
+	//               << pad << ")" << std::endl;
+	// }
+	std::vector<Double_t> fadc( nhit );
+	for( Int_t i=0; i<nhit; ++i ){
+	  Int_t adc = gUnpacker.get( k_device, layer, 0, ch, k_adc, i );
+	  fadc[i] = adc;
 	}
+	Double_t mean = TMath::Mean( nhit, fadc.data() );
+	Double_t rms = TMath::RMS( nhit, fadc.data() );
+	Double_t max_adc = TMath::MaxElement( nhit, fadc.data() );
+	Int_t loc_max = TMath::LocMax( nhit, fadc.data() );
+	hptr_array[tpca_id]->Fill( max_adc );
+	hptr_array[tpct_id]->Fill( loc_max );
+	hptr_array[rms_id]->Fill( rms );
+	hptr_array[tpca2d_id]->SetBinContent( pad+1, max_adc - mean );
+	hptr_array[tpca2d_id+1]->SetBinContent( pad+1, rms );
+	hptr_array[tpca2d_id+2]->SetBinContent( pad+1, loc_max );
+	if( max_adc - mean > 0 ) ++n_active_pad;
       }
       // std::cout << "active pad = " << n_active_pad << std::endl;
       hptr_array[tpcmul_id]->Fill( n_active_pad );
@@ -19,13 +19,19 @@
 #include <UnpackerManager.hh>
 
 #include "Controller.hh"
+#include "EventPipeline.hh"
+#include "EventSnapshot.hh"
+#include "HistShard.hh"
+#include "Main.hh"
 #include "user_analyzer.hh"
 
 #include "ConfMan.hh"
+#include "DAQNodeTable.hh"
 #include "DCDriftParamMan.hh"
 #include "DCGeomMan.hh"
 #include "DCTdcCalibMan.hh"
 #include "DetectorID.hh"
+#include "DetectorMonitor.hh"
 #include "GuiPs.hh"
 #include "HistMaker.hh"
 #include "HodoParamMan.hh"
@@ -52,14 +58,49 @@ auto& gHist     = HistMaker::getInstance();
 const auto& gMatrix   = MatrixParamMan::GetInstance();
 auto& gTpcPad   = TpcPadHelper::GetInstance();
 const auto& gUser     = UserParamMan::GetInstance();
+auto& gMonitor  = DetectorMonitor::GetInstance();
 std::vector<TH1*> hptr_array;
-Bool_t flag_event_cut = false;
-Int_t event_cut_factor = 1; // for fast semi-online analysis
+// raw histograms filled by DetectorMonitor
+const DetectorMonitor::Spec MonitorSpec[] = {
+  { "BH1",    kBH1,    NumOfSegBH1,    kUorD, DetectorMonitor::kHodoscope },
+  { "BH2",    kBH2,    NumOfSegBH2,    kUorD, DetectorMonitor::kHodoscope },
+  { "TOF",    kTOF,    NumOfSegTOF,    kUorD, DetectorMonitor::kHodoscope },
+  { "BAC",    kBAC,    NumOfSegBAC,    1, DetectorMonitor::kCounter },
+  { "T1",     kT1,     NumOfSegT1,     1,
+    DetectorMonitor::kFillTDC|DetectorMonitor::kFillMulti },
+  { "T2",     kT2,     NumOfSegT2,     1,
+    DetectorMonitor::kFillTDC|DetectorMonitor::kFillMulti },
+  { "TF_TF",  kTF_TF,  NumOfSegTF_TF,  1,
+    DetectorMonitor::kFillADC|DetectorMonitor::kFillTDC|
+    DetectorMonitor::kFillADCwTDC },
+  { "TF_GN1", kTF_GN1, NumOfSegTF_GN1, 1, DetectorMonitor::kFillTDC },
+  { "TF_GN2", kTF_GN2, NumOfSegTF_GN2, 1, DetectorMonitor::kFillTDC },
+};
 }
 
 namespace analyzer
 {
 
+Int_t process_snapshot(const EventSnapshot& event,
+		       std::vector<HistShard*>& hptr_array);
+
+//____________________________________________________________________________
+// Spill ends carry the scalers, they are never sampled out.
+bool
+is_spill_end()
+{
+  static const Int_t k_device = gUnpacker.get_device_id("TFlag");
+  static const Int_t k_tdc    = gUnpacker.get_data_id("TFlag", "tdc");
+  for (const Int_t seg : { trigger::kSpillOnEnd, trigger::kSpillOffEnd }) {
+    for (Int_t m=0, n=gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
+	 m<n; ++m) {
+      if (gUnpacker.get(k_device, 0, seg, 0, k_tdc, m)>0)
+	return true;
+    }
+  }
+  return false;
+}
+
 //____________________________________________________________________________
 Int_t
 process_begin(const std::vector<std::string>& argv)
@@ -79,13 +120,17 @@ process_begin(const std::vector<std::string>& argv)
   if (!gConfMan.IsGood()) return -1;
   // unpacker and all the parameter managers are initialized at this stage
 
-  if (argv.size()==4) {
-    Int_t factor = std::strtod(argv[3].c_str(), NULL);
-    if (factor!=0) event_cut_factor = std::abs(factor);
-    flag_event_cut = true;
-    std::cout << "#D Event cut flag on : factor="
-	      << event_cut_factor << std::endl;
+  // "auto" adjusts the fraction of events to the worker time,
+  // a number N takes every Nth event while the workers can't keep up
+  if (argv.size()==4 && argv[3]=="auto") {
+    Main::getInstance().setQueuePolicy(EventPipeline::kAdaptive);
+    std::cout << "#D Event sampling on : adaptive" << std::endl;
+  } else if (argv.size()==4) {
+    Int_t factor = std::abs(std::strtod(argv[3].c_str(), NULL));
+    Main::getInstance().setQueuePolicy(EventPipeline::kSample, factor);
+    std::cout << "#D Event sampling on : factor=" << factor << std::endl;
   }
+  Main::getInstance().setEventSelector(is_spill_end);
 
   // Make tabs
   hddaq::gui::Controller& gCon = hddaq::gui::Controller::getInstance();
@@ -184,6 +229,51 @@ process_begin(const std::vector<std::string>& argv)
   // This vector contains both TH1 and TH2.
   // Then you need to do down cast when you use TH2.
   if (0 != gHist.setHistPtr(hptr_array)) { return -1; }
+  for (const auto& spec : MonitorSpec)
+    gMonitor.Add(spec);
+
+  // Digits read by process_snapshot(),
+  // (name, #plane, #segment, #ch, data types read[, hit rows])
+  // the devices of MonitorSpec also keep their hit rows for DetectorMonitor
+  const std::vector<std::string> adc_tdc = { "adc", "tdc" };
+  const std::vector<std::string> tdc     = { "tdc" };
+  const std::vector<std::string> lt      = { "leading", "trailing" };
+  EventSnapshot::registerDevice("TFlag",   1, NumOfSegTFlag, 1, tdc);
+  EventSnapshot::registerDevice("BH1",     1, NumOfSegBH1, kUorD, adc_tdc, true);
+  EventSnapshot::registerDevice("BFT",     NumOfPlaneBFT, NumOfSegBFT, 1, lt);
+  EventSnapshot::registerDevice("BC3",     NumOfLayersBC3, 1, MaxWireBC3, lt);
+  EventSnapshot::registerDevice("BC4",     NumOfLayersBC4, 1, MaxWireBC4, lt);
+  EventSnapshot::registerDevice("BH2",     1, NumOfSegBH2, kUorD, adc_tdc, true);
+  EventSnapshot::registerDevice("BH2MTLR", 1, NumOfSegBH2, 1, tdc);
+  EventSnapshot::registerDevice("BAC",     1, NumOfSegBAC, 1, adc_tdc, true);
+  EventSnapshot::registerDevice("SDC1",    NumOfLayersSDC1, 1, MaxWireSDC1, lt);
+  EventSnapshot::registerDevice("SDC2",    NumOfLayersSDC2, 1, MaxWireSDC2, lt);
+  EventSnapshot::registerDevice("SDC3",    NumOfLayersSDC3, 1, MaxWireSDC3, lt);
+  EventSnapshot::registerDevice("SDC4",    NumOfLayersSDC4, 1, MaxWireSDC4, lt);
+  EventSnapshot::registerDevice("SDC5",    NumOfLayersSDC5, 1, MaxWireSDC5, lt);
+  EventSnapshot::registerDevice("TOF",     1, NumOfSegTOF, kUorD, adc_tdc, true);
+  EventSnapshot::registerDevice("AC1",     1, NumOfSegAC1, 1, adc_tdc);
+  EventSnapshot::registerDevice("SAC3",    1, NumOfSegSAC3, 1, adc_tdc);
+  EventSnapshot::registerDevice("SFV",     1, NumOfSegSFV, 1, adc_tdc);
+  EventSnapshot::registerDevice("WC",      1, NumOfSegWC, 3, adc_tdc);
+  EventSnapshot::registerDevice("TF_TF",   1, NumOfSegTF_TF, 1, adc_tdc, true);
+  EventSnapshot::registerDevice("TF_GN1",  1, NumOfSegTF_GN1, 1, adc_tdc, true);
+  EventSnapshot::registerDevice("TF_GN2",  1, NumOfSegTF_GN2, 1, adc_tdc, true);
+  EventSnapshot::registerDevice("T1",      1, NumOfSegT1, 1, tdc, true);
+  EventSnapshot::registerDevice("T2",      1, NumOfSegT2, 1, tdc, true);
+  EventSnapshot::registerDevice("E42BH2",  1, NumOfSegE42BH2, 3, adc_tdc);
+  EventSnapshot::registerDevice("E72BAC",  1, NumOfSegE72BAC, 1, adc_tdc);
+  EventSnapshot::registerDevice("E90SAC",  1, NumOfSegE90SAC, 1, adc_tdc);
+  EventSnapshot::registerDevice("E72KVC",  1, NumOfSegE72KVC, 3, adc_tdc);
+#if FLAG_DAQ
+  EventSnapshot::registerNodeHeader(DAQNode::k_data_size);
+#endif
+#if TIME_STAMP
+  EventSnapshot::registerNodeHeader(DAQNode::k_unix_time);
+#endif
+  // The event loop calls process_snapshot() on --worker=N threads,
+  // each filling its own shards of hptr_array.
+  Main::getInstance().setEventProcessor(process_snapshot, hptr_array);
 
   // Users don't have to touch this section (Make Ps tab),
   // but the file path should be changed.
@@ -218,16 +308,13 @@ process_end()
 
 //____________________________________________________________________________
 Int_t
-process_event()
+process_snapshot(const EventSnapshot& event,
+		 std::vector<HistShard*>& hptr_array)
 {
 #if DEBUG
   std::cout << __FILE__ << " " << __LINE__ << std::endl;
 #endif
 
-  const Int_t event_number = gUnpacker.get_event_number();
-  if (flag_event_cut && event_number%event_cut_factor!=0)
-    return 0;
-
   // TriggerFlag ---------------------------------------------------
   std::bitset<NumOfSegTFlag> trigger_flag;
   {
@@ -236,9 +323,9 @@ process_event()
     static const Int_t tdc_id   = gHist.getSequentialID(kTriggerFlag, 0, kTDC);
     static const Int_t hit_id   = gHist.getSequentialID(kTriggerFlag, 0, kHitPat);
     for(Int_t seg=0; seg<NumOfSegTFlag; ++seg) {
-      for(Int_t m=0, n=gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
+      for(Int_t m=0, n=event.get_entries(k_device, 0, seg, 0, k_tdc);
 	  m<n; ++m) {
-	auto tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
+	auto tdc = event.get(k_device, 0, seg, 0, k_tdc, m);
 	if (tdc>0) {
 	  trigger_flag.set(seg);
 	  hptr_array[tdc_id+seg]->Fill(tdc);
@@ -269,14 +356,11 @@ process_event()
   // TimeStamp --------------------------------------------------------
   {
     static const auto hist_id = gHist.getSequentialID(kTimeStamp, 0, kTDC);
-    Int_t i = 0;
-    for(auto&& c : gUnpacker.get_root()->get_child_list()) {
-      if (!c.second)
-	continue;
-      auto t = gUnpacker.get_node_header(c.second->get_id(),
-					 DAQNode::k_unix_time);
-      hptr_array[hist_id+i]->Fill(t);
-      ++i;
+    // node 0 is the root node
+    for(Int_t i=1, n=event.get_n_node(); i<n; ++i) {
+      auto t = event.get_node_header(event.get_node_id(i),
+				     DAQNode::k_unix_time);
+      hptr_array[hist_id+i-1]->Fill(t);
     }
   }
 #endif
@@ -284,23 +368,8 @@ process_event()
   { ///// DAQ
     //___ node id
     static const Int_t k_eb = gUnpacker.get_fe_id("k18eb");
-    std::vector<Int_t> vme_fe_id;
-    std::vector<Int_t> hul_fe_id;
-    std::vector<Int_t> ea0c_fe_id;
-    std::vector<Int_t> vea0c_fe_id;
-    for(auto&& c : gUnpacker.get_root()->get_child_list()) {
-      if (!c.second) continue;
-      TString n = c.second->get_name();
-      auto id = c.second->get_id();
-      if (n.Contains("vme"))
-	vme_fe_id.push_back(id);
-      if (n.Contains("hul"))
-	hul_fe_id.push_back(id);
-      if (n.Contains("easiroc"))
-	ea0c_fe_id.push_back(id);
-      if (n.Contains("aft"))
-	vea0c_fe_id.push_back(id);
-    }
+    DAQNodeTable& node_table = DAQNodeTable::GetInstance();
+    node_table.Update(event);
 
     //___ sequential id
     static const Int_t eb_hid = gHist.getSequentialID(kDAQ, kEB, kHitPat);
@@ -312,36 +381,24 @@ process_event()
     Int_t multihit_hid = gHist.getSequentialID(kDAQ, 0, kMultiHitTdc);
 
     { //___ EB
-      auto data_size = gUnpacker.get_node_header(k_eb, DAQNode::k_data_size);
+      auto data_size = event.get_node_header(k_eb, DAQNode::k_data_size);
       hptr_array[eb_hid]->Fill(data_size);
     }
 
     { //___ VME
-      for(Int_t i=0, n=vme_fe_id.size(); i<n; ++i) {
-	auto data_size = gUnpacker.get_node_header(vme_fe_id[i], DAQNode::k_data_size);
-	hptr_array[vme_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(event, DAQNodeTable::kVME, hptr_array[vme_hid]);
     }
 
     { // EASIROC
-      for(Int_t i=0, n=ea0c_fe_id.size(); i<n; ++i) {
-	auto data_size = gUnpacker.get_node_header(ea0c_fe_id[i], DAQNode::k_data_size);
-	hptr_array[ea0c_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(event, DAQNodeTable::kEASIROC, hptr_array[ea0c_hid]);
     }
 
     { //___ HUL node
-      for(Int_t i=0, n=hul_fe_id.size(); i<n; ++i) {
-	auto data_size = gUnpacker.get_node_header(hul_fe_id[i], DAQNode::k_data_size);
-	hptr_array[hul_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(event, DAQNodeTable::kHUL, hptr_array[hul_hid]);
     }
 
     { //___ VMEEASIROC node
-      for(Int_t i=0, n=vea0c_fe_id.size(); i<n; ++i) {
-	auto data_size = gUnpacker.get_node_header(vea0c_fe_id[i], DAQNode::k_data_size);
-	hptr_array[vea0c_hid]->Fill(i, data_size);
-      }
+      node_table.FillDataSize(event, DAQNodeTable::kAFT, hptr_array[vea0c_hid]);
     }
 
     { //___ MultiHitTdc
@@ -350,7 +407,7 @@ process_event()
 	static const Int_t k_leading  = gUnpacker.get_data_id("BC3", "leading");
 	for(Int_t l=0; l<NumOfLayersBC3; ++l) {
 	  for(Int_t w=0; w<NumOfWireBC3; ++w) {
-	    Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
+	    Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
 	    hptr_array[multihit_hid]->Fill(w, nhit_l);
 	  }
 	  ++multihit_hid;
@@ -361,7 +418,7 @@ process_event()
 	static const Int_t k_leading  = gUnpacker.get_data_id("BC4", "leading");
 	for(Int_t l=0; l<NumOfLayersBC4; ++l) {
 	  for(Int_t w=0; w<NumOfWireBC4; ++w) {
-	    Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
+	    Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
 	    hptr_array[multihit_hid]->Fill(w, nhit_l);
 	  }
 	  ++multihit_hid;
@@ -372,7 +429,7 @@ process_event()
 	static const Int_t k_leading  = gUnpacker.get_data_id("SDC1", "leading");
 	for(Int_t l=0; l<NumOfLayersSDC1; ++l) {
 	  for(Int_t w=0; w<NumOfWireSDC1; ++w) {
-	    Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
+	    Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
 	    hptr_array[multihit_hid]->Fill(w, nhit_l);
 	  }
 	  ++multihit_hid;
@@ -383,7 +440,7 @@ process_event()
 	static const Int_t k_leading  = gUnpacker.get_data_id("SDC2", "leading");
 	for(Int_t l=0; l<NumOfLayersSDC2; ++l) {
 	  for(Int_t w=0; w<NumOfWireSDC2; ++w) {
-	    Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
+	    Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
 	    hptr_array[multihit_hid]->Fill(w, nhit_l);
 	  }
 	  ++multihit_hid;
@@ -393,7 +450,7 @@ process_event()
 	static const auto device_id = gUnpacker.get_device_id("BH2MTLR");
 	static const auto tdc_id = gUnpacker.get_data_id("BH2MTLR", "tdc");
 	for(Int_t seg=0; seg<NumOfSegBH2; ++seg) {
-	  Int_t nhit_l = gUnpacker.get_entries(device_id, 0, seg, 0, tdc_id);
+	  Int_t nhit_l = event.get_entries(device_id, 0, seg, 0, tdc_id);
 	  hptr_array[multihit_hid]->Fill(seg, nhit_l);
 	}
 	++multihit_hid;
@@ -401,7 +458,7 @@ process_event()
 
       // { // HUL node overflow
       // 	for(Int_t i=0, n=hul_fe_id.size(); i<n; ++i) {
-      // 	  auto overflow = gUnpacker.get_node_header(hul_fe_id[i], DAQNode::);
+      // 	  auto overflow = event.get_node_header(hul_fe_id[i], DAQNode::);
       // 	  hptr_array[hul_hid]->Fill(i, overflow);
       // 	}
       // }
@@ -417,58 +474,9 @@ process_event()
 
   std::vector<Int_t> hitseg_bh1;
   { ///// BH1
-    static const auto device_id = gUnpacker.get_device_id("BH1");
-    static const auto adc_id = gUnpacker.get_data_id("BH1", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("BH1", "tdc");
-    static const auto tdc_min = gUser.GetParameter("TdcBH1", 0);
-    static const auto tdc_max = gUser.GetParameter("TdcBH1", 1);
-    static const auto adc_hid = gHist.getSequentialID(kBH1, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kBH1, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kBH1, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBH1, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBH1, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegBH1);
-    UInt_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBH1; ++seg) {
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<kUorD; ++ud) {
-	hit_flag[seg][ud] = 0;
-	///// ADC
-	UInt_t adc = 0;
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	if (nhit != 0) {
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + seg + ud*NumOfSegBH1]->Fill(adc);
-	}
-	///// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m) {
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if (tdc != 0) {
-	    hptr_array[tdc_hid + seg + ud*NumOfSegBH1]->Fill(tdc);
-	    // ADC wTDC
-	    if (tdc > tdc_min && tdc < tdc_max && adc > 0) {
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if (hit_flag[seg][ud] == 1) {
-	  hptr_array[awt_hid + seg + ud*NumOfSegBH1]->Fill(adc);
-	}
-      }
-      if (hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1) {
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_bh1.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
-  }// BH1
+    static const auto index = gMonitor.GetIndex("BH1");
+    gMonitor.Fill(index, event, hptr_array, hitseg_bh1);
+  }
 
 #if DEBUG
   std::cout << __FILE__ << " " << __LINE__ << std::endl;
@@ -492,10 +500,10 @@ process_event()
       for(Int_t ud=0; ud<kUorD; ++ud) {
 	UInt_t tdc_prev = 0;
 	Bool_t is_in_range = false;
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, ud, i, 0, leading_id);
+	for(Int_t m=0, n=event.get_entries(device_id, ud, i, 0, leading_id);
 	    m<n; ++m) {
-	  auto tdc = gUnpacker.get(device_id, ud, i, 0, leading_id, m);
-	  auto tdc_t = gUnpacker.get(device_id, ud, i, 0, trailing_id, m);
+	  auto tdc = event.get(device_id, ud, i, 0, leading_id, m);
+	  auto tdc_t = event.get(device_id, ud, i, 0, trailing_id, m);
 	  auto tot = tdc - tdc_t;
 	  if (tdc_prev == tdc || tdc <= 0 || tot <= 0)
 	    continue;
@@ -576,18 +584,18 @@ process_event()
       Int_t multiplicity_ctot    = 0;
       Int_t multiplicity_wt_ctot = 0;
       for(Int_t w=0; w<NumOfWireBC3; ++w) {
-	Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
-	Int_t nhit_t = gUnpacker.get_entries(k_device, l, 0, w, k_trailing);
+	Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
+	Int_t nhit_t = event.get_entries(k_device, l, 0, w, k_trailing);
 	if (nhit_l == 0) continue;
 
 	Int_t hit_l_max = 0;
 	Int_t hit_t_max = 0;
 
 	if (nhit_l != 0) {
-	  hit_l_max = gUnpacker.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
+	  hit_l_max = event.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
 	}
 	if (nhit_t != 0) {
-	  hit_t_max = gUnpacker.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
+	  hit_t_max = event.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
 	}
 
 	// This wire fired at least one times.
@@ -597,7 +605,7 @@ process_event()
 	Bool_t flag_hit_wt = false;
 	Bool_t flag_hit_wt_ctot = false;
 	for(Int_t m = 0; m<nhit_l; ++m) {
-	  tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
+	  tdc = event.get(k_device, l, 0, w, k_leading, m);
 	  hptr_array[bc3t_id + l]->Fill(tdc);
 	  hptr_array[bc3t_wide_id + l]->Fill(tdc); //TDCwide
 	  if (tdc1st<tdc) tdc1st = tdc;
@@ -621,8 +629,8 @@ process_event()
 	if (nhit_l == nhit_t && hit_l_max > hit_t_max) {
 	  ++multiplicity_ctot;
 	  for(Int_t m = 0; m<nhit_l; ++m) {
-	    tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
-	    tdc_t = gUnpacker.get(k_device, l, 0, w, k_trailing, m);
+	    tdc = event.get(k_device, l, 0, w, k_leading, m);
+	    tdc_t = event.get(k_device, l, 0, w, k_trailing, m);
 	    tot = tdc - tdc_t;
 	    hptr_array[bc3tot_id+l]->Fill(tot);
      	    hptr_array[bc3tot2D_id+l]->Fill(w,tot); //2D
@@ -721,18 +729,18 @@ process_event()
       Int_t multiplicity_ctot    = 0;
       Int_t multiplicity_wt_ctot = 0;
       for(Int_t w=0; w<NumOfWireBC4; ++w) {
-	Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
-	Int_t nhit_t = gUnpacker.get_entries(k_device, l, 0, w, k_trailing);
+	Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
+	Int_t nhit_t = event.get_entries(k_device, l, 0, w, k_trailing);
 	if (nhit_l == 0) continue;
 
 	Int_t hit_l_max = 0;
 	Int_t hit_t_max = 0;
 
 	if (nhit_l != 0) {
-	  hit_l_max = gUnpacker.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
+	  hit_l_max = event.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
 	}
 	if (nhit_t != 0) {
-	  hit_t_max = gUnpacker.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
+	  hit_t_max = event.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
 	}
 
 	// This wire fired at least one times.
@@ -742,7 +750,7 @@ process_event()
 	Bool_t flag_hit_wt = false;
 	Bool_t flag_hit_wt_ctot = false;
 	for(Int_t m = 0; m<nhit_l; ++m) {
-	  tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
+	  tdc = event.get(k_device, l, 0, w, k_leading, m);
 	  hptr_array[bc4t_id + l]->Fill(tdc);
 	  hptr_array[bc4t_wide_id + l]->Fill(tdc); //TDCwide
 	  if (tdc1st<tdc) tdc1st = tdc;
@@ -766,8 +774,8 @@ process_event()
 	if (nhit_l == nhit_t && hit_l_max > hit_t_max) {
 	  ++multiplicity_ctot;
 	  for(Int_t m = 0; m<nhit_l; ++m) {
-	    tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
-	    tdc_t = gUnpacker.get(k_device, l, 0, w, k_trailing, m);
+	    tdc = event.get(k_device, l, 0, w, k_leading, m);
+	    tdc_t = event.get(k_device, l, 0, w, k_trailing, m);
 	    tot = tdc - tdc_t;
 	    hptr_array[bc4tot_id+l]->Fill(tot);
 	    hptr_array[bc4tot2D_id+l]->Fill(w,tot); //2D
@@ -818,54 +826,8 @@ process_event()
 
   std::vector<Int_t> hitseg_bh2;
   { ///// BH2
-    static const auto device_id = gUnpacker.get_device_id("BH2");
-    static const auto adc_id = gUnpacker.get_data_id("BH2", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("BH2", "tdc");
-    static const auto tdc_min = gUser.GetParameter("TdcBH2", 0);
-    static const auto tdc_max = gUser.GetParameter("TdcBH2", 1);
-    static const auto adc_hid = gHist.getSequentialID(kBH2, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kBH2, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kBH2, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kBH2, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kBH2, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegBH2);
-    UInt_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegBH2; ++seg) {
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<2; ++ud) {
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	UInt_t adc = 0;
-	if (nhit != 0) {
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + seg + ud*NumOfSegBH2]->Fill(adc);
-	}
-	// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m) {
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if (tdc != 0) {
-	    hptr_array[tdc_hid + seg + ud*NumOfSegBH2]->Fill(tdc);
-	    if (tdc_min < tdc && tdc < tdc_max && adc > 0) {
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if (hit_flag[seg][ud] == 1) {
-	  hptr_array[awt_hid + seg + ud*NumOfSegBH2]->Fill(adc);
-	}
-      }
-      if (hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1) {
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_bh2.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BH2");
+    gMonitor.Fill(index, event, hptr_array, hitseg_bh2);
   }
 
   { // BH2MTLR
@@ -873,9 +835,9 @@ process_event()
     static const auto tdc_id = gUnpacker.get_data_id("BH2MTLR", "tdc");
     static const auto tdc_hid = gHist.getSequentialID(kBH2, 0, kTDC, 20);
     for(Int_t seg=0; seg<NumOfSegBH2; ++seg) {
-      for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, 0, tdc_id);
+      for(Int_t m=0, n=event.get_entries(device_id, 0, seg, 0, tdc_id);
 	  m<n; ++m) {
-	auto tdc = gUnpacker.get(device_id, 0, seg, 0, tdc_id, m);
+	auto tdc = event.get(device_id, 0, seg, 0, tdc_id, m);
 	if (tdc != 0) hptr_array[tdc_hid + seg]->Fill(tdc);
       }
     }
@@ -933,18 +895,18 @@ process_event()
       Int_t multiplicity_ctot    = 0;
       Int_t multiplicity_wt_ctot = 0;
       for(Int_t w=0; w<NumOfWireSDC1; ++w) {
-	Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
-	Int_t nhit_t = gUnpacker.get_entries(k_device, l, 0, w, k_trailing);
+	Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
+	Int_t nhit_t = event.get_entries(k_device, l, 0, w, k_trailing);
 	if (nhit_l == 0) continue;
 
 	Int_t hit_l_max = 0;
 	Int_t hit_t_max = 0;
 
 	if (nhit_l != 0) {
-	  hit_l_max = gUnpacker.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
+	  hit_l_max = event.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
 	}
 	if (nhit_t != 0) {
-	  hit_t_max = gUnpacker.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
+	  hit_t_max = event.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
 	}
 
 	// This wire fired at least one times.
@@ -954,7 +916,7 @@ process_event()
 	Bool_t flag_hit_wt = false;
 	Bool_t flag_hit_wt_ctot = false;
 	for(Int_t m = 0; m<nhit_l; ++m) {
-	  tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
+	  tdc = event.get(k_device, l, 0, w, k_leading, m);
 	  hptr_array[sdc1t_id + l]->Fill(tdc);
 	  hptr_array[sdc1t_wide_id + l]->Fill(tdc); //TDCwide
 	  if (tdc1st<tdc) tdc1st = tdc;
@@ -978,8 +940,8 @@ process_event()
 	if (nhit_l == nhit_t && hit_l_max > hit_t_max) {
 	  ++multiplicity_ctot;
 	  for(Int_t m = 0; m<nhit_l; ++m) {
-	    tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
-	    tdc_t = gUnpacker.get(k_device, l, 0, w, k_trailing, m);
+	    tdc = event.get(k_device, l, 0, w, k_leading, m);
+	    tdc_t = event.get(k_device, l, 0, w, k_trailing, m);
 	    tot = tdc - tdc_t;
 	    hptr_array[sdc1tot_id+l]->Fill(tot);
 	    if (tot < tot_min) continue;
@@ -1080,18 +1042,18 @@ process_event()
       Int_t multiplicity_ctot    = 0;
       Int_t multiplicity_wt_ctot = 0;
       for(Int_t w=0; w<NumOfWireSDC2; ++w) {
-	Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
-	Int_t nhit_t = gUnpacker.get_entries(k_device, l, 0, w, k_trailing);
+	Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
+	Int_t nhit_t = event.get_entries(k_device, l, 0, w, k_trailing);
 	if (nhit_l == 0) continue;
 
 	Int_t hit_l_max = 0;
 	Int_t hit_t_max = 0;
 
 	if (nhit_l != 0) {
-	  hit_l_max = gUnpacker.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
+	  hit_l_max = event.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
 	}
 	if (nhit_t != 0) {
-	  hit_t_max = gUnpacker.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
+	  hit_t_max = event.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
 	}
 
 	// This wire fired at least one times.
@@ -1101,7 +1063,7 @@ process_event()
 	Bool_t flag_hit_wt = false;
 	Bool_t flag_hit_wt_ctot = false;
 	for(Int_t m = 0; m<nhit_l; ++m) {
-	  tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
+	  tdc = event.get(k_device, l, 0, w, k_leading, m);
 	  hptr_array[sdc2t_id + l]->Fill(tdc);
 	  hptr_array[sdc2t_wide_id + l]->Fill(tdc); //TDCwide
 	  if (tdc1st<tdc) tdc1st = tdc;
@@ -1125,8 +1087,8 @@ process_event()
 	if (nhit_l == nhit_t && hit_l_max > hit_t_max) {
 	  ++multiplicity_ctot;
 	  for(Int_t m = 0; m<nhit_l; ++m) {
-	    tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
-	    tdc_t = gUnpacker.get(k_device, l, 0, w, k_trailing, m);
+	    tdc = event.get(k_device, l, 0, w, k_leading, m);
+	    tdc_t = event.get(k_device, l, 0, w, k_trailing, m);
 	    tot = tdc - tdc_t;
 	    hptr_array[sdc2tot_id+l]->Fill(tot);
 	    if (tot < tot_min) continue;
@@ -1239,18 +1201,18 @@ process_event()
       Int_t multiplicity_ctot    = 0;
       Int_t multiplicity_wt_ctot = 0;
       for(Int_t w=0; w<NumOfWireSDC3; ++w) {
-	Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
-	Int_t nhit_t = gUnpacker.get_entries(k_device, l, 0, w, k_trailing);
+	Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
+	Int_t nhit_t = event.get_entries(k_device, l, 0, w, k_trailing);
 	if (nhit_l == 0) continue;
 
 	Int_t hit_l_max = 0;
 	Int_t hit_t_max = 0;
 
 	if (nhit_l != 0) {
-	  hit_l_max = gUnpacker.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
+	  hit_l_max = event.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
 	}
 	if (nhit_t != 0) {
-	  hit_t_max = gUnpacker.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
+	  hit_t_max = event.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
 	}
 
 	// This wire fired at least one times.
@@ -1260,7 +1222,7 @@ process_event()
 	Bool_t flag_hit_wt = false;
 	Bool_t flag_hit_wt_ctot = false;
 	for(Int_t m = 0; m<nhit_l; ++m) {
-	  tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
+	  tdc = event.get(k_device, l, 0, w, k_leading, m);
 	  hptr_array[sdc3t_id + l]->Fill(tdc);
 	  if (tdc1st<tdc) tdc1st = tdc;
 
@@ -1283,8 +1245,8 @@ process_event()
 	if (nhit_l == nhit_t && hit_l_max > hit_t_max) {
 	  ++multiplicity_ctot;
 	  for(Int_t m = 0; m<nhit_l; ++m) {
-	    tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
-	    tdc_t = gUnpacker.get(k_device, l, 0, w, k_trailing, m);
+	    tdc = event.get(k_device, l, 0, w, k_leading, m);
+	    tdc_t = event.get(k_device, l, 0, w, k_trailing, m);
 	    tot = tdc - tdc_t;
 	    hptr_array[sdc3tot_id+l]->Fill(tot);
 	    if (tot < tot_min) continue;
@@ -1380,18 +1342,18 @@ process_event()
       Int_t multiplicity_ctot    = 0;
       Int_t multiplicity_wt_ctot = 0;
       for(Int_t w=0; w<NumOfWireSDC4; ++w) {
-	Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
-	Int_t nhit_t = gUnpacker.get_entries(k_device, l, 0, w, k_trailing);
+	Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
+	Int_t nhit_t = event.get_entries(k_device, l, 0, w, k_trailing);
 	if (nhit_l == 0) continue;
 
 	Int_t hit_l_max = 0;
 	Int_t hit_t_max = 0;
 
 	if (nhit_l != 0) {
-	  hit_l_max = gUnpacker.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
+	  hit_l_max = event.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
 	}
 	if (nhit_t != 0) {
-	  hit_t_max = gUnpacker.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
+	  hit_t_max = event.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
 	}
 
 	// This wire fired at least one times.
@@ -1401,7 +1363,7 @@ process_event()
 	Bool_t flag_hit_wt = false;
 	Bool_t flag_hit_wt_ctot = false;
 	for(Int_t m = 0; m<nhit_l; ++m) {
-	  tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
+	  tdc = event.get(k_device, l, 0, w, k_leading, m);
 	  hptr_array[sdc4t_id + l]->Fill(tdc);
 	  if (tdc1st<tdc) tdc1st = tdc;
 
@@ -1424,8 +1386,8 @@ process_event()
 	if (nhit_l == nhit_t && hit_l_max > hit_t_max) {
 	  ++multiplicity_ctot;
 	  for(Int_t m = 0; m<nhit_l; ++m) {
-	    tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
-	    tdc_t = gUnpacker.get(k_device, l, 0, w, k_trailing, m);
+	    tdc = event.get(k_device, l, 0, w, k_leading, m);
+	    tdc_t = event.get(k_device, l, 0, w, k_trailing, m);
 	    tot = tdc - tdc_t;
 	    hptr_array[sdc4tot_id+l]->Fill(tot);
 	    if (tot < tot_min) continue;
@@ -1528,18 +1490,18 @@ process_event()
 	sdc5_nwire = NumOfWireSDC5X;
 
       for(Int_t w=0; w<sdc5_nwire; ++w) {
-	Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
-	Int_t nhit_t = gUnpacker.get_entries(k_device, l, 0, w, k_trailing);
+	Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
+	Int_t nhit_t = event.get_entries(k_device, l, 0, w, k_trailing);
 	if (nhit_l == 0) continue;
 
 	Int_t hit_l_max = 0;
 	Int_t hit_t_max = 0;
 
 	if (nhit_l != 0) {
-	  hit_l_max = gUnpacker.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
+	  hit_l_max = event.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
 	}
 	if (nhit_t != 0) {
-	  hit_t_max = gUnpacker.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
+	  hit_t_max = event.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
 	}
 
 	// This wire fired at least one times.
@@ -1549,7 +1511,7 @@ process_event()
 	Bool_t flag_hit_wt = false;
 	Bool_t flag_hit_wt_ctot = false;
 	for(Int_t m = 0; m<nhit_l; ++m) {
-	  tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
+	  tdc = event.get(k_device, l, 0, w, k_leading, m);
 	  hptr_array[sdc5t_id + l]->Fill(tdc);
 	  if (tdc1st<tdc) tdc1st = tdc;
 
@@ -1572,8 +1534,8 @@ process_event()
 	if (nhit_l == nhit_t && hit_l_max > hit_t_max) {
 	  ++multiplicity_ctot;
 	  for(Int_t m = 0; m<nhit_l; ++m) {
-	    tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
-	    tdc_t = gUnpacker.get(k_device, l, 0, w, k_trailing, m);
+	    tdc = event.get(k_device, l, 0, w, k_leading, m);
+	    tdc_t = event.get(k_device, l, 0, w, k_trailing, m);
 	    tot = tdc - tdc_t;
 	    hptr_array[sdc5tot_id+l]->Fill(tot);
 	    if (tot < tot_min) continue;
@@ -1675,18 +1637,18 @@ process_event()
 	sdc4_nwire = NumOfWireSDC4X;
 
       for(Int_t w=0; w<sdc4_nwire; ++w) {
-	Int_t nhit_l = gUnpacker.get_entries(k_device, l, 0, w, k_leading);
-	Int_t nhit_t = gUnpacker.get_entries(k_device, l, 0, w, k_trailing);
+	Int_t nhit_l = event.get_entries(k_device, l, 0, w, k_leading);
+	Int_t nhit_t = event.get_entries(k_device, l, 0, w, k_trailing);
 	if (nhit_l == 0) continue;
 
 	Int_t hit_l_max = 0;
 	Int_t hit_t_max = 0;
 
 	if (nhit_l != 0) {
-	  hit_l_max = gUnpacker.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
+	  hit_l_max = event.get(k_device, l, 0, w, k_leading,  nhit_l - 1);
 	}
 	if (nhit_t != 0) {
-	  hit_t_max = gUnpacker.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
+	  hit_t_max = event.get(k_device, l, 0, w, k_trailing, nhit_t - 1);
 	}
 
 	// This wire fired at least one times.
@@ -1696,7 +1658,7 @@ process_event()
 	Bool_t flag_hit_wt = false;
 	Bool_t flag_hit_wt_ctot = false;
 	for(Int_t m = 0; m<nhit_l; ++m) {
-	  tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
+	  tdc = event.get(k_device, l, 0, w, k_leading, m);
 	  hptr_array[sdc4t_id + l]->Fill(tdc);
 	  if (tdc1st<tdc) tdc1st = tdc;
 
@@ -1716,8 +1678,8 @@ process_event()
 	if (nhit_l == nhit_t && hit_l_max > hit_t_max) {
 	  ++multiplicity_ctot;
 	  for(Int_t m = 0; m<nhit_l; ++m) {
-	    tdc = gUnpacker.get(k_device, l, 0, w, k_leading, m);
-	    tdc_t = gUnpacker.get(k_device, l, 0, w, k_trailing, m);
+	    tdc = event.get(k_device, l, 0, w, k_leading, m);
+	    tdc_t = event.get(k_device, l, 0, w, k_trailing, m);
 	    tot = tdc - tdc_t;
 	    hptr_array[sdc4tot_id+l]->Fill(tot);
 	    if (tot < tot_min || tot >tot_max) continue;
@@ -1768,56 +1730,8 @@ process_event()
 
   std::vector<Int_t> hitseg_tof;
   { ///// TOF
-    static const auto device_id = gUnpacker.get_device_id("TOF");
-    static const auto adc_id = gUnpacker.get_data_id("TOF", "adc");
-    static const auto tdc_id = gUnpacker.get_data_id("TOF", "tdc");
-    static const auto tdc_min = gUser.GetParameter("TdcTOF", 0);
-    static const auto tdc_max = gUser.GetParameter("TdcTOF", 1);
-    static const auto adc_hid = gHist.getSequentialID(kTOF, 0, kADC);
-    static const auto tdc_hid = gHist.getSequentialID(kTOF, 0, kTDC);
-    static const auto awt_hid = gHist.getSequentialID(kTOF, 0, kADCwTDC);
-    static const auto hit_hid = gHist.getSequentialID(kTOF, 0, kHitPat);
-    static const auto mul_hid = gHist.getSequentialID(kTOF, 0, kMulti);
-    std::vector<std::vector<Int_t>> hit_flag(NumOfSegTOF);
-    Int_t multiplicity = 0;
-    for(Int_t seg=0; seg<NumOfSegTOF; ++seg) {
-      hit_flag[seg].resize(kUorD);
-      for(Int_t ud=0; ud<kUorD; ++ud) {
-	hit_flag[seg][ud] = 0;
-	// ADC
-	UInt_t adc = 0;
-	auto nhit = gUnpacker.get_entries(device_id, 0, seg, ud, adc_id);
-	if (nhit != 0) {
-	  adc = gUnpacker.get(device_id, 0, seg, ud, adc_id);
-	  hptr_array[adc_hid + ud*NumOfSegTOF + seg]->Fill(adc);
-	}
-	// TDC
-	for(Int_t m=0, n=gUnpacker.get_entries(device_id, 0, seg, ud, tdc_id);
-	    m<n; ++m) {
-	  auto tdc = gUnpacker.get(device_id, 0, seg, ud, tdc_id, m);
-	  if (tdc != 0) {
-	    hptr_array[tdc_hid + ud*NumOfSegTOF + seg]->Fill(tdc);
-	    if (tdc_min<tdc && tdc<tdc_max && adc > 0) {
-	      hit_flag[seg][ud] = 1;
-	    }
-	  }
-	}
-	if (hit_flag[seg][ud] == 1) {
-	  hptr_array[awt_hid + ud*NumOfSegTOF + seg]->Fill(adc);
-	}
-      }
-      if (hit_flag[seg][kU] == 1 && hit_flag[seg][kD] == 1) {
-	++multiplicity;
-	hptr_array[hit_hid]->Fill(seg);
-	hitseg_tof.push_back(seg);
-      }
-    }
-    hptr_array[mul_hid]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TOF");
+    gMonitor.Fill(index, event, hptr_array, hitseg_tof);
   }
 
 #if DEBUG
@@ -1848,26 +1762,26 @@ process_event()
     for(Int_t seg = 0; seg<NumOfSegAC1; ++seg) {
       // ADC
       if(seg>NumOfSegAC1-5 && seg<NumOfSegAC1-1){
-        Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
+        Int_t nhit_a = event.get_entries(k_device, 0, seg, 0, k_adc);
         if (nhit_a!=0) {
-	  Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+	  Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
 	  hptr_array[ac1a_id + seg-NumOfSegAC1+4 ]->Fill(adc);
         }
       }
       if(seg>NumOfSegAC1-2){
-        Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg-1, 0, k_adc);
+        Int_t nhit_a = event.get_entries(k_device, 0, seg-1, 0, k_adc);
         if (nhit_a!=0) {
-	  Int_t adc = gUnpacker.get(k_device, 0, seg-1, 0, k_adc);
+	  Int_t adc = event.get(k_device, 0, seg-1, 0, k_adc);
 	  hptr_array[ac1a_id + seg-NumOfSegAC1+4 ]->Fill(adc);
         }
       }
 
       // INDIVISUAL TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
+      Int_t nhit_t = event.get_entries(k_device, 0, seg, 0, k_tdc);
       Bool_t is_in_gate = false;
 
       for(Int_t m = 0; m<nhit_t; ++m) {
-	Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
+	Int_t tdc = event.get(k_device, 0, seg, 0, k_tdc, m);
 	hptr_array[ac1t_id + seg]->Fill(tdc);
 
 	if (tdc_min < tdc && tdc < tdc_max) {
@@ -1877,15 +1791,15 @@ process_event()
 
       if (is_in_gate) {
         if(seg>NumOfSegAC1-5 && seg<NumOfSegAC1-1){
-	  if (gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0) {
-	    Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+	  if (event.get_entries(k_device, 0, seg, 0, k_adc)>0) {
+	    Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
 	    hptr_array[ac1awt_id + seg-NumOfSegAC1+4 ]->Fill(adc);
 	  }
         }
       	else{
 	  if(seg>NumOfSegAC1-2){
-	    if (gUnpacker.get_entries(k_device, 0, seg-1, 0, k_adc)>0) {
-	      Int_t adc = gUnpacker.get(k_device, 0, seg-1, 0, k_adc);
+	    if (event.get_entries(k_device, 0, seg-1, 0, k_adc)>0) {
+	      Int_t adc = event.get(k_device, 0, seg-1, 0, k_adc);
 	      hptr_array[ac1awt_id + seg-NumOfSegAC1+4 ]->Fill(adc);
 	    }
 	  }
@@ -1926,10 +1840,10 @@ process_event()
 //     Int_t lact_id   = gHist.getSequentialID(kLAC, 0, kTDC);
 //     Int_t multiplicity = 0;
 //     for(Int_t seg = 0; seg<NumOfSegLAC; ++seg) {
-//       Int_t nhit = gUnpacker.get_entries(k_device, 0, seg, k_u, k_tdc);
+//       Int_t nhit = event.get_entries(k_device, 0, seg, k_u, k_tdc);
 //       Bool_t is_in_gate = false;
 //       for(Int_t m = 0; m<nhit; ++m) {
-// 	Int_t tdc = gUnpacker.get(k_device, 0, seg, k_u, k_tdc, m);
+// 	Int_t tdc = event.get(k_device, 0, seg, k_u, k_tdc, m);
 // 	hptr_array[lact_id + seg]->Fill(tdc);
 
 // 	if (tdc_min < tdc && tdc < tdc_max) is_in_gate = true;
@@ -1976,17 +1890,17 @@ process_event()
   //  Int_t multiplicity[2] = {0, 0};
     for(Int_t seg = 0; seg<NumOfSegSAC3; ++seg) {
       // ADC
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
+      Int_t nhit_a = event.get_entries(k_device, 0, seg, 0, k_adc);
       if (nhit_a!=0) {
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+	Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
 	hptr_array[a_id + seg]->Fill(adc);
       }
       // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
+      Int_t nhit_t = event.get_entries(k_device, 0, seg, 0, k_tdc);
       Bool_t is_in_gate = false;
 
       for(Int_t m = 0; m<nhit_t; ++m) {
-        Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
+        Int_t tdc = event.get(k_device, 0, seg, 0, k_tdc, m);
         hptr_array[t_id + seg]->Fill(tdc);
 
         if (tdc_min < tdc && tdc < tdc_max) {
@@ -1997,8 +1911,8 @@ process_event()
       if (is_in_gate) {
         // ADC w/TDC
 	// SAC3 segment 1 is dummy, only segment 0 is used.
-        if (gUnpacker.get_entries(k_device, 0, 0, 0, k_adc)>0) {
-          Int_t adc = gUnpacker.get(k_device, 0, 0, 0, k_adc);
+        if (event.get_entries(k_device, 0, 0, 0, k_adc)>0) {
+          Int_t adc = event.get(k_device, 0, 0, 0, k_adc);
           hptr_array[awt_id + seg]->Fill(adc);
         }
         //hptr_array[h_id]->Fill(seg);
@@ -2042,17 +1956,17 @@ process_event()
 
     for(Int_t seg = 0; seg<NumOfSegSFV; ++seg) {
   //    // ADC
-  //    Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
+  //    Int_t nhit_a = event.get_entries(k_device, 0, seg, 0, k_adc);
   //    if (nhit_a!=0) {
-  //      Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+  //      Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
   //      hptr_array[a_id + seg]->Fill(adc);
   //    }
       // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
+      Int_t nhit_t = event.get_entries(k_device, 0, seg, 0, k_tdc);
       Bool_t is_in_gate = false;
 
       for(Int_t m = 0; m<nhit_t; ++m) {
-        Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
+        Int_t tdc = event.get(k_device, 0, seg, 0, k_tdc, m);
         hptr_array[SFVt_id + seg]->Fill(tdc);
 
         if (tdc_min < tdc && tdc < tdc_max) {
@@ -2063,8 +1977,8 @@ process_event()
       if (is_in_gate) {
        if(seg<NumOfSegSFV-1){
   //      // ADC w/TDC
-  //      if (gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0) {
-  //        Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+  //      if (event.get_entries(k_device, 0, seg, 0, k_adc)>0) {
+  //        Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
   //        hptr_array[awt_id + seg]->Fill(adc);
   //      }
         hptr_array[SFVhit_id]->Fill(seg);
@@ -2104,21 +2018,21 @@ process_event()
     Int_t wcawt_id = gHist.getSequentialID(kWC, 0, kADCwTDC);    // UP
     for(Int_t seg=0; seg<NumOfSegWC; ++seg) {
       // ADC
-      Int_t nhit = gUnpacker.get_entries(k_device, 0, seg, k_u, k_adc);
+      Int_t nhit = event.get_entries(k_device, 0, seg, k_u, k_adc);
       if (nhit != 0) {
-	UInt_t adc = gUnpacker.get(k_device, 0, seg, k_u, k_adc);
+	UInt_t adc = event.get(k_device, 0, seg, k_u, k_adc);
 	hptr_array[wca_id + seg]->Fill(adc);
       }
       // TDC
-      nhit = gUnpacker.get_entries(k_device, 0, seg, k_u, k_tdc);
+      nhit = event.get_entries(k_device, 0, seg, k_u, k_tdc);
       for(Int_t m = 0; m<nhit; ++m) {
-	UInt_t tdc = gUnpacker.get(k_device, 0, seg, k_u, k_tdc, m);
+	UInt_t tdc = event.get(k_device, 0, seg, k_u, k_tdc, m);
 	if (tdc!=0) {
 	  hptr_array[wct_id + seg]->Fill(tdc);
 	  // ADC w/TDC
 	  if (tdc_min<tdc && tdc<tdc_max &&
-	      gUnpacker.get_entries(k_device, 0, seg, k_u, k_adc)>0) {
-	    UInt_t adc = gUnpacker.get(k_device, 0, seg, k_u, k_adc);
+	      event.get_entries(k_device, 0, seg, k_u, k_adc)>0) {
+	    UInt_t adc = event.get(k_device, 0, seg, k_u, k_adc);
 	    hptr_array[wcawt_id + seg]->Fill(adc);
 	  }
 	}
@@ -2131,21 +2045,21 @@ process_event()
     wcawt_id = gHist.getSequentialID(kWC, 0, kADCwTDC, NumOfSegWC+1);    // Down
     for(Int_t seg=0; seg<NumOfSegWC; ++seg) {
       // ADC
-      Int_t nhit = gUnpacker.get_entries(k_device, 0, seg, k_d, k_adc);
+      Int_t nhit = event.get_entries(k_device, 0, seg, k_d, k_adc);
       if (nhit != 0) {
-	UInt_t adc = gUnpacker.get(k_device, 0, seg, k_d, k_adc);
+	UInt_t adc = event.get(k_device, 0, seg, k_d, k_adc);
 	hptr_array[wca_id + seg]->Fill(adc);
       }
       // TDC
-      nhit = gUnpacker.get_entries(k_device, 0, seg, k_d, k_tdc);
+      nhit = event.get_entries(k_device, 0, seg, k_d, k_tdc);
       for(Int_t m = 0; m<nhit; ++m) {
-	UInt_t tdc = gUnpacker.get(k_device, 0, seg, k_d, k_tdc, m);
+	UInt_t tdc = event.get(k_device, 0, seg, k_d, k_tdc, m);
 	if (tdc!=0) {
  	  hptr_array[wct_id + seg]->Fill(tdc);
 	  // ADC w/TDC
 	  if (tdc_min<tdc && tdc<tdc_max &&
-	      gUnpacker.get_entries(k_device, 0, seg, k_d, k_adc)>0) {
-	    UInt_t adc = gUnpacker.get(k_device, 0, seg, k_d, k_adc);
+	      event.get_entries(k_device, 0, seg, k_d, k_adc)>0) {
+	    UInt_t adc = event.get(k_device, 0, seg, k_d, k_adc);
 	    hptr_array[wcawt_id + seg]->Fill(adc);
 	  }
 	}
@@ -2159,23 +2073,23 @@ process_event()
     Int_t multi = 0;
     for(Int_t seg=0; seg<NumOfSegWC; ++seg) {
       // ADC
-      Int_t nhit = gUnpacker.get_entries(k_device, 0, seg, k_sum, k_adc);
+      Int_t nhit = event.get_entries(k_device, 0, seg, k_sum, k_adc);
       if (nhit != 0) {
-	UInt_t adc = gUnpacker.get(k_device, 0, seg, k_sum, k_adc);
+	UInt_t adc = event.get(k_device, 0, seg, k_sum, k_adc);
 	hptr_array[wca_id + seg]->Fill(adc);
       }
       // TDC
-      nhit = gUnpacker.get_entries(k_device, 0, seg, k_sum, k_tdc);
+      nhit = event.get_entries(k_device, 0, seg, k_sum, k_tdc);
       Bool_t is_in_gate = false;
       for(Int_t m = 0; m<nhit; ++m) {
-	UInt_t tdc = gUnpacker.get(k_device, 0, seg, k_sum, k_tdc, m);
+	UInt_t tdc = event.get(k_device, 0, seg, k_sum, k_tdc, m);
 	if (tdc!=0) {
 	  hptr_array[wct_id + seg]->Fill(tdc);
 	  // ADC w/TDC
 	  if (tdc_min<tdc && tdc<tdc_max &&
-	      gUnpacker.get_entries(k_device, 0, seg, k_sum, k_adc)>0) {
+	      event.get_entries(k_device, 0, seg, k_sum, k_adc)>0) {
 	    is_in_gate = true;
-	    UInt_t adc = gUnpacker.get(k_device, 0, seg, k_sum, k_adc);
+	    UInt_t adc = event.get(k_device, 0, seg, k_sum, k_adc);
 	    hptr_array[wcawt_id + seg]->Fill(adc);
 	  }
 	}
@@ -2214,12 +2128,12 @@ process_event()
     Int_t mtx3d_id = gHist.getSequentialID(kCorrelation, 2, 0, 1);
 
     // BH1 vs BFT
-    TH2* hcor_bh1bft = dynamic_cast<TH2*>(hptr_array[cor_id++]);
+    HistShard* hcor_bh1bft = hptr_array[cor_id++];
     for(Int_t seg1 = 0; seg1<NumOfSegBH1; ++seg1) {
       for(const auto& seg2: hitseg_bftu) {
-	Int_t nhitBH1 = gUnpacker.get_entries(k_device_bh1, 0, seg1, 0, 1);
+	Int_t nhitBH1 = event.get_entries(k_device_bh1, 0, seg1, 0, 1);
 	if (nhitBH1 == 0) continue;
-	Int_t tdcBH1 = gUnpacker.get(k_device_bh1, 0, seg1, 0, 1);
+	Int_t tdcBH1 = event.get(k_device_bh1, 0, seg1, 0, 1);
 	Bool_t hitBH1 = (tdcBH1 > 0);
 	if (hitBH1) {
 	  hcor_bh1bft->Fill(seg1, seg2);
@@ -2228,14 +2142,14 @@ process_event()
     }
 
     // BH1 vs BH2
-    TH2* hcor_bh1bh2 = dynamic_cast<TH2*>(hptr_array[cor_id++]);
+    HistShard* hcor_bh1bh2 = hptr_array[cor_id++];
     for(Int_t seg1 = 0; seg1<NumOfSegBH1; ++seg1) {
       for(Int_t seg2 = 0; seg2<NumOfSegBH2; ++seg2) {
-	Int_t hitBH1 = gUnpacker.get_entries(k_device_bh1, 0, seg1, 0, 1);
-	Int_t hitBH2 = gUnpacker.get_entries(k_device_bh2, 0, seg2, 0, 1);
+	Int_t hitBH1 = event.get_entries(k_device_bh1, 0, seg1, 0, 1);
+	Int_t hitBH2 = event.get_entries(k_device_bh2, 0, seg2, 0, 1);
 	if (hitBH1 == 0 || hitBH2 == 0)continue;
-	Int_t tdcBH1 = gUnpacker.get(k_device_bh1, 0, seg1, 0, 1);
-	Int_t tdcBH2 = gUnpacker.get(k_device_bh2, 0, seg2, 0, 1);
+	Int_t tdcBH1 = event.get(k_device_bh1, 0, seg1, 0, 1);
+	Int_t tdcBH2 = event.get(k_device_bh2, 0, seg2, 0, 1);
 	if (tdcBH1 != 0 && tdcBH2 != 0) {
 	  hcor_bh1bh2->Fill(seg1, seg2);
 	}
@@ -2243,57 +2157,57 @@ process_event()
     }
 
     // BC3 vs BC4
-    TH2* hcor_bc3bc4 = dynamic_cast<TH2*>(hptr_array[cor_id++]);
+    HistShard* hcor_bc3bc4 = hptr_array[cor_id++];
     for(Int_t wire1 = 0; wire1<NumOfWireBC3; ++wire1) {
       for(Int_t wire2 = 0; wire2<NumOfWireBC4; ++wire2) {
-	Int_t hitBC3 = gUnpacker.get_entries(k_device_bc3, 0, 0, wire1, 0);
-	Int_t hitBC4 = gUnpacker.get_entries(k_device_bc4, 5, 0, wire2, 0);
+	Int_t hitBC3 = event.get_entries(k_device_bc3, 0, 0, wire1, 0);
+	Int_t hitBC4 = event.get_entries(k_device_bc4, 5, 0, wire2, 0);
 	if (hitBC3 == 0 || hitBC4 == 0)continue;
 	hcor_bc3bc4->Fill(wire1, wire2);
       }
     }
 
     // SDC3 vs SDC1
-    TH2* hcor_sdc1sdc3 = dynamic_cast<TH2*>(hptr_array[cor_id++]);
+    HistShard* hcor_sdc1sdc3 = hptr_array[cor_id++];
     for(Int_t wire1 = 0; wire1<NumOfWireSDC1; ++wire1) {
       for(Int_t wire3 = 0; wire3<NumOfWireSDC3; ++wire3) {
-	Int_t hitSDC1 = gUnpacker.get_entries(k_device_sdc1, 0, 0, wire1, 0);
-	Int_t hitSDC3 = gUnpacker.get_entries(k_device_sdc3, 0, 0, wire3, 0);
+	Int_t hitSDC1 = event.get_entries(k_device_sdc1, 0, 0, wire1, 0);
+	Int_t hitSDC3 = event.get_entries(k_device_sdc3, 0, 0, wire3, 0);
 	if (hitSDC1 == 0 || hitSDC3 == 0) continue;
 	hcor_sdc1sdc3->Fill(wire1, wire3);
       }
     }
 
     // SDC3 vs SDC4
-    TH2* hcor_sdc3sdc4 = dynamic_cast<TH2*>(hptr_array[cor_id++]);
+    HistShard* hcor_sdc3sdc4 = hptr_array[cor_id++];
     for(Int_t wire3 = 0; wire3<NumOfWireSDC3; ++wire3) {
       for(Int_t wire4 = 0; wire4<NumOfWireSDC4; ++wire4) {
-	Int_t hitSDC3 = gUnpacker.get_entries(k_device_sdc3, 0, 0, wire3, 0);
-	Int_t hitSDC4 = gUnpacker.get_entries(k_device_sdc4, 0, 0, wire4, 0);
+	Int_t hitSDC3 = event.get_entries(k_device_sdc3, 0, 0, wire3, 0);
+	Int_t hitSDC4 = event.get_entries(k_device_sdc4, 0, 0, wire4, 0);
 	if (hitSDC3 == 0 || hitSDC4 == 0) continue;
 	hcor_sdc3sdc4->Fill(wire3, wire4);
       }
     }
 
     // TOF vs SDC4
-    TH2* hcor_tofsdc4 = dynamic_cast<TH2*>(hptr_array[cor_id++]);
+    HistShard* hcor_tofsdc4 = hptr_array[cor_id++];
     for(const auto& seg_tof: hitseg_tof) {
       for(Int_t wire=0; wire<NumOfWireSDC4X; ++wire) {
-	Int_t hitSDC4 = gUnpacker.get_entries(k_device_sdc4, 2, 0, wire, 0);
+	Int_t hitSDC4 = event.get_entries(k_device_sdc4, 2, 0, wire, 0);
 	if (hitSDC4 == 0) continue;
 	hcor_tofsdc4->Fill(wire, seg_tof);
       }
     }
 
     // AC1 vs TOF
-    TH2* hcor_ac1tof = dynamic_cast<TH2*>(hptr_array[cor_id++]);
+    HistShard* hcor_ac1tof = hptr_array[cor_id++];
     for(Int_t seg1 = 0; seg1<NumOfSegAC1-2; ++seg1) {
       for(Int_t seg2 = 0; seg2<NumOfSegTOF; ++seg2) {
-	Int_t hitAC1 = gUnpacker.get_entries(k_device_ac1, 0, seg1, 0, 1);
-	Int_t hitTOF = gUnpacker.get_entries(k_device_tof, 0, seg2, 0, 1);
+	Int_t hitAC1 = event.get_entries(k_device_ac1, 0, seg1, 0, 1);
+	Int_t hitTOF = event.get_entries(k_device_tof, 0, seg2, 0, 1);
 	if (hitAC1 == 0 || hitTOF == 0)continue;
-	Int_t tdcac1 = gUnpacker.get(k_device_ac1, 0, seg1, 0, 1);
-	Int_t tdctof = gUnpacker.get(k_device_tof, 0, seg2, 0, 1);
+	Int_t tdcac1 = event.get(k_device_ac1, 0, seg1, 0, 1);
+	Int_t tdctof = event.get(k_device_tof, 0, seg2, 0, 1);
 	if (tdcac1 != 0 && tdctof != 0) {
 	  hcor_ac1tof->Fill(seg1, seg2);
 	}
@@ -2301,14 +2215,14 @@ process_event()
     }
 
     // WC vs TOF
-    TH2* hcor_wctof = dynamic_cast<TH2*>(hptr_array[cor_id++]);
+    HistShard* hcor_wctof = hptr_array[cor_id++];
     for(Int_t seg1 = 0; seg1<NumOfSegWC; ++seg1) {
       for(Int_t seg2 = 0; seg2<NumOfSegTOF; ++seg2) {
-	Int_t hitWC = gUnpacker.get_entries(k_device_wc, 0, seg1, 0, 1);
-	Int_t hitTOF = gUnpacker.get_entries(k_device_tof, 0, seg2, 0, 1);
+	Int_t hitWC = event.get_entries(k_device_wc, 0, seg1, 0, 1);
+	Int_t hitTOF = event.get_entries(k_device_tof, 0, seg2, 0, 1);
 	if (hitWC == 0 || hitTOF == 0)continue;
-	Int_t tdcwc = gUnpacker.get(k_device_wc, 0, seg1, 0, 1);
-	Int_t tdctof = gUnpacker.get(k_device_tof, 0, seg2, 0, 1);
+	Int_t tdcwc = event.get(k_device_wc, 0, seg1, 0, 1);
+	Int_t tdctof = event.get(k_device_tof, 0, seg2, 0, 1);
 	if (tdcwc != 0 && tdctof != 0) {
 	  hcor_wctof->Fill(seg1, seg2);
 	}
@@ -2345,13 +2259,13 @@ process_event()
     Double_t t0  = 1e10;
     Double_t ofs = 0;
     for(Int_t seg=0; seg<NumOfSegBH2; ++seg) {
-      Int_t nhitu = gUnpacker.get_entries(k_d_bh2, 0, seg, kU, k_tdc);
-      Int_t nhitd = gUnpacker.get_entries(k_d_bh2, 0, seg, kD, k_tdc);
+      Int_t nhitu = event.get_entries(k_d_bh2, 0, seg, kU, k_tdc);
+      Int_t nhitd = event.get_entries(k_d_bh2, 0, seg, kD, k_tdc);
       for(Int_t mu=0; mu<nhitu; ++mu) {
-	auto tdcu = gUnpacker.get(k_d_bh2, 0, seg, kU, k_tdc, mu);
+	auto tdcu = event.get(k_d_bh2, 0, seg, kU, k_tdc, mu);
 	if (tdcu < tdc_min_bh2 || tdc_max_bh2 < tdcu) continue;
 	for(Int_t md=0; md<nhitd; ++md) {
-	  auto tdcd = gUnpacker.get(k_d_bh2, 0, seg, kD, k_tdc, md);
+	  auto tdcd = event.get(k_d_bh2, 0, seg, kD, k_tdc, md);
 	  if (tdcd < tdc_min_bh2 || tdc_max_bh2 < tdcd) continue;
 	  Double_t bh2ut, bh2dt;
 	  hodoMan.GetTime(cid_bh2, plid, seg, kU, tdcu, bh2ut);
@@ -2366,13 +2280,13 @@ process_event()
     }
     // BH1
     for(Int_t seg=0; seg<NumOfSegBH1; ++seg) {
-      Int_t nhitu = gUnpacker.get_entries(k_d_bh1, 0, seg, kU, k_tdc);
-      Int_t nhitd = gUnpacker.get_entries(k_d_bh1, 0, seg, kD, k_tdc);
+      Int_t nhitu = event.get_entries(k_d_bh1, 0, seg, kU, k_tdc);
+      Int_t nhitd = event.get_entries(k_d_bh1, 0, seg, kD, k_tdc);
       for(Int_t mu=0; mu<nhitu; ++mu) {
-	auto tdcu = gUnpacker.get(k_d_bh1, 0, seg, kU, k_tdc, mu);
+	auto tdcu = event.get(k_d_bh1, 0, seg, kU, k_tdc, mu);
 	if (tdcu < tdc_min_bh1 || tdc_max_bh1 < tdcu) continue;
 	for(Int_t md=0; md<nhitd; ++md) {
-	  auto tdcd = gUnpacker.get(k_d_bh1, 0, seg, kD, k_tdc, md);
+	  auto tdcd = event.get(k_d_bh1, 0, seg, kD, k_tdc, md);
 	  if (tdcd < tdc_min_bh1 || tdc_max_bh1 < tdcd) continue;
 	  Double_t bh1tu, bh1td;
 	  hodoMan.GetTime(cid_bh1, plid, seg, kU, tdcu, bh1tu);
@@ -2404,11 +2318,11 @@ process_event()
     Double_t t0  = 1e10;
     Double_t ofs = 0;
     Int_t seg = 3;
-    Int_t nhitu = gUnpacker.get_entries(k_d_bh2, 0, seg, kU, k_tdc);
-    Int_t nhitd = gUnpacker.get_entries(k_d_bh2, 0, seg, kD, k_tdc);
+    Int_t nhitu = event.get_entries(k_d_bh2, 0, seg, kU, k_tdc);
+    Int_t nhitd = event.get_entries(k_d_bh2, 0, seg, kD, k_tdc);
     if (nhitu != 0 && nhitd != 0) {
-      Int_t tdcu = gUnpacker.get(k_d_bh2, 0, seg, kU, k_tdc);
-      Int_t tdcd = gUnpacker.get(k_d_bh2, 0, seg, kD, k_tdc);
+      Int_t tdcu = event.get(k_d_bh2, 0, seg, kU, k_tdc);
+      Int_t tdcd = event.get(k_d_bh2, 0, seg, kD, k_tdc);
       if (tdcu != 0 && tdcd != 0) {
 	++multiplicity;
 	t0 = (Double_t)(tdcu+tdcd)/2.;
@@ -2417,11 +2331,11 @@ process_event()
     if (multiplicity == 1) {
       seg = 5;
       // BH1
-      Int_t nhitu = gUnpacker.get_entries(k_d_bh1, 0, seg, kU, k_tdc);
-      Int_t nhitd = gUnpacker.get_entries(k_d_bh1, 0, seg, kD, k_tdc);
+      Int_t nhitu = event.get_entries(k_d_bh1, 0, seg, kU, k_tdc);
+      Int_t nhitd = event.get_entries(k_d_bh1, 0, seg, kD, k_tdc);
       if (nhitu != 0 &&  nhitd != 0) {
-	Int_t tdcu = gUnpacker.get(k_d_bh1, 0, seg, kU, k_tdc);
-	Int_t tdcd = gUnpacker.get(k_d_bh1, 0, seg, kD, k_tdc);
+	Int_t tdcu = event.get(k_d_bh1, 0, seg, kU, k_tdc);
+	Int_t tdcd = event.get(k_d_bh1, 0, seg, kD, k_tdc);
 	if (tdcu != 0 && tdcd != 0) {
 	  Double_t mt = (Double_t)(tdcu+tdcd)/2.;
 	  Double_t btof = mt-(t0+ofs);
@@ -2437,123 +2351,17 @@ process_event()
 
   // BAC -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("BAC");
-    static const Int_t k_adc    = gUnpacker.get_data_id("BAC","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("BAC","tdc");
-
-    // sequential id
-    /*
-      static const Int_t baca_id   = gHist.getSequentialID(kBAC, 0, kADC,     2);
-      static const Int_t bact_id   = gHist.getSequentialID(kBAC, 0, kTDC,     2);
-      static const Int_t bacawt_id = gHist.getSequentialID(kBAC, 0, kADCwTDC, 2);
-      static const Int_t bach_id   = gHist.getSequentialID(kBAC, 0, kHitPat,  1);
-      static const Int_t bacm_id   = gHist.getSequentialID(kBAC, 0, kMulti,   1);
-    */
-
-    static const Int_t baca_id   = gHist.getSequentialID(kBAC, 0, kADC);
-    static const Int_t bact_id   = gHist.getSequentialID(kBAC, 0, kTDC);
-    static const Int_t bacawt_id = gHist.getSequentialID(kBAC, 0, kADCwTDC);
-    static const Int_t bach_id   = gHist.getSequentialID(kBAC, 0, kHitPat);
-    static const Int_t bacm_id   = gHist.getSequentialID(kBAC, 0, kMulti);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcBAC", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcBAC", 1);
-
-    Int_t multiplicity = 0;
-    for(Int_t seg = 0; seg<NumOfSegBAC; ++seg) {
-      // ADC
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-      if (nhit_a!=0) {
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	hptr_array[baca_id + seg]->Fill(adc);
-      }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m) {
-	Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-	hptr_array[bact_id + seg]->Fill(tdc);
-
-	if (tdc_min < tdc && tdc < tdc_max) {
-	  is_in_gate = true;
-	}// tdc range is ok
-      }// for(m)
-
-      if (is_in_gate) {
-	// ADC w/TDC
-	if (gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0) {
-	  Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	  hptr_array[bacawt_id + seg]->Fill(adc);
-	}
-	hptr_array[bach_id]->Fill(seg);
-	++multiplicity;
-      }// flag is OK
-    }
-
-    hptr_array[bacm_id]->Fill(multiplicity);
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("BAC");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, event, hptr_array, hitseg);
   }//BAC
 
 
   // TF_TF  -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("TF_TF");
-    static const Int_t k_adc    = gUnpacker.get_data_id("TF_TF","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("TF_TF","tdc");
-
-    static const Int_t a_id   = gHist.getSequentialID(kTF_TF, 0, kADC);
-    static const Int_t t_id   = gHist.getSequentialID(kTF_TF, 0, kTDC);
-    static const Int_t awt_id = gHist.getSequentialID(kTF_TF, 0, kADCwTDC);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcTF_TF", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcTF_TF", 1);
-
-    for(Int_t seg = 0; seg<NumOfSegTF_TF; ++seg) {
-      // ADC
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-      if (nhit_a!=0) {
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-	hptr_array[a_id + seg]->Fill(adc);
-      }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m) {
-        Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-        hptr_array[t_id + seg]->Fill(tdc);
-
-        if (tdc_min < tdc && tdc < tdc_max) {
-          is_in_gate = true;
-        }// tdc range is ok
-      }// for(m)
-    if (is_in_gate) {
-        // ADC w/TDC
-        if (gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0) {
-          Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-          hptr_array[awt_id + seg]->Fill(adc);
-        }
-        //hptr_array[h_id]->Fill(seg);
-        //hptr_array[e72para_id]->Fill(e72parasite::kE90SAC1 + seg);
-        //++multiplicity[seg];
-      }// flag is OK
-    }
-
-
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TF_TF");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, event, hptr_array, hitseg);
   }//TF_TF
 
 #if DEBUG
@@ -2563,45 +2371,9 @@ process_event()
 
   // TF_GN1  -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("TF_GN1");
-    //static const Int_t k_adc    = gUnpacker.get_data_id("TF_GN1","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("TF_GN1","tdc");
-
-    //static const Int_t a_id   = gHist.getSequentialID(kTF_GN1, 0, kADC);
-    static const Int_t t_id   = gHist.getSequentialID(kTF_GN1, 0, kTDC);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcTF_GN1", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcTF_GN1", 1);
-
-    for(Int_t seg = 0; seg<NumOfSegTF_GN1; ++seg) {
-      // ADC
-    //  Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-    //  if (nhit_a!=0) {
-    //    Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-    //    hptr_array[a_id + seg]->Fill(adc);
-    //  }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m) {
-        Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-        hptr_array[t_id + seg]->Fill(tdc);
-
-        if (tdc_min < tdc && tdc < tdc_max) {
-          is_in_gate = true;
-        }// tdc range is ok
-      }// for(m)
-
-    }
-
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TF_GN1");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, event, hptr_array, hitseg);
   }//TF_GN1
 
 #if DEBUG
@@ -2611,45 +2383,9 @@ process_event()
 
   // TF_GN2  -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("TF_GN2");
-    //static const Int_t k_adc    = gUnpacker.get_data_id("TF_GN2","adc");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("TF_GN2","tdc");
-
-    //static const Int_t a_id   = gHist.getSequentialID(kTF_GN2, 0, kADC);
-    static const Int_t t_id   = gHist.getSequentialID(kTF_GN2, 0, kTDC);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcTF_GN2", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcTF_GN2", 1);
-
-    for(Int_t seg = 0; seg<NumOfSegTF_GN2; ++seg) {
-      // ADC
-    //  Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
-    //  if (nhit_a!=0) {
-    //    Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
-    //    hptr_array[a_id + seg]->Fill(adc);
-    //  }
-      // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-      Bool_t is_in_gate = false;
-
-      for(Int_t m = 0; m<nhit_t; ++m) {
-        Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-        hptr_array[t_id + seg]->Fill(tdc);
-
-        if (tdc_min < tdc && tdc < tdc_max) {
-          is_in_gate = true;
-        }// tdc range is ok
-      }// for(m)
-
-    }
-
-
-#if 0
-    // Debug, dump data relating this detector
-    gUnpacker.dump_data_device(k_device);
-#endif
+    static const auto index = gMonitor.GetIndex("TF_GN2");
+    std::vector<Int_t> hitseg;
+    gMonitor.Fill(index, event, hptr_array, hitseg);
   }//TF_GN2
 
 #if DEBUG
@@ -2668,65 +2404,15 @@ process_event()
   Bool_t is_BH2_fired = false;
   // T1 -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("T1");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("T1","tdc");
-
-    // sequential id
-    static const Int_t t_id   = gHist.getSequentialID(kT1, 0, kTDC);
-    static const Int_t m_id   = gHist.getSequentialID(kT1, 0, kMulti);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcT1", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcT1", 1);
-
-    Int_t multiplicity = 0;
-    Int_t seg = 0;
-    // TDC
-    auto nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-
-    for(Int_t m = 0; m<nhit_t; ++m) {
-      Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-      hptr_array[t_id + seg]->Fill(tdc);
-      if (tdc_min < tdc && tdc < tdc_max) {
-	is_T1_fired = true;
-      }// tdc range is ok
-    }// for(m)
-    if (is_T1_fired) {
-      ++multiplicity;
-    }
-    hptr_array[m_id]->Fill(multiplicity);
+    static const auto index = gMonitor.GetIndex("T1");
+    std::vector<Int_t> hitseg;
+    is_T1_fired = (gMonitor.Fill(index, event, hptr_array, hitseg) > 0);
   }//T1
   // T2 -----------------------------------------------------------
   {
-    // data type
-    static const Int_t k_device = gUnpacker.get_device_id("T2");
-    static const Int_t k_tdc    = gUnpacker.get_data_id("T2","tdc");
-
-    // sequential id
-    static const Int_t t_id   = gHist.getSequentialID(kT2, 0, kTDC);
-    static const Int_t m_id   = gHist.getSequentialID(kT2, 0, kMulti);
-
-    // TDC gate range
-    static const Int_t tdc_min = gUser.GetParameter("TdcT2", 0);
-    static const Int_t tdc_max = gUser.GetParameter("TdcT2", 1);
-
-    Int_t multiplicity = 0;
-    Int_t seg = 0;
-    // TDC
-    auto nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
-
-    for(Int_t m = 0; m<nhit_t; ++m) {
-      Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
-      hptr_array[t_id + seg]->Fill(tdc);
-      if (tdc_min < tdc && tdc < tdc_max) {
-	is_T2_fired = true;
-      }// tdc range is ok
-    }// for(m)
-    if (is_T2_fired) {
-      ++multiplicity;
-    }
-    hptr_array[m_id]->Fill(multiplicity);
+    static const auto index = gMonitor.GetIndex("T2");
+    std::vector<Int_t> hitseg;
+    is_T2_fired = (gMonitor.Fill(index, event, hptr_array, hitseg) > 0);
   }//T2
 
   // E42BH2  -----------------------------------------------------------
@@ -2758,16 +2444,16 @@ process_event()
     for(Int_t ud=0; ud<2; ++ud) {
       // ADC
       UInt_t adc = 0;
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, ud, k_adc);
+      Int_t nhit_a = event.get_entries(k_device, 0, seg, ud, k_adc);
       if (nhit_a!=0) {
-	adc = gUnpacker.get(k_device, 0, seg, ud, k_adc);
+	adc = event.get(k_device, 0, seg, ud, k_adc);
 	hptr_array[a_id + ud]->Fill(adc);
       }
       // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, ud, k_tdc);
+      Int_t nhit_t = event.get_entries(k_device, 0, seg, ud, k_tdc);
 
       for(Int_t m = 0; m<nhit_t; ++m) {
-	Int_t tdc = gUnpacker.get(k_device, 0, seg, ud, k_tdc, m);
+	Int_t tdc = event.get(k_device, 0, seg, ud, k_tdc, m);
 	hptr_array[t_id + ud]->Fill(tdc);
 
 	if (tdc_min < tdc && tdc < tdc_max && adc > 0) {
@@ -2784,10 +2470,10 @@ process_event()
     for(Int_t seg = 0; seg<NumOfSegE42BH2; ++seg) {
       Int_t ud=2;
       // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, ud, k_tdc);
+      Int_t nhit_t = event.get_entries(k_device, 0, seg, ud, k_tdc);
 
       for(Int_t m = 0; m<nhit_t; ++m) {
-	Int_t tdc = gUnpacker.get(k_device, 0, seg, ud, k_tdc, m);
+	Int_t tdc = event.get(k_device, 0, seg, ud, k_tdc, m);
 	hptr_array[t_id + seg + 2]->Fill(tdc);
 
 	if (tdc_min < tdc && tdc < tdc_max) {
@@ -2841,17 +2527,17 @@ process_event()
     Int_t multiplicity = 0;
     Int_t seg = 0;
     // ADC
-    auto nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
+    auto nhit_a = event.get_entries(k_device, 0, seg, 0, k_adc);
     if (nhit_a!=0) {
-      Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+      Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
       hptr_array[a_id + seg]->Fill(adc);
     }
     // TDC
-    auto nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
+    auto nhit_t = event.get_entries(k_device, 0, seg, 0, k_tdc);
     Bool_t is_in_gate = false;
 
     for(Int_t m = 0; m<nhit_t; ++m) {
-      Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
+      Int_t tdc = event.get(k_device, 0, seg, 0, k_tdc, m);
       hptr_array[t_id + seg]->Fill(tdc);
 
       if (tdc_min < tdc && tdc < tdc_max) {
@@ -2861,8 +2547,8 @@ process_event()
 
     if (is_in_gate) {
       // ADC w/TDC
-      if (gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0) {
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+      if (event.get_entries(k_device, 0, seg, 0, k_adc)>0) {
+	Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
 	hptr_array[awt_id + seg]->Fill(adc);
       }
       hptr_array[e72para_id]->Fill(e72parasite::kE72BAC);
@@ -2901,17 +2587,17 @@ process_event()
     Int_t multiplicity[2] = {0, 0};
     for(Int_t seg = 0; seg<NumOfSegE90SAC; ++seg) {
       // ADC
-      Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, 0, k_adc);
+      Int_t nhit_a = event.get_entries(k_device, 0, seg, 0, k_adc);
       if (nhit_a!=0) {
-	Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+	Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
 	hptr_array[a_id + seg]->Fill(adc);
       }
       // TDC
-      Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, 0, k_tdc);
+      Int_t nhit_t = event.get_entries(k_device, 0, seg, 0, k_tdc);
       Bool_t is_in_gate = false;
 
       for(Int_t m = 0; m<nhit_t; ++m) {
-	Int_t tdc = gUnpacker.get(k_device, 0, seg, 0, k_tdc, m);
+	Int_t tdc = event.get(k_device, 0, seg, 0, k_tdc, m);
 	hptr_array[t_id + seg]->Fill(tdc);
 
 	if (tdc_min < tdc && tdc < tdc_max) {
@@ -2921,8 +2607,8 @@ process_event()
 
       if (is_in_gate) {
 	// ADC w/TDC
-	if (gUnpacker.get_entries(k_device, 0, seg, 0, k_adc)>0) {
-	  Int_t adc = gUnpacker.get(k_device, 0, seg, 0, k_adc);
+	if (event.get_entries(k_device, 0, seg, 0, k_adc)>0) {
+	  Int_t adc = event.get(k_device, 0, seg, 0, k_adc);
 	  hptr_array[awt_id + seg]->Fill(adc);
 	}
 	hptr_array[h_id]->Fill(seg);
@@ -2971,16 +2657,16 @@ process_event()
 	hit_flag[seg][ud] = 0;
 	// ADC
 	UInt_t adc = 0;
-	Int_t nhit_a = gUnpacker.get_entries(k_device, 0, seg, ud, k_adc);
+	Int_t nhit_a = event.get_entries(k_device, 0, seg, ud, k_adc);
 	if (nhit_a!=0) {
-	  adc = gUnpacker.get(k_device, 0, seg, ud, k_adc);
+	  adc = event.get(k_device, 0, seg, ud, k_adc);
 	  hptr_array[a_id + seg + ud*NumOfSegE72KVC]->Fill(adc);
 	}
 	// TDC
-	Int_t nhit_t = gUnpacker.get_entries(k_device, 0, seg, ud, k_tdc);
+	Int_t nhit_t = event.get_entries(k_device, 0, seg, ud, k_tdc);
 
 	for(Int_t m = 0; m<nhit_t; ++m) {
-	  Int_t tdc = gUnpacker.get(k_device, 0, seg, ud, k_tdc, m);
+	  Int_t tdc = event.get(k_device, 0, seg, ud, k_tdc, m);
 	  hptr_array[t_id + seg + ud*NumOfSegE72KVC]->Fill(tdc);
 
 	  if (tdc_min < tdc && tdc < tdc_max && adc > 0) {
@@ -3018,6 +2704,14 @@ process_event()
   std::cout << __FILE__ << " " << __LINE__ << std::endl;
 #endif
   return 0;
+} //process_snapshot()
+
+//____________________________________________________________________________
+Int_t
+process_event()
+{
+  // events are analyzed by process_snapshot() driven from Main
+  return 0;
 } //process_event()
 
 } //analyzer
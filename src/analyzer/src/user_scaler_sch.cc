@@ -147,16 +147,17 @@ process_event( void )
 
   if( gScaler.IsSpillEnd() &&
       gScaler.GetFlag( ScalerAnalyzer::kScalerSheet ) ){
+    static const ScalerHandle spill = gScaler.GetHandle( "Spill" );
     std::cout << "found spill end "
-    	      << gScaler.Get("Spill") << "/" << nspill_scaler_sheet
+    	      << gScaler.Get( spill ) << "/" << nspill_scaler_sheet
 	      << std::endl;
 
-    if( gScaler.Get("Spill") == nspill_scaler_sheet ){
+    if( gScaler.Get( spill ) == nspill_scaler_sheet ){
       gScaler.PrintScalerSheet();
       return -1;
     }
 
-    if( gScaler.Get("Spill") > nspill_scaler_sheet ){
+    if( gScaler.Get( spill ) > nspill_scaler_sheet ){
       std::cout << "something is wrong!" << std::endl;
       return -1;
     }
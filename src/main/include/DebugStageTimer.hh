@@ -0,0 +1,176 @@
+// -*- C++ -*-
+
+#ifndef ANALYZER_DEBUG_STAGE_TIMER_H
+#define ANALYZER_DEBUG_STAGE_TIMER_H
+
+#include <atomic>
+#include <ctime>
+#include <ostream>
+#include <string>
+
+#include <std_ostream.hh>
+
+//_____________________________________________________________________
+// Scoped timers of the analysis stages.
+//
+//   debug::StageTimer timer( debug::kRawDecode );
+//
+// measures the enclosing scope with clock_gettime(CLOCK_MONOTONIC) and
+// adds the latency to a log-scale histogram owned by the calling thread,
+// so the event loop, the pipeline workers and the publisher never share
+// a cache line or a lock. The histograms of all threads are summed when
+// a summary is requested, from any thread, and the percentiles are read
+// from the sum. It lives in main so that the event loop, the pipeline
+// and the analyzer library can all use it.
+// Compiled only with -DProfileStage (make PROFILE=1, see common.mk),
+// otherwise StageTimer is empty and costs nothing.
+namespace debug
+{
+  enum EStage
+    {
+      kUnpack,      // GUnpacker, next event (waiting for data online)
+      kCapture,     // EventPipeline, copy into the snapshot
+      kEvent,       // process_event(), histogram fills included
+      kRawDecode,
+      kDCDecode,
+      kTrackBcIn,
+      kTrackBcOut,
+      kTrackSdcIn,
+      kTrackSdcOut,
+      kTrackK18,
+      kTrackKurama,
+      kKuramaFit,
+      kHistMerge,   // worker shards into the drawn histograms
+      kSnapshot,    // JsRootUpdater::sync() in the event loop
+      kUpdate,      // Updater, canvases
+      kPublish,     // JsRootUpdater, one tick
+      kNStage
+    };
+
+  //_____________________________________________________________________
+  class StageProfile
+  {
+  public:
+    static StageProfile& GetInstance( void );
+    ~StageProfile( void );
+
+  private:
+    StageProfile( void );
+    StageProfile( const StageProfile& );
+    StageProfile& operator =( const StageProfile& );
+
+  public:
+    // 2^SubBits buckets per octave of nanoseconds, i.e. < 19% width
+    static const int SubBits  = 2;
+    static const int NBucket  = 64 << SubBits;
+
+    struct Summary
+    {
+      unsigned long long count;
+      double             mean;   // [ns]
+      double             p50;
+      double             p90;
+      double             p99;
+      double             max;
+    };
+
+  private:
+    // written by the owner thread only, read by anyone
+    std::atomic<unsigned long long> m_count[kNStage][NBucket];
+    std::atomic<unsigned long long> m_sum[kNStage];
+    std::atomic<unsigned long long> m_max[kNStage];
+
+  public:
+    void add( EStage stage, unsigned long long ns );
+
+  public:
+    static Summary     get( EStage stage );
+    static const char* name( EStage stage );
+    static void        print( const std::string& arg="",
+			      std::ostream& ost=hddaq::cout );
+    static void        reset( void );
+    static std::string table( void );
+
+  private:
+    static int         bucket( unsigned long long ns );
+    static double      lower_edge( int bucket );
+  };
+
+  //_____________________________________________________________________
+  class StageTimer
+  {
+  public:
+    explicit StageTimer( EStage stage );
+    ~StageTimer( void );
+
+  private:
+    StageTimer( const StageTimer& );
+    StageTimer& operator =( const StageTimer& );
+
+#ifdef ProfileStage
+  private:
+    EStage             m_stage;
+    unsigned long long m_start;
+
+  public:
+    static unsigned long long now( void );
+#endif
+  };
+
+  //_____________________________________________________________________
+  inline void
+  StageProfile::add( EStage stage, unsigned long long ns )
+  {
+    // single writer: plain load/store instead of a locked read-modify-write
+    std::atomic<unsigned long long>& c = m_count[stage][bucket(ns)];
+    c.store( c.load(std::memory_order_relaxed)+1, std::memory_order_relaxed );
+    m_sum[stage].store( m_sum[stage].load(std::memory_order_relaxed)+ns,
+			std::memory_order_relaxed );
+    if( ns>m_max[stage].load(std::memory_order_relaxed) )
+      m_max[stage].store( ns, std::memory_order_relaxed );
+  }
+
+  //_____________________________________________________________________
+  inline int
+  StageProfile::bucket( unsigned long long ns )
+  {
+    if( ns < (1ULL<<SubBits) )
+      return ns;
+    const int msb = 63 - __builtin_clzll(ns);
+    return ( (msb-SubBits+1)<<SubBits ) +
+      ( (ns>>(msb-SubBits)) & ((1ULL<<SubBits)-1) );
+  }
+
+#ifdef ProfileStage
+  //_____________________________________________________________________
+  inline unsigned long long
+  StageTimer::now( void )
+  {
+    ::timespec t;
+    ::clock_gettime( CLOCK_MONOTONIC, &t );
+    return t.tv_sec*1000000000ULL + t.tv_nsec;
+  }
+
+  //_____________________________________________________________________
+  inline
+  StageTimer::StageTimer( EStage stage )
+    : m_stage(stage),
+      m_start(now())
+  {
+  }
+
+  //_____________________________________________________________________
+  inline
+  StageTimer::~StageTimer( void )
+  {
+    StageProfile::GetInstance().add( m_stage, now()-m_start );
+  }
+#else
+  //_____________________________________________________________________
+  inline StageTimer::StageTimer( EStage ) {}
+  inline StageTimer::~StageTimer( void ) {}
+#endif
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+// -*- C++ -*-
+
+#ifndef ANALYZER_EVENT_PIPELINE_H
+#define ANALYZER_EVENT_PIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "EventSnapshot.hh"
+#include "HistShard.hh"
+#include "SamplingController.hh"
+#include "SpscRing.hh"
+#include "user_analyzer.hh"
+
+class TH1;
+class TThread;
+
+namespace analyzer
+{
+
+  //___________________________________________________________________________
+  // N-worker event pipeline.
+  // The thread driving GUnpacker calls push() once per event: the event is
+  // captured into a recycled EventSnapshot and queued to worker
+  // (n_pushed % n_worker). Each worker runs the user event processor on
+  // its own HistShardSet, which merge() folds into the visible histograms.
+  // Workers hand their shards over between events, so fills take no lock
+  // and a merge never contains part of an event.
+  // Each worker owns its snapshots, which go round two SpscRing's, the
+  // queue (reader -> worker) and the free list (worker -> reader), so the
+  // event path takes no lock; the mutex is only held to sleep.
+  // When the queue of the next worker is full, the policy decides:
+  //   kBlock       wait for the worker, the assignment of events to
+  //                workers does not depend on timing (default)
+  //   kDropOldest  recycle the oldest queued event for the new one, the
+  //                reader never waits for the analysis
+  //   kSample      as kDropOldest for every n_sample-th event read, the
+  //                other ones are skipped without being captured
+  //   kAdaptive    only the fraction of SamplingController is captured,
+  //                the events still finding the queue full are skipped
+  // The events chosen by the event selector are never skipped nor
+  // dropped from the queues (the reader waits for them instead), and the
+  // histogram titles show the fraction of the events analyzed when it is
+  // below 1.
+  class EventPipeline
+  {
+  public:
+    enum EPolicy { kBlock, kDropOldest, kSample, kAdaptive, kNPolicy };
+
+    typedef SpscRing<EventSnapshot*> Ring;
+
+    struct Worker
+    {
+      int                    id;
+      EventPipeline*         pipeline;
+      TThread*               thread;
+      Ring*                  queue;
+      Ring*                  free;
+      HistShardSet*          shard;
+      std::atomic<bool>      is_waiting;
+      std::atomic<long long> n_processed;
+      std::atomic<long long> busy_ns;     // in the event processor
+    };
+
+    // live counters, see getStatistics()
+    struct Statistics
+    {
+      long long n_read;      // push() calls
+      long long n_pushed;    // events queued to the workers
+      long long n_processed; // events done by the workers
+      long long n_dropped;   // queued events replaced by newer ones
+      long long n_skipped;   // events not captured by kSample
+      int       depth;       // events in the queues
+      int       capacity;    // sum of the queue sizes
+      double    busy;        // seconds in the event processor
+    };
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    event_processor              m_processor;
+    event_selector               m_selector;
+    std::vector<TH1*>            m_hist;
+    std::vector<std::string>     m_title;
+    int                          m_title_permil; // fraction in the titles
+    std::vector<Worker*>         m_worker;
+    std::vector<EventSnapshot*>  m_buffer;
+    std::mutex                   m_mutex;
+    std::condition_variable      m_cond_queue; // event queued or end
+    std::condition_variable      m_cond_free;  // buffer released
+    std::atomic<bool>            m_is_reader_waiting;
+    std::atomic<long long>       m_n_read;
+    std::atomic<long long>       m_n_pushed;
+    std::atomic<long long>       m_n_dropped;
+    std::atomic<long long>       m_n_skipped;
+    std::atomic<int>             m_status;
+    EPolicy                      m_policy;
+    int                          m_n_sample;
+    SamplingController           m_controller;
+    bool                         m_is_end;
+    // previous printStatistics()
+    Statistics                   m_last_stat;
+    Clock::time_point            m_last_time;
+
+  public:
+    EventPipeline(int n_worker, event_processor processor,
+		  const std::vector<TH1*>& hist);
+    ~EventPipeline();
+
+    void       finish();
+    int        getNWorker() const;
+    EPolicy    getPolicy() const;
+    Statistics getStatistics() const;
+    int        getStatus();
+    void       merge();
+    void       printStatistics();
+    int        push();
+    void       runWorker(Worker* worker);
+    void       setBudget(double cpu, double latency);
+    void       setPolicy(EPolicy policy, int n_sample=1);
+    void       setSelector(event_selector selector);
+    void       start();
+
+  private:
+    EventPipeline(const EventPipeline&);
+    EventPipeline& operator=(const EventPipeline&);
+    EventSnapshot* acquire(Worker* worker, bool is_kept);
+    void           release(Worker* worker, EventSnapshot* event);
+    void           updateTitle();
+  };
+
+  //___________________________________________________________________________
+  inline int
+  EventPipeline::getNWorker() const
+  {
+    return m_worker.size();
+  }
+
+  //___________________________________________________________________________
+  inline EventPipeline::EPolicy
+  EventPipeline::getPolicy() const
+  {
+    return m_policy;
+  }
+
+}
+
+#endif
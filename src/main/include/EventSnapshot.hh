@@ -0,0 +1,248 @@
+// -*- C++ -*-
+
+#ifndef ANALYZER_EVENT_SNAPSHOT_H
+#define ANALYZER_EVENT_SNAPSHOT_H
+
+#include <string>
+#include <vector>
+
+namespace hddaq
+{
+  namespace unpacker
+  {
+    class DAQNode;
+  }
+}
+
+namespace analyzer
+{
+
+  //___________________________________________________________________________
+  // Copy of the digits of one unpacked event.
+  // The reader thread fills it from GUnpacker with capture(), then it is
+  // handed to a worker which reads it through the same accessors as
+  // GUnpacker (get_entries(), get(), get_node_header(), ...).
+  // Only the devices and node headers registered with registerDevice()
+  // and registerNodeHeader() are copied. Registering with the names of
+  // the data types read sizes the device from their unpacker IDs. A get()
+  // or get_entries() on a slot outside the registration returns 0 and
+  // is reported once.
+  //
+  // The non-empty channels of a device registered with with_hits are
+  // also kept as columns, one row per value in the order of capture
+  // (device, plane, segment, ch, data type, hit index), so the consumers
+  // can loop over the real hits only,
+  //
+  //   for (int i=event.get_hit_begin(id), n=event.get_hit_end(id);
+  //        i<n; ++i) {
+  //     ... event.get_hit_segment(i), event.get_hit_value(i) ...
+  //   }
+  //
+  // The other devices have no rows, get_hit_begin()==get_hit_end().
+  class EventSnapshot
+  {
+  public:
+    typedef unsigned int value_type;
+
+    struct Device
+    {
+      std::string name;
+      int         device_id;
+      int         n_plane;
+      int         n_segment;
+      int         n_ch;
+      int         n_data;
+      int         offset;
+      bool        with_hits;
+    };
+
+  private:
+    int                       m_event_number;
+    int                       m_counter;
+    // chosen by the event selector of EventPipeline, never dropped
+    bool                      m_is_kept;
+    // [channel index] -> first entry in m_value, size n_channel+1
+    std::vector<unsigned int> m_begin;
+    std::vector<value_type>   m_value;
+    // rows of the devices registered with_hits
+    std::vector<value_type>     m_hit_value;
+    std::vector<unsigned short> m_hit_plane;
+    std::vector<unsigned short> m_hit_segment;
+    std::vector<unsigned short> m_hit_ch;
+    std::vector<unsigned short> m_hit_data_type;
+    std::vector<unsigned short> m_hit_index;
+    // [device_id] -> rows of the device
+    std::vector<unsigned int> m_hit_begin;
+    std::vector<unsigned int> m_hit_end;
+    // DAQ nodes (root node first, then its children)
+    std::vector<int>          m_node_id;
+    std::vector<std::string>  m_node_name;
+    std::vector<value_type>   m_node_header;
+
+  public:
+    EventSnapshot();
+    ~EventSnapshot();
+
+    static void registerDevice(const std::string& name,
+			       int n_plane, int n_segment,
+			       int n_ch, int n_data,
+			       bool with_hits=false);
+    static void registerDevice(const std::string& name,
+			       int n_plane, int n_segment, int n_ch,
+			       const std::vector<std::string>& data,
+			       bool with_hits=false);
+    static void registerNodeHeader(int header_id);
+    static const std::vector<Device>& getDeviceList();
+    static bool hasHitRows(int device_id);
+
+    void         capture();
+    value_type   get(int device_id, int plane, int segment,
+		     int ch, int data_type, int index=0) const;
+    unsigned int get_entries(int device_id, int plane, int segment,
+			     int ch, int data_type) const;
+    int          get_counter() const;
+    int          get_event_number() const;
+    bool         is_kept() const;
+    void         set_kept(bool flag);
+    int          get_n_node() const;
+    int          get_node_id(int i) const;
+    const std::string& get_node_name(int i) const;
+    value_type   get_node_header(int node_id, int header_id) const;
+    // columnar access to the non-empty channels
+    int          get_n_hit() const;
+    int          get_hit_begin(int device_id) const;
+    int          get_hit_end(int device_id) const;
+    int          get_hit_plane(int i) const;
+    int          get_hit_segment(int i) const;
+    int          get_hit_ch(int i) const;
+    int          get_hit_data_type(int i) const;
+    int          get_hit_index(int i) const;
+    value_type   get_hit_value(int i) const;
+
+  private:
+    void       addNode(const hddaq::unpacker::DAQNode* node, std::size_t i);
+    static int channelIndex(int device_id, int plane, int segment,
+			    int ch, int data_type);
+    static void warnUnregistered(int device_id, int plane, int segment,
+				 int ch, int data_type);
+  };
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_counter() const
+  {
+    return m_counter;
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_event_number() const
+  {
+    return m_event_number;
+  }
+
+  //___________________________________________________________________________
+  inline bool
+  EventSnapshot::is_kept() const
+  {
+    return m_is_kept;
+  }
+
+  //___________________________________________________________________________
+  inline void
+  EventSnapshot::set_kept(bool flag)
+  {
+    m_is_kept = flag;
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_n_node() const
+  {
+    return m_node_id.size();
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_node_id(int i) const
+  {
+    return m_node_id[i];
+  }
+
+  //___________________________________________________________________________
+  inline const std::string&
+  EventSnapshot::get_node_name(int i) const
+  {
+    return m_node_name[i];
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_n_hit() const
+  {
+    return m_hit_value.size();
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_hit_begin(int device_id) const
+  {
+    if (device_id<0 || device_id>=static_cast<int>(m_hit_begin.size()))
+      return 0;
+    return m_hit_begin[device_id];
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_hit_end(int device_id) const
+  {
+    if (device_id<0 || device_id>=static_cast<int>(m_hit_end.size()))
+      return 0;
+    return m_hit_end[device_id];
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_hit_plane(int i) const
+  {
+    return m_hit_plane[i];
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_hit_segment(int i) const
+  {
+    return m_hit_segment[i];
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_hit_ch(int i) const
+  {
+    return m_hit_ch[i];
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_hit_data_type(int i) const
+  {
+    return m_hit_data_type[i];
+  }
+
+  //___________________________________________________________________________
+  inline int
+  EventSnapshot::get_hit_index(int i) const
+  {
+    return m_hit_index[i];
+  }
+
+  //___________________________________________________________________________
+  inline EventSnapshot::value_type
+  EventSnapshot::get_hit_value(int i) const
+  {
+    return m_hit_value[i];
+  }
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+// -*- C++ -*-
+
+#ifndef ANALYZER_HIST_SHARD_H
+#define ANALYZER_HIST_SHARD_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+class TH1;
+
+namespace analyzer
+{
+
+  //___________________________________________________________________________
+  // Thread-local stand-in for one booked histogram.
+  // Fill() has the semantics of TH1::Fill()/TH2::Fill() but only writes a
+  // private bin array (no lock, no ROOT call), so it can be called from a
+  // worker thread while the GUI draws the real histogram.
+  // The shard has two bin arrays: the filling thread writes the front one,
+  // swap() exchanges them between events and add() folds the back one into
+  // the ROOT histogram, which the caller must hold TThread::Lock() for.
+  // TProfile, TH2Poly and 3D histograms are not binned here, their fills
+  // are recorded and replayed by add(). A record longer than
+  // k_max_replay fills is replayed by the filling thread itself under
+  // TThread::Lock(), so the record stays bounded however rarely add()
+  // is called (batch mode).
+  class HistShard
+  {
+  private:
+    static const std::size_t k_max_replay = 1<<16;
+
+    struct Axis
+    {
+      int                 n_bin;
+      double              min;
+      double              max;
+      double              scale;  // n_bin/(max-min)
+      std::vector<double> edges;  // variable bins only
+    };
+
+    struct Buffer
+    {
+      std::vector<double> w;
+      std::vector<double> w2;
+      std::vector<double> fill;   // (n_arg, a, b, c) for replayed fills
+      double              stats[7];
+      double              entries;
+      bool                is_empty;
+    };
+
+    TH1*    m_hist;
+    int     m_dim;
+    bool    m_is_replay;
+    Axis    m_axis[2];
+    Buffer  m_buffer[2];
+    int     m_front;
+
+  public:
+    HistShard(TH1* hist);
+    ~HistShard();
+
+    TH1* GetHist() const;
+    int  Fill(double x);
+    int  Fill(double x, double y_or_w);
+    int  Fill(double x, double y, double w);
+
+    void add();
+    void swap();
+
+  private:
+    HistShard(const HistShard&);
+    HistShard& operator=(const HistShard&);
+    static void clear(Buffer& b);
+    static int  findBin(const Axis& axis, double x);
+    void        setAxis(int i);
+    int         fill1(double x, double w);
+    int         fill2(double x, double y, double w);
+    int         record(int n_arg, double a, double b, double c);
+    void        replay(Buffer& b);
+  };
+
+  //___________________________________________________________________________
+  inline TH1*
+  HistShard::GetHist() const
+  {
+    return m_hist;
+  }
+
+  //___________________________________________________________________________
+  inline int
+  HistShard::Fill(double x)
+  {
+    if (m_is_replay) return record(1, x, 0., 0.);
+    return (m_dim==1) ? fill1(x, 1.) : fill2(x, 0., 1.);
+  }
+
+  //___________________________________________________________________________
+  // same overload resolution as ROOT: (x, w) for 1D, (x, y) for 2D
+  inline int
+  HistShard::Fill(double x, double y_or_w)
+  {
+    if (m_is_replay) return record(2, x, y_or_w, 0.);
+    return (m_dim==1) ? fill1(x, y_or_w) : fill2(x, y_or_w, 1.);
+  }
+
+  //___________________________________________________________________________
+  inline int
+  HistShard::Fill(double x, double y, double w)
+  {
+    if (m_is_replay) return record(3, x, y, w);
+    return fill2(x, y, w);
+  }
+
+  //___________________________________________________________________________
+  // All shards of one filling thread, indexed by sequential ID like
+  // hptr_array. The filler calls flip() between events; merge() may be
+  // called from any thread and folds whatever the last flip handed over.
+  class HistShardSet
+  {
+  private:
+    enum EState { kRequested, kReady };
+
+    std::vector<HistShard*> m_shard;
+    std::atomic<int>        m_state;
+
+  public:
+    HistShardSet(const std::vector<TH1*>& hist);
+    ~HistShardSet();
+
+    std::vector<HistShard*>& get();
+    bool flip();
+    void flush();
+    bool isRequested() const;
+    void merge();
+
+  private:
+    HistShardSet(const HistShardSet&);
+    HistShardSet& operator=(const HistShardSet&);
+  };
+
+  //___________________________________________________________________________
+  inline std::vector<HistShard*>&
+  HistShardSet::get()
+  {
+    return m_shard;
+  }
+
+  //___________________________________________________________________________
+  inline bool
+  HistShardSet::isRequested() const
+  {
+    return m_state.load(std::memory_order_acquire)==kRequested;
+  }
+
+}
+
+#endif
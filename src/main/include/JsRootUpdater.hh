@@ -4,34 +4,83 @@
 #define HDDAQ__JSROOT_UPDATER_H
 
 #include <Rtypes.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <set>
+#include <vector>
 
+class TH1;
+class THttpServer;
 class TThread;
 
 namespace analyzer
 {
+  // Called by the publisher thread after each snapshot, e.g. to refit or
+  // redraw the efficiency texts on the published canvases.
+  typedef void (*publish_task)();
+
+  //___________________________________________________________________________
+  // Publisher thread of THttpServer.
+  // Once started, HTTP requests are processed only in this thread, every
+  // tick, and the histograms are snapshot every interval.
+  // With setHistBuffer() the event loop fills private copies of the
+  // registered histograms. When a snapshot is due, sync() copies them into
+  // the back buffer at the end of an event, and the publisher swaps the
+  // back buffer into the published (front) histograms between two ticks,
+  // so neither thread waits for the other and the served objects do not
+  // change while a request is processed.
+  // Without it the event loop is parked in sync() while the requests are
+  // processed, as when it called gSystem->ProcessEvents() itself. While
+  // the loop does not come to sync() (idle, no data) the requests are
+  // answered every tick anyway.
   class JsRootUpdater
   {
   private:
-    int      m_locked;
-    TThread* m_thread;
-    bool     m_during_update;
+    int                      m_locked;
+    TThread*                 m_thread;
+    bool                     m_during_update;
+    THttpServer*             m_server;
+    double                   m_interval;     // snapshot [s]
+    double                   m_tick;         // request processing [s]
+    std::vector<TH1*>        m_front;        // published
+    std::vector<TH1*>        m_back;         // last snapshot
+    std::vector<TH1*>        m_fill;         // filled by the event loop
+    std::vector<publish_task> m_task;
+    std::mutex               m_mutex;
+    std::condition_variable  m_cond;
+    std::atomic<bool>        m_is_requested; // sync() is due
+    std::atomic<bool>        m_is_reset;
+    bool                     m_is_synced;
+    bool                     m_is_released;
+    bool                     m_is_end;
 
   public:
     static JsRootUpdater& getInstance();
     virtual ~JsRootUpdater();
 
     static bool isUpdating();
+    void   addTask(publish_task task);
     int    join();
     void   lock();
+    void   requestReset();
     int    run();
+    void   setHistBuffer(std::vector<TH1*>& hist);
+    void   setInterval(double interval);
+    void   setServer(THttpServer* server);
     void   start();
+    void   stop();
+    void   sync();
     void   unlock();
 
   private:
     JsRootUpdater();
     JsRootUpdater(const JsRootUpdater&);
     JsRootUpdater& operator=(const JsRootUpdater&);
+    bool   acquire(double timeout);
+    void   release();
+    void   request();
+    bool   swap();
 
     ClassDef(analyzer::JsRootUpdater, 0)
   };
@@ -3,15 +3,22 @@
 #ifndef ANALYZER_MAIN_H
 #define ANALYZER_MAIN_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include <Rtypes.h>
 
+#include "user_analyzer.hh"
+
+class TH1;
 class TThread;
 
 namespace analyzer
 {
+  class EventPipeline;
 
   class Main
   {
@@ -25,13 +32,26 @@ namespace analyzer
       };
 
   private:
-    e_state                  m_state;
+    // m_state is written only through setState() so that the threads
+    // blocked in waitWhile() are woken on every transition
+    std::atomic<int>                m_state;
+    mutable std::mutex              m_state_mutex;
+    mutable std::condition_variable m_state_cond;
     std::vector<std::string> m_argv;
     TThread*                 m_thread;
     int                      m_count;
     bool                     m_is_overwrite;
     bool                     m_is_batch;
     bool                     m_is_jsroot;
+    int                      m_n_worker;
+    int                      m_queue_policy; // EventPipeline::EPolicy
+    int                      m_n_sample;
+    double                   m_cpu_budget;
+    double                   m_latency_budget;
+    event_selector           m_selector;
+    event_processor          m_processor;
+    std::vector<TH1*>*       m_hist;
+    EventPipeline*           m_pipeline;
 
   public:
     static Main& getInstance();
@@ -40,6 +60,8 @@ namespace analyzer
     void hoge() const;
     const std::vector<std::string>& getArgv() const;
     int  getCounter() const;
+    int  getNWorker() const;
+    e_state getState() const;
 //     void initialize(int argc,
 // 		    char* argv[]);
     void initialize(const std::vector<std::string>& argV);
@@ -50,19 +72,29 @@ namespace analyzer
     bool isRunning() const;
     bool isZombie() const;
     int  join();
+    void mergeHistograms();
     int  run();
     void setBatchMode(bool flag);
+    void setEventProcessor(event_processor processor,
+			   std::vector<TH1*>& hist);
     void setForceOverwrite(bool flag);
+    void setEventSelector(event_selector selector);
+    void setNWorker(int n);
+    void setSamplingBudget(double cpu, double latency);
+    void setQueuePolicy(int policy, int n_sample=1);
     void start();
     void stat();
     void stop();
     void suspend();
+    e_state waitWhile(e_state state, double timeout=-1.) const;
     double get_dtime();
 
   private:
     Main();
     Main(const Main&);
     Main& operator=(const Main&);
+    int  processEvent();
+    void setState(e_state state);
 
     ClassDef(analyzer::Main, 0)
 
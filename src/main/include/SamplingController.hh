@@ -0,0 +1,76 @@
+// -*- C++ -*-
+
+#ifndef ANALYZER_SAMPLING_CONTROLLER_H
+#define ANALYZER_SAMPLING_CONTROLLER_H
+
+#include <chrono>
+
+namespace analyzer
+{
+
+  //___________________________________________________________________________
+  // Fraction of the events to analyze, adjusted from the measured input
+  // rate and the cost of one event so that the workers stay within
+  // a CPU and a latency budget.
+  //   cpu      fraction of the time of each worker to spend on events
+  //   latency  seconds an event may wait in the queues
+  // The reader calls update() with the counters of EventPipeline, at most
+  // once per k_period, and accept() once per event. accept() spreads the
+  // accepted events evenly instead of drawing random numbers, so a given
+  // fraction always keeps the same events of a run.
+  class SamplingController
+  {
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    double            m_cpu;
+    double            m_latency;
+    double            m_fraction;
+    double            m_credit;
+    double            m_cost;      // seconds per event and worker
+    // at the previous update()
+    Clock::time_point m_time;
+    long long         m_n_read;
+    long long         m_n_processed;
+    double            m_busy;
+
+  public:
+    SamplingController();
+    ~SamplingController();
+
+    bool   accept();
+    double getCost() const;
+    double getFraction() const;
+    void   setBudget(double cpu, double latency);
+    bool   update(long long n_read, long long n_processed, double busy,
+		  int depth, int n_worker);
+  };
+
+  //___________________________________________________________________________
+  inline bool
+  SamplingController::accept()
+  {
+    m_credit += m_fraction;
+    if (m_credit<1.)
+      return false;
+    m_credit -= 1.;
+    return true;
+  }
+
+  //___________________________________________________________________________
+  inline double
+  SamplingController::getCost() const
+  {
+    return m_cost;
+  }
+
+  //___________________________________________________________________________
+  inline double
+  SamplingController::getFraction() const
+  {
+    return m_fraction;
+  }
+
+}
+
+#endif
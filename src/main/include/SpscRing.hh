@@ -0,0 +1,147 @@
+// -*- C++ -*-
+
+#ifndef ANALYZER_SPSC_RING_H
+#define ANALYZER_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace analyzer
+{
+
+  //___________________________________________________________________________
+  // Bounded lock-free ring between one producer and one consumer, for
+  // pointers and other small trivially copyable values.
+  // push() is called by the producer only. pop() is called by the
+  // consumer, and may also be called by the producer to take back the
+  // oldest element when the ring is full (drop-oldest): the read index
+  // is advanced by compare-and-swap, so each element goes to exactly one
+  // of them. pop_if() only takes the oldest element if the predicate
+  // accepts it. The capacity is rounded up to a power of 2.
+  template <typename T>
+  class SpscRing
+  {
+  private:
+    static const std::size_t k_cache_line = 64;
+
+    std::size_t                     m_capacity;
+    std::size_t                     m_mask;
+    std::unique_ptr<std::atomic<T>[]> m_slot;
+    alignas(k_cache_line) std::atomic<std::size_t> m_head; // next write
+    alignas(k_cache_line) std::atomic<std::size_t> m_tail; // next read
+
+  public:
+    explicit SpscRing(std::size_t capacity);
+
+    std::size_t capacity() const;
+    bool        empty() const;
+    bool        pop(T& value);
+    template <typename Predicate>
+    bool        pop_if(T& value, Predicate predicate);
+    bool        push(const T& value);
+    std::size_t size() const;
+
+  private:
+    SpscRing(const SpscRing&);
+    SpscRing& operator=(const SpscRing&);
+  };
+
+  //___________________________________________________________________________
+  template <typename T>
+  inline
+  SpscRing<T>::SpscRing(std::size_t capacity)
+    : m_capacity(1),
+      m_mask(0),
+      m_slot(),
+      m_head(0),
+      m_tail(0)
+  {
+    while (m_capacity<capacity)
+      m_capacity <<= 1;
+    m_mask = m_capacity-1;
+    m_slot.reset(new std::atomic<T>[m_capacity]);
+  }
+
+  //___________________________________________________________________________
+  template <typename T>
+  inline std::size_t
+  SpscRing<T>::capacity() const
+  {
+    return m_capacity;
+  }
+
+  //___________________________________________________________________________
+  template <typename T>
+  inline bool
+  SpscRing<T>::empty() const
+  {
+    return m_tail.load(std::memory_order_acquire)
+      ==   m_head.load(std::memory_order_acquire);
+  }
+
+  //___________________________________________________________________________
+  template <typename T>
+  inline bool
+  SpscRing<T>::pop(T& value)
+  {
+    std::size_t tail = m_tail.load(std::memory_order_acquire);
+    for (;;) {
+      if (tail==m_head.load(std::memory_order_acquire))
+	return false;
+      value = m_slot[tail & m_mask].load(std::memory_order_relaxed);
+      // on failure tail is reloaded, the other side took the element
+      if (m_tail.compare_exchange_weak(tail, tail+1,
+				       std::memory_order_acq_rel,
+				       std::memory_order_acquire))
+	return true;
+    }
+  }
+
+  //___________________________________________________________________________
+  template <typename T>
+  template <typename Predicate>
+  inline bool
+  SpscRing<T>::pop_if(T& value, Predicate predicate)
+  {
+    std::size_t tail = m_tail.load(std::memory_order_acquire);
+    for (;;) {
+      if (tail==m_head.load(std::memory_order_acquire))
+	return false;
+      const T oldest = m_slot[tail & m_mask].load(std::memory_order_relaxed);
+      if (!predicate(oldest))
+	return false;
+      if (m_tail.compare_exchange_weak(tail, tail+1,
+				       std::memory_order_acq_rel,
+				       std::memory_order_acquire)) {
+	value = oldest;
+	return true;
+      }
+    }
+  }
+
+  //___________________________________________________________________________
+  template <typename T>
+  inline bool
+  SpscRing<T>::push(const T& value)
+  {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head-m_tail.load(std::memory_order_acquire)>=m_capacity)
+      return false;
+    m_slot[head & m_mask].store(value, std::memory_order_relaxed);
+    m_head.store(head+1, std::memory_order_release);
+    return true;
+  }
+
+  //___________________________________________________________________________
+  template <typename T>
+  inline std::size_t
+  SpscRing<T>::size() const
+  {
+    const std::size_t tail = m_tail.load(std::memory_order_acquire);
+    return m_head.load(std::memory_order_acquire)-tail;
+  }
+
+}
+
+#endif
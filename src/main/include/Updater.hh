@@ -4,6 +4,7 @@
 #define HDDAQ__UPDATER_H
 
 #include <Rtypes.h>
+#include <atomic>
 #include <set>
 
 class TThread;
@@ -40,7 +41,7 @@ namespace hddaq
     double   m_refresh_interval;
     int      m_mode;
     int      m_locked;
-    e_state  m_state;
+    std::atomic<int> m_state;
     TThread* m_thread;
     bool     m_during_update;
     //    TMutex*  m_mutex;
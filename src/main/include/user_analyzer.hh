@@ -6,9 +6,26 @@
 #include <string>
 #include <vector>
 
+class TH1;
 
 namespace analyzer
 {
+  class EventSnapshot;
+  class HistShard;
+
+  // Per-event entry point which reads the event from a snapshot and fills
+  // the worker's histogram shards (indexed like hptr_array), so that it can
+  // run on the worker threads.
+  // Registered in process_begin() with Main::setEventProcessor().
+  typedef int (*event_processor)(const EventSnapshot& event,
+				 std::vector<HistShard*>& hist);
+
+  // Called on the reader thread before an event is captured, reads
+  // GUnpacker. The events it selects are never skipped by the sampling
+  // of the event pipeline (e.g. spill ends carrying the scalers).
+  // Registered in process_begin() with Main::setEventSelector().
+  typedef bool (*event_selector)();
+
   void checkFileExistence(const std::string& filename);
   void closeTFile(int arg=0);
   int  process_begin(const std::vector<std::string>& argv);
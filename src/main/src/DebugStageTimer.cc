@@ -0,0 +1,210 @@
+// -*- C++ -*-
+
+#include "DebugStageTimer.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include <std_ostream.hh>
+
+namespace debug
+{
+  namespace
+  {
+    const char* StageName[kNStage] =
+      {
+	"Unpack",
+	"Capture",
+	"Event",
+	"RawDecode",
+	"DCDecode",
+	"TrackBcIn",
+	"TrackBcOut",
+	"TrackSdcIn",
+	"TrackSdcOut",
+	"TrackK18",
+	"TrackKurama",
+	"KuramaFit",
+	"HistMerge",
+	"Snapshot",
+	"Update",
+	"Publish"
+      };
+
+    // profiles of all threads, kept after the thread exits so that the
+    // summary at process_end() includes the joined workers
+    std::mutex                 g_mutex;
+    std::vector<StageProfile*> g_profile;
+
+    //___________________________________________________________________
+    std::string
+    FormatTime( double ns )
+    {
+      char buf[32];
+      if( ns<1.e3 )
+	std::snprintf( buf, sizeof(buf), "%7.0f ns", ns );
+      else if( ns<1.e6 )
+	std::snprintf( buf, sizeof(buf), "%7.2f us", ns*1.e-3 );
+      else if( ns<1.e9 )
+	std::snprintf( buf, sizeof(buf), "%7.2f ms", ns*1.e-6 );
+      else
+	std::snprintf( buf, sizeof(buf), "%7.2f  s", ns*1.e-9 );
+      return buf;
+    }
+  }
+
+  //___________________________________________________________________
+  StageProfile&
+  StageProfile::GetInstance( void )
+  {
+    static thread_local StageProfile* g_instance = 0;
+    if( !g_instance ){
+      g_instance = new StageProfile;
+      std::lock_guard<std::mutex> lock( g_mutex );
+      g_profile.push_back( g_instance );
+    }
+    return *g_instance;
+  }
+
+  //___________________________________________________________________
+  StageProfile::StageProfile( void )
+  {
+    for( int s=0; s<kNStage; ++s ){
+      for( int i=0; i<NBucket; ++i )
+	m_count[s][i].store( 0, std::memory_order_relaxed );
+      m_sum[s].store( 0, std::memory_order_relaxed );
+      m_max[s].store( 0, std::memory_order_relaxed );
+    }
+  }
+
+  //___________________________________________________________________
+  StageProfile::~StageProfile( void )
+  {
+  }
+
+  //___________________________________________________________________
+  StageProfile::Summary
+  StageProfile::get( EStage stage )
+  {
+    std::vector<unsigned long long> count( NBucket, 0 );
+    Summary ret = { 0, 0., 0., 0., 0., 0. };
+    double sum = 0.;
+    {
+      std::lock_guard<std::mutex> lock( g_mutex );
+      for( std::size_t t=0, n=g_profile.size(); t<n; ++t ){
+	const StageProfile* p = g_profile[t];
+	for( int i=0; i<NBucket; ++i ){
+	  const unsigned long long c
+	    = p->m_count[stage][i].load( std::memory_order_relaxed );
+	  count[i]  += c;
+	  ret.count += c;
+	}
+	sum += p->m_sum[stage].load( std::memory_order_relaxed );
+	const double max = p->m_max[stage].load( std::memory_order_relaxed );
+	if( max>ret.max ) ret.max = max;
+      }
+    }
+    if( ret.count==0 )
+      return ret;
+
+    ret.mean = sum/ret.count;
+    const double fraction[3] = { 0.50, 0.90, 0.99 };
+    double*      value[3]    = { &ret.p50, &ret.p90, &ret.p99 };
+    unsigned long long cumulative = 0;
+    int k = 0;
+    for( int i=0; i<NBucket && k<3; ++i ){
+      if( count[i]==0 ) continue;
+      const unsigned long long prev = cumulative;
+      cumulative += count[i];
+      while( k<3 && cumulative>=fraction[k]*ret.count ){
+	// linear inside the bucket
+	const double lo = lower_edge(i);
+	const double hi = lower_edge(i+1);
+	const double x  = ( fraction[k]*ret.count - prev )/count[i];
+	*value[k] = std::min( lo + x*(hi-lo), ret.max );
+	++k;
+      }
+    }
+    return ret;
+  }
+
+  //___________________________________________________________________
+  double
+  StageProfile::lower_edge( int i )
+  {
+    const int n = 1<<SubBits;
+    if( i<n )
+      return i;
+    const int octave = i>>SubBits;
+    const int sub    = i&(n-1);
+    return std::ldexp( double(n+sub), octave-1 );
+  }
+
+  //___________________________________________________________________
+  const char*
+  StageProfile::name( EStage stage )
+  {
+    if( stage<0 || stage>=kNStage )
+      return "Unknown";
+    return StageName[stage];
+  }
+
+  //___________________________________________________________________
+  void
+  StageProfile::print( const std::string& arg, std::ostream& ost )
+  {
+    ost << "#D StageProfile " << arg << std::endl
+	<< table();
+  }
+
+  //___________________________________________________________________
+  // Only approximate while the owners are filling, an entry added at the
+  // same time may survive.
+  void
+  StageProfile::reset( void )
+  {
+    std::lock_guard<std::mutex> lock( g_mutex );
+    for( std::size_t t=0, n=g_profile.size(); t<n; ++t ){
+      StageProfile* p = g_profile[t];
+      for( int s=0; s<kNStage; ++s ){
+	for( int i=0; i<NBucket; ++i )
+	  p->m_count[s][i].store( 0, std::memory_order_relaxed );
+	p->m_sum[s].store( 0, std::memory_order_relaxed );
+	p->m_max[s].store( 0, std::memory_order_relaxed );
+      }
+    }
+  }
+
+  //___________________________________________________________________
+  std::string
+  StageProfile::table( void )
+  {
+    std::ostringstream oss;
+    oss << "   " << std::left << std::setw(12) << "Stage" << std::right
+	<< std::setw(9) << "Count"
+	<< std::setw(12) << "Mean"
+	<< std::setw(12) << "50%"
+	<< std::setw(12) << "90%"
+	<< std::setw(12) << "99%"
+	<< std::setw(12) << "Max" << std::endl;
+    for( int s=0; s<kNStage; ++s ){
+      const Summary& r = get( EStage(s) );
+      if( r.count==0 )
+	continue;
+      oss << "   " << std::left << std::setw(12) << StageName[s]
+	  << std::right << std::setw(9) << r.count
+	  << std::setw(12) << FormatTime(r.mean)
+	  << std::setw(12) << FormatTime(r.p50)
+	  << std::setw(12) << FormatTime(r.p90)
+	  << std::setw(12) << FormatTime(r.p99)
+	  << std::setw(12) << FormatTime(r.max) << std::endl;
+    }
+    return oss.str();
+  }
+
+}
@@ -0,0 +1,438 @@
+// -*- C++ -*-
+
+#include "EventPipeline.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <TH1.h>
+#include <TROOT.h>
+#include <TThread.h>
+
+#include "DebugStageTimer.hh"
+
+namespace analyzer
+{
+  namespace
+  {
+    // snapshots in flight per worker
+    const int k_queue_depth = 4;
+    // events read between two SamplingController::update()
+    const int k_update_interval = 64;
+
+    const char* k_policy_name[EventPipeline::kNPolicy] =
+      { "block", "drop-oldest", "sample", "adaptive" };
+
+    //_________________________________________________________________________
+    void
+    thread_function(void* arg)
+    {
+      EventPipeline::Worker* worker
+	= reinterpret_cast<EventPipeline::Worker*>(arg);
+      worker->pipeline->runWorker(worker);
+      return;
+    }
+  }
+
+//_____________________________________________________________________________
+EventPipeline::EventPipeline(int n_worker, event_processor processor,
+			     const std::vector<TH1*>& hist)
+  : m_processor(processor),
+    m_selector(0),
+    m_hist(hist),
+    m_title(),
+    m_title_permil(1000),
+    m_worker(),
+    m_buffer(),
+    m_mutex(),
+    m_cond_queue(),
+    m_cond_free(),
+    m_is_reader_waiting(false),
+    m_n_read(0),
+    m_n_pushed(0),
+    m_n_dropped(0),
+    m_n_skipped(0),
+    m_status(0),
+    m_policy(kBlock),
+    m_n_sample(1),
+    m_controller(),
+    m_is_end(false),
+    m_last_stat(),
+    m_last_time(Clock::now())
+{
+  for (int i=0; i<n_worker; ++i) {
+    Worker* w   = new Worker;
+    w->id       = i;
+    w->pipeline = this;
+    w->thread   = 0;
+    w->queue    = new Ring(k_queue_depth);
+    // one more snapshot for the event being analyzed
+    w->free     = new Ring(k_queue_depth+1);
+    w->shard    = new HistShardSet(hist);
+    w->is_waiting  = false;
+    w->n_processed = 0;
+    w->busy_ns     = 0;
+    for (int j=0; j<k_queue_depth+1; ++j) {
+      EventSnapshot* event = new EventSnapshot;
+      m_buffer.push_back(event);
+      w->free->push(event);
+    }
+    m_worker.push_back(w);
+  }
+  for (const auto& h : m_hist)
+    m_title.push_back(h ? h->GetTitle() : "");
+  m_last_stat = getStatistics();
+}
+
+//_____________________________________________________________________________
+EventPipeline::~EventPipeline()
+{
+  finish();
+  for (auto& w : m_worker) {
+    delete w->shard;
+    delete w->queue;
+    delete w->free;
+    delete w->thread;
+    delete w;
+    w = 0;
+  }
+  for (auto& event : m_buffer) {
+    delete event;
+    event = 0;
+  }
+}
+
+//_____________________________________________________________________________
+// Snapshot for the next event of the worker, 0 if the event is skipped or
+// the analysis stopped.
+EventSnapshot*
+EventPipeline::acquire(Worker* worker, bool is_kept)
+{
+  EventSnapshot* event = 0;
+  if (worker->free->pop(event))
+    return event;
+
+  // the queue of the worker is full
+  if (!is_kept) {
+    if ((m_policy==kSample && (m_n_read-1)%m_n_sample!=0) ||
+	m_policy==kAdaptive) {
+      ++m_n_skipped;
+      return 0;
+    }
+    // a kept event at the head of the queue is waited for instead
+    if ((m_policy==kDropOldest || m_policy==kSample) &&
+	worker->queue->pop_if(event, [](const EventSnapshot* e)
+			      { return !e->is_kept(); })) {
+      ++m_n_dropped;
+      return event;
+    }
+  }
+
+  // kBlock, or the worker took the oldest one first and frees it soon
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_is_reader_waiting = true;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  m_cond_free.wait(lock, [this, worker]
+		   { return !worker->free->empty() || m_status!=0; });
+  m_is_reader_waiting = false;
+  if (m_status!=0)
+    return 0;
+  worker->free->pop(event);
+  return event;
+}
+
+//_____________________________________________________________________________
+void
+EventPipeline::finish()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_is_end)
+      return;
+    m_is_end = true;
+  }
+  m_cond_queue.notify_all();
+  for (auto& w : m_worker) {
+    if (w->thread)
+      w->thread->Join();
+  }
+  TThread::Lock();
+  for (auto& w : m_worker)
+    w->shard->flush();
+  updateTitle();
+  TThread::UnLock();
+  std::cout << "#D EventPipeline::finish() " << m_n_pushed
+	    << " events processed by " << m_worker.size()
+	    << " workers" << std::endl;
+  printStatistics();
+  return;
+}
+
+//_____________________________________________________________________________
+EventPipeline::Statistics
+EventPipeline::getStatistics() const
+{
+  Statistics stat;
+  stat.n_read      = m_n_read;
+  stat.n_pushed    = m_n_pushed;
+  stat.n_processed = 0;
+  stat.n_dropped   = m_n_dropped;
+  stat.n_skipped   = m_n_skipped;
+  stat.depth       = 0;
+  stat.capacity    = 0;
+  stat.busy        = 0.;
+  for (const auto& w : m_worker) {
+    stat.n_processed += w->n_processed;
+    stat.busy        += w->busy_ns*1.e-9;
+    stat.depth       += w->queue->size();
+    stat.capacity    += w->queue->capacity();
+  }
+  return stat;
+}
+
+//_____________________________________________________________________________
+int
+EventPipeline::getStatus()
+{
+  return m_status;
+}
+
+//_____________________________________________________________________________
+void
+EventPipeline::merge()
+{
+  TThread::Lock();
+  {
+    debug::StageTimer timer(debug::kHistMerge);
+    for (auto& w : m_worker)
+      w->shard->merge();
+    updateTitle();
+  }
+  TThread::UnLock();
+  // wake up idle workers to hand over their last events
+  { std::lock_guard<std::mutex> lock(m_mutex); }
+  m_cond_queue.notify_all();
+  return;
+}
+
+//_____________________________________________________________________________
+// Counters and the rates since the previous call.
+void
+EventPipeline::printStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const Statistics  stat = getStatistics();
+  const Clock::time_point now = Clock::now();
+  const double dt = std::chrono::duration<double>(now-m_last_time).count();
+  const double f  = (dt>0.) ? 1./dt : 0.;
+  std::cout << "#D EventPipeline " << k_policy_name[m_policy];
+  if (m_policy==kSample)
+    std::cout << "(" << m_n_sample << ")";
+  std::cout << ", queue " << stat.depth << "/" << stat.capacity << std::endl
+	    << "   read      " << std::setw(10) << stat.n_read
+	    << "  " << (stat.n_read-m_last_stat.n_read)*f << " /s" << std::endl
+	    << "   processed " << std::setw(10) << stat.n_processed
+	    << "  " << (stat.n_processed-m_last_stat.n_processed)*f << " /s"
+	    << std::endl
+	    << "   dropped   " << std::setw(10) << stat.n_dropped
+	    << "  " << (stat.n_dropped-m_last_stat.n_dropped)*f << " /s"
+	    << std::endl
+	    << "   skipped   " << std::setw(10) << stat.n_skipped
+	    << "  " << (stat.n_skipped-m_last_stat.n_skipped)*f << " /s"
+	    << std::endl;
+  if (stat.n_read>0)
+    std::cout << "   analyzed  "
+	      << 100.*(stat.n_read-stat.n_skipped-stat.n_dropped)/stat.n_read
+	      << " %";
+  if (m_policy==kAdaptive)
+    std::cout << ", target " << 100.*m_controller.getFraction() << " %"
+	      << ", " << 1.e3*m_controller.getCost() << " ms/event";
+  std::cout << std::endl;
+  m_last_stat = stat;
+  m_last_time = now;
+  return;
+}
+
+//_____________________________________________________________________________
+int
+EventPipeline::push()
+{
+  if (m_status!=0)
+    return m_status;
+  ++m_n_read;
+
+  const bool is_kept = m_selector && m_selector();
+  if (m_policy==kAdaptive) {
+    if (m_n_read%k_update_interval==0) {
+      const Statistics stat = getStatistics();
+      m_controller.update(stat.n_read, stat.n_processed, stat.busy,
+			  stat.depth, m_worker.size());
+    }
+    if (!m_controller.accept() && !is_kept) {
+      ++m_n_skipped;
+      return 0;
+    }
+  }
+
+  Worker* w = m_worker[m_n_pushed % m_worker.size()];
+  EventSnapshot* event = acquire(w, is_kept);
+  if (!event)
+    return m_status;
+  event->set_kept(is_kept);
+
+  {
+    debug::StageTimer timer(debug::kCapture);
+    event->capture();
+  }
+
+  w->queue->push(event);
+  ++m_n_pushed;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (w->is_waiting) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cond_queue.notify_all();
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+void
+EventPipeline::release(Worker* worker, EventSnapshot* event)
+{
+  worker->free->push(event);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_is_reader_waiting) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cond_free.notify_all();
+  }
+  return;
+}
+
+//_____________________________________________________________________________
+void
+EventPipeline::runWorker(Worker* worker)
+{
+  for (;;) {
+    EventSnapshot* event = 0;
+    if (!worker->queue->pop(event)) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      worker->is_waiting = true;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      m_cond_queue.wait(lock, [this, worker]
+			{ return !worker->queue->empty() || m_is_end ||
+			    worker->shard->isRequested(); });
+      worker->is_waiting = false;
+      if (worker->queue->empty() && m_is_end)
+	break;
+      // may fail if the reader dropped it meanwhile
+      worker->queue->pop(event);
+    }
+
+    worker->shard->flip();
+    if (!event)
+      continue;
+
+    int ret = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    {
+      debug::StageTimer timer(debug::kEvent);
+      ret = m_processor(*event, worker->shard->get());
+    }
+    worker->busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>
+      (std::chrono::steady_clock::now()-t0).count();
+    ++worker->n_processed;
+    release(worker, event);
+
+    if (ret!=0) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_status==0) {
+	std::cout << "#D EventPipeline worker " << worker->id
+		  << " analyzer::process_event() return " << ret << std::endl;
+	m_status = ret;
+      }
+      m_cond_free.notify_all();
+    }
+  }
+  return;
+}
+
+//_____________________________________________________________________________
+// Called before start(), see SamplingController.
+void
+EventPipeline::setBudget(double cpu, double latency)
+{
+  m_controller.setBudget(cpu, latency);
+  return;
+}
+
+//_____________________________________________________________________________
+// Called before start().
+void
+EventPipeline::setPolicy(EPolicy policy, int n_sample)
+{
+  m_policy   = policy;
+  m_n_sample = (n_sample>1) ? n_sample : 1;
+  return;
+}
+
+//_____________________________________________________________________________
+// Called before start().
+void
+EventPipeline::setSelector(event_selector selector)
+{
+  m_selector = selector;
+  return;
+}
+
+//_____________________________________________________________________________
+void
+EventPipeline::start()
+{
+  ROOT::EnableThreadSafety();
+  for (auto& w : m_worker) {
+    if (w->thread)
+      continue;
+    const std::string name = "EventWorker" + std::to_string(w->id);
+    w->thread = new TThread(name.c_str(), &thread_function,
+			    reinterpret_cast<void*>(w));
+    w->thread->Run();
+  }
+  return;
+}
+
+//_____________________________________________________________________________
+// Appends the fraction of the events analyzed so far (not skipped nor
+// dropped) to the titles, as "title [analyzed 12.3%]" (before the axis
+// titles), when it changed by 0.1% or more, and restores the original
+// titles when no event was lost. Called with TThread::Lock() held.
+void
+EventPipeline::updateTitle()
+{
+  // the events still queued are not lost
+  const long long n_read = m_n_read;
+  const long long n_lost = m_n_skipped + m_n_dropped;
+  if (n_read<=0)
+    return;
+  const int permil = (n_lost==0) ? 1000 :
+    std::min(999, static_cast<int>(1000.*(n_read-n_lost)/n_read));
+  if (permil==m_title_permil)
+    return;
+  m_title_permil = permil;
+
+  char tag[64] = "";
+  if (permil<1000)
+    std::snprintf(tag, sizeof(tag), " [analyzed %.1f%%]", 0.1*permil);
+  for (std::size_t i=0, n=m_hist.size(); i<n; ++i) {
+    if (!m_hist[i])
+      continue;
+    std::string title = m_title[i];
+    title.insert(std::min(title.find(';'), title.size()), tag);
+    m_hist[i]->SetTitle(title.c_str());
+  }
+  return;
+}
+
+}
@@ -0,0 +1,304 @@
+// -*- C++ -*-
+
+#include "EventSnapshot.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+#include <DAQNode.hh>
+#include <UnpackerManager.hh>
+
+namespace analyzer
+{
+  namespace
+  {
+    typedef hddaq::unpacker::UnpackerManager UnpackerManager;
+    typedef hddaq::unpacker::GUnpacker       GUnpacker;
+    typedef hddaq::unpacker::DAQNode         DAQNode;
+
+    // registered before the event loop starts, read-only afterwards
+    std::vector<EventSnapshot::Device> g_device;
+    std::vector<int>                   g_device_index; // [device_id]
+    int                                g_n_channel = 0;
+    std::vector<int>                   g_node_header_id;
+    std::atomic<bool>                  g_is_warned(false);
+  }
+
+//_____________________________________________________________________________
+EventSnapshot::EventSnapshot()
+  : m_event_number(-1),
+    m_counter(-1),
+    m_is_kept(false),
+    m_begin(),
+    m_value(),
+    m_hit_value(),
+    m_hit_plane(),
+    m_hit_segment(),
+    m_hit_ch(),
+    m_hit_data_type(),
+    m_hit_index(),
+    m_hit_begin(),
+    m_hit_end(),
+    m_node_id(),
+    m_node_name(),
+    m_node_header()
+{
+}
+
+//_____________________________________________________________________________
+EventSnapshot::~EventSnapshot()
+{
+}
+
+//_____________________________________________________________________________
+void
+EventSnapshot::registerDevice(const std::string& name,
+			      int n_plane, int n_segment,
+			      int n_ch, int n_data, bool with_hits)
+{
+  const UnpackerManager& g_unpacker = GUnpacker::get_instance();
+  const int device_id = g_unpacker.get_device_id(name);
+  if (device_id<0) {
+    std::cerr << "#W EventSnapshot::registerDevice() unknown device : "
+	      << name << std::endl;
+    return;
+  }
+  if (device_id<static_cast<int>(g_device_index.size()) &&
+      g_device_index[device_id]>=0) {
+    std::cerr << "#W EventSnapshot::registerDevice() already registered : "
+	      << name << std::endl;
+    return;
+  }
+
+  Device d;
+  d.name      = name;
+  d.device_id = device_id;
+  d.n_plane   = n_plane;
+  d.n_segment = n_segment;
+  d.n_ch      = n_ch;
+  d.n_data    = n_data;
+  d.offset    = g_n_channel;
+  d.with_hits = with_hits;
+  g_n_channel += n_plane*n_segment*n_ch*n_data;
+
+  if (device_id>=static_cast<int>(g_device_index.size()))
+    g_device_index.resize(device_id+1, -1);
+  g_device_index[device_id] = g_device.size();
+  g_device.push_back(d);
+  return;
+}
+
+//_____________________________________________________________________________
+void
+EventSnapshot::registerDevice(const std::string& name,
+			      int n_plane, int n_segment, int n_ch,
+			      const std::vector<std::string>& data,
+			      bool with_hits)
+{
+  const UnpackerManager& g_unpacker = GUnpacker::get_instance();
+  int n_data = 0;
+  for (const auto& d : data) {
+    const int data_id = g_unpacker.get_data_id(name, d);
+    if (data_id<0) {
+      std::cerr << "#W EventSnapshot::registerDevice() unknown data type : "
+		<< name << " " << d << std::endl;
+      continue;
+    }
+    n_data = std::max(n_data, data_id+1);
+  }
+  registerDevice(name, n_plane, n_segment, n_ch, n_data, with_hits);
+  return;
+}
+
+//_____________________________________________________________________________
+void
+EventSnapshot::registerNodeHeader(int header_id)
+{
+  for (const auto& h : g_node_header_id)
+    if (h==header_id) return;
+  g_node_header_id.push_back(header_id);
+  return;
+}
+
+//_____________________________________________________________________________
+const std::vector<EventSnapshot::Device>&
+EventSnapshot::getDeviceList()
+{
+  return g_device;
+}
+
+//_____________________________________________________________________________
+bool
+EventSnapshot::hasHitRows(int device_id)
+{
+  if (device_id<0 || device_id>=static_cast<int>(g_device_index.size()))
+    return false;
+  const int i = g_device_index[device_id];
+  return i>=0 && g_device[i].with_hits;
+}
+
+//_____________________________________________________________________________
+int
+EventSnapshot::channelIndex(int device_id, int plane, int segment,
+			    int ch, int data_type)
+{
+  if (device_id<0 || device_id>=static_cast<int>(g_device_index.size()))
+    return -1;
+  const int i = g_device_index[device_id];
+  if (i<0)
+    return -1;
+  const Device& d = g_device[i];
+  if (plane<0     || plane>=d.n_plane     ||
+      segment<0   || segment>=d.n_segment ||
+      ch<0        || ch>=d.n_ch           ||
+      data_type<0 || data_type>=d.n_data)
+    return -1;
+  return d.offset
+    + ((plane*d.n_segment + segment)*d.n_ch + ch)*d.n_data + data_type;
+}
+
+//_____________________________________________________________________________
+void
+EventSnapshot::capture()
+{
+  const UnpackerManager& g_unpacker = GUnpacker::get_instance();
+  m_event_number = g_unpacker.get_event_number();
+  m_counter      = g_unpacker.get_counter();
+
+  // buffers are recycled, so steady state does no allocation
+  m_begin.resize(g_n_channel+1);
+  m_value.clear();
+  m_hit_value.clear();
+  m_hit_plane.clear();
+  m_hit_segment.clear();
+  m_hit_ch.clear();
+  m_hit_data_type.clear();
+  m_hit_index.clear();
+  m_hit_begin.assign(g_device_index.size(), 0);
+  m_hit_end.assign(g_device_index.size(), 0);
+  int index = 0;
+  for (const auto& d : g_device) {
+    m_hit_begin[d.device_id] = m_hit_value.size();
+    for (int plane=0; plane<d.n_plane; ++plane) {
+      for (int seg=0; seg<d.n_segment; ++seg) {
+	for (int ch=0; ch<d.n_ch; ++ch) {
+	  for (int data=0; data<d.n_data; ++data) {
+	    m_begin[index++] = m_value.size();
+	    const int n = g_unpacker.get_entries(d.device_id, plane,
+						 seg, ch, data);
+	    for (int m=0; m<n; ++m) {
+	      const value_type value = g_unpacker.get(d.device_id, plane,
+						      seg, ch, data, m);
+	      m_value.push_back(value);
+	      if (!d.with_hits)
+		continue;
+	      m_hit_value.push_back(value);
+	      m_hit_plane.push_back(plane);
+	      m_hit_segment.push_back(seg);
+	      m_hit_ch.push_back(ch);
+	      m_hit_data_type.push_back(data);
+	      m_hit_index.push_back(m);
+	    }
+	  }
+	}
+      }
+    }
+    m_hit_end[d.device_id] = m_hit_value.size();
+  }
+  m_begin[index] = m_value.size();
+
+  if (g_node_header_id.empty())
+    return;
+
+  m_node_header.clear();
+  std::size_t n_node = 0;
+  const DAQNode* root = g_unpacker.get_root();
+  if (root) {
+    addNode(root, n_node++);
+    for (const auto& c : root->get_child_list())
+      if (c.second) addNode(c.second, n_node++);
+  }
+  m_node_id.resize(n_node);
+  m_node_name.resize(n_node);
+  return;
+}
+
+//_____________________________________________________________________________
+void
+EventSnapshot::addNode(const DAQNode* node, std::size_t i)
+{
+  const UnpackerManager& g_unpacker = GUnpacker::get_instance();
+  const int id = node->get_id();
+  // names only change with the DAQ topology
+  if (i>=m_node_id.size() || m_node_id[i]!=id) {
+    m_node_id.resize(i+1);
+    m_node_name.resize(i+1);
+    m_node_id[i]   = id;
+    m_node_name[i] = node->get_name();
+  }
+  for (const auto& h : g_node_header_id)
+    m_node_header.push_back(g_unpacker.get_node_header(id, h));
+  return;
+}
+
+//_____________________________________________________________________________
+EventSnapshot::value_type
+EventSnapshot::get(int device_id, int plane, int segment,
+		   int ch, int data_type, int index) const
+{
+  const int i = channelIndex(device_id, plane, segment, ch, data_type);
+  if (i<0) {
+    warnUnregistered(device_id, plane, segment, ch, data_type);
+    return 0;
+  }
+  if (index<0 || m_begin[i]+index>=m_begin[i+1])
+    return 0;
+  return m_value[m_begin[i]+index];
+}
+
+//_____________________________________________________________________________
+unsigned int
+EventSnapshot::get_entries(int device_id, int plane, int segment,
+			   int ch, int data_type) const
+{
+  const int i = channelIndex(device_id, plane, segment, ch, data_type);
+  if (i<0) {
+    warnUnregistered(device_id, plane, segment, ch, data_type);
+    return 0;
+  }
+  return m_begin[i+1] - m_begin[i];
+}
+
+//_____________________________________________________________________________
+// any worker, the first access only
+void
+EventSnapshot::warnUnregistered(int device_id, int plane, int segment,
+				int ch, int data_type)
+{
+  if (g_is_warned.exchange(true, std::memory_order_relaxed))
+    return;
+  std::cerr << "#W EventSnapshot unregistered slot, read as 0 :"
+	    << " device=" << device_id << " plane=" << plane
+	    << " segment=" << segment << " ch=" << ch
+	    << " data=" << data_type << std::endl;
+  return;
+}
+
+//_____________________________________________________________________________
+EventSnapshot::value_type
+EventSnapshot::get_node_header(int node_id, int header_id) const
+{
+  const std::size_t n_header = g_node_header_id.size();
+  for (std::size_t j=0; j<n_header; ++j) {
+    if (g_node_header_id[j]!=header_id)
+      continue;
+    for (std::size_t i=0, n=m_node_id.size(); i<n; ++i) {
+      if (m_node_id[i]==node_id)
+	return m_node_header[i*n_header + j];
+    }
+  }
+  return 0;
+}
+
+}
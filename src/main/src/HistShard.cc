@@ -0,0 +1,278 @@
+// -*- C++ -*-
+
+#include "HistShard.hh"
+
+#include <algorithm>
+
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <TH1.h>
+#include <TH2.h>
+#include <TProfile.h>
+#include <TThread.h>
+
+namespace analyzer
+{
+
+//_____________________________________________________________________________
+HistShard::HistShard(TH1* hist)
+  : m_hist(hist),
+    m_dim(hist->GetDimension()),
+    m_is_replay(false),
+    m_axis(),
+    m_buffer(),
+    m_front(0)
+{
+  m_is_replay = (m_dim>2 ||
+		 hist->InheritsFrom("TProfile") ||
+		 hist->InheritsFrom("TH2Poly"));
+
+  const int n_cell = m_is_replay ? 0 : hist->GetNcells();
+  const bool is_sumw2 = (hist->GetSumw2N()>0);
+  for (auto& b : m_buffer) {
+    b.w.assign(n_cell, 0.);
+    if (is_sumw2) b.w2.assign(n_cell, 0.);
+    clear(b);
+  }
+  if (!m_is_replay) {
+    for (int i=0; i<m_dim; ++i)
+      setAxis(i);
+  }
+}
+
+//_____________________________________________________________________________
+HistShard::~HistShard()
+{
+}
+
+//_____________________________________________________________________________
+void
+HistShard::add()
+{
+  Buffer& b = m_buffer[1-m_front];
+  if (b.is_empty)
+    return;
+
+  if (m_is_replay) {
+    replay(b);
+    return;
+  }
+
+  // statistics first, GetStats() may recompute them from the bin contents
+  Double_t stats[13] = {};
+  m_hist->GetStats(stats);
+  for (int i=0, n=(m_dim==1 ? 4 : 7); i<n; ++i)
+    stats[i] += b.stats[i];
+
+  TArrayD* sumw2 = m_hist->GetSumw2N()>0 ? m_hist->GetSumw2() : 0;
+  for (std::size_t i=0, n=b.w.size(); i<n; ++i) {
+    if (b.w[i]==0.) continue;
+    m_hist->AddBinContent(i, b.w[i]);
+    if (sumw2 && !b.w2.empty())
+      sumw2->fArray[i] += b.w2[i];
+  }
+  m_hist->PutStats(stats);
+  m_hist->SetEntries(m_hist->GetEntries() + b.entries);
+  clear(b);
+  return;
+}
+
+//_____________________________________________________________________________
+void
+HistShard::clear(Buffer& b)
+{
+  std::fill(b.w.begin(), b.w.end(), 0.);
+  std::fill(b.w2.begin(), b.w2.end(), 0.);
+  b.fill.clear();
+  std::fill(b.stats, b.stats+7, 0.);
+  b.entries  = 0.;
+  b.is_empty = true;
+  return;
+}
+
+//_____________________________________________________________________________
+// same convention as TAxis::FindFixBin()
+int
+HistShard::findBin(const Axis& axis, double x)
+{
+  if (x<axis.min)
+    return 0;
+  if (x>=axis.max)
+    return axis.n_bin+1;
+  if (axis.edges.empty())
+    return std::min(1 + static_cast<int>((x-axis.min)*axis.scale),
+		    axis.n_bin);
+  return std::upper_bound(axis.edges.begin(), axis.edges.end(), x)
+    - axis.edges.begin();
+}
+
+//_____________________________________________________________________________
+int
+HistShard::fill1(double x, double w)
+{
+  Buffer& b = m_buffer[m_front];
+  const int bin = findBin(m_axis[0], x);
+  b.w[bin] += w;
+  if (!b.w2.empty()) b.w2[bin] += w*w;
+  b.entries += 1.;
+  b.is_empty = false;
+  if (bin==0 || bin>m_axis[0].n_bin)
+    return -1;
+  b.stats[0] += w;
+  b.stats[1] += w*w;
+  b.stats[2] += w*x;
+  b.stats[3] += w*x*x;
+  return bin;
+}
+
+//_____________________________________________________________________________
+int
+HistShard::fill2(double x, double y, double w)
+{
+  Buffer& b = m_buffer[m_front];
+  const int bin_x = findBin(m_axis[0], x);
+  const int bin_y = findBin(m_axis[1], y);
+  const int bin   = bin_x + (m_axis[0].n_bin+2)*bin_y;
+  b.w[bin] += w;
+  if (!b.w2.empty()) b.w2[bin] += w*w;
+  b.entries += 1.;
+  b.is_empty = false;
+  if (bin_x==0 || bin_x>m_axis[0].n_bin ||
+      bin_y==0 || bin_y>m_axis[1].n_bin)
+    return -1;
+  b.stats[0] += w;
+  b.stats[1] += w*w;
+  b.stats[2] += w*x;
+  b.stats[3] += w*x*x;
+  b.stats[4] += w*y;
+  b.stats[5] += w*y*y;
+  b.stats[6] += w*x*y;
+  return bin;
+}
+
+//_____________________________________________________________________________
+int
+HistShard::record(int n_arg, double a, double b, double c)
+{
+  Buffer& buf = m_buffer[m_front];
+  buf.fill.push_back(n_arg);
+  buf.fill.push_back(a);
+  buf.fill.push_back(b);
+  buf.fill.push_back(c);
+  buf.is_empty = false;
+  if (buf.fill.size()>=4*k_max_replay) {
+    TThread::Lock();
+    replay(buf);
+    TThread::UnLock();
+  }
+  return -1;
+}
+
+//_____________________________________________________________________________
+// under TThread::Lock()
+void
+HistShard::replay(Buffer& b)
+{
+  for (std::size_t i=0, n=b.fill.size(); i<n; i+=4) {
+    const int     n_arg = static_cast<int>(b.fill[i]);
+    const double* a     = &b.fill[i+1];
+    if (n_arg==1) {
+      m_hist->Fill(a[0]);
+    } else if (n_arg==2) {
+      m_hist->Fill(a[0], a[1]);
+    } else if (TProfile* p = dynamic_cast<TProfile*>(m_hist)) {
+      p->Fill(a[0], a[1], a[2]);
+    } else if (TH2* h2 = dynamic_cast<TH2*>(m_hist)) {
+      h2->Fill(a[0], a[1], a[2]);
+    }
+  }
+  clear(b);
+  return;
+}
+
+//_____________________________________________________________________________
+void
+HistShard::setAxis(int i)
+{
+  const TAxis* axis = (i==0) ? m_hist->GetXaxis() : m_hist->GetYaxis();
+  Axis& a = m_axis[i];
+  a.n_bin = axis->GetNbins();
+  a.min   = axis->GetXmin();
+  a.max   = axis->GetXmax();
+  a.scale = a.n_bin/(a.max-a.min);
+  const TArrayD* xbins = axis->GetXbins();
+  if (xbins->GetSize()>0)
+    a.edges.assign(xbins->GetArray(), xbins->GetArray()+xbins->GetSize());
+  return;
+}
+
+//_____________________________________________________________________________
+void
+HistShard::swap()
+{
+  m_front = 1-m_front;
+  return;
+}
+
+//_____________________________________________________________________________
+HistShardSet::HistShardSet(const std::vector<TH1*>& hist)
+  : m_shard(hist.size(), 0),
+    m_state(kRequested)
+{
+  for (std::size_t i=0, n=hist.size(); i<n; ++i) {
+    if (hist[i])
+      m_shard[i] = new HistShard(hist[i]);
+  }
+}
+
+//_____________________________________________________________________________
+HistShardSet::~HistShardSet()
+{
+  for (auto& s : m_shard) {
+    delete s;
+    s = 0;
+  }
+}
+
+//_____________________________________________________________________________
+// filling thread, between two events
+bool
+HistShardSet::flip()
+{
+  if (m_state.load(std::memory_order_acquire)!=kRequested)
+    return false;
+  for (auto& s : m_shard)
+    if (s) s->swap();
+  m_state.store(kReady, std::memory_order_release);
+  return true;
+}
+
+//_____________________________________________________________________________
+// only when the filling thread has stopped
+void
+HistShardSet::flush()
+{
+  merge();
+  for (auto& s : m_shard) {
+    if (!s) continue;
+    s->swap();
+    s->add();
+  }
+  m_state.store(kRequested, std::memory_order_release);
+  return;
+}
+
+//_____________________________________________________________________________
+// any thread, under TThread::Lock()
+void
+HistShardSet::merge()
+{
+  if (m_state.load(std::memory_order_acquire)!=kReady)
+    return;
+  for (auto& s : m_shard)
+    if (s) s->add();
+  m_state.store(kRequested, std::memory_order_release);
+  return;
+}
+
+}
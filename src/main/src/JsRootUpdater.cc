@@ -4,16 +4,22 @@
 
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 #include <map>
 #include <set>
 #include <string>
 #include <exception>
 #include <stdexcept>
 
+#include <TH1.h>
+#include <THttpServer.h>
 #include <TROOT.h>
 #include <TThread.h>
 #include <TSystem.h>
 
+#include "DebugStageTimer.hh"
+#include "Main.hh"
+
 ClassImp(analyzer::JsRootUpdater)
 
 namespace analyzer
@@ -27,12 +33,39 @@ namespace analyzer
       JsRootUpdater::getInstance().run();
       return;
     }
+
+    //_______________________________________________________________________
+    void
+    copy_hist(const std::vector<TH1*>& from, std::vector<TH1*>& to)
+    {
+      for (std::size_t i=0, n=from.size(); i<n; ++i) {
+	if (!from[i])
+	  continue;
+	to[i]->Reset("ICES");
+	to[i]->Add(from[i]);
+      }
+      return;
+    }
   }
 
   //___________________________________________________________________________
   JsRootUpdater::JsRootUpdater()
     : m_thread(0),
-      m_during_update(false)
+      m_during_update(false),
+      m_server(0),
+      m_interval(1.),
+      m_tick(0.02),
+      m_front(),
+      m_back(),
+      m_fill(),
+      m_task(),
+      m_mutex(),
+      m_cond(),
+      m_is_requested(false),
+      m_is_reset(false),
+      m_is_synced(false),
+      m_is_released(false),
+      m_is_end(false)
   {
   }
 
@@ -41,6 +74,31 @@ namespace analyzer
   {
   }
 
+  //___________________________________________________________________________
+  // Waits at most timeout seconds for the event loop to be parked in sync().
+  bool
+  JsRootUpdater::acquire(double timeout)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_is_synced   = false;
+    m_is_released = false;
+    m_is_requested.store(true, std::memory_order_release);
+    m_cond.wait_for(lock, std::chrono::duration<double>(timeout),
+		    [this]{ return m_is_synced || m_is_end; });
+    if (!m_is_synced)
+      m_is_requested.store(false, std::memory_order_relaxed);
+    return m_is_synced;
+  }
+
+  //___________________________________________________________________________
+  void
+  JsRootUpdater::addTask(publish_task task)
+  {
+    if (task)
+      m_task.push_back(task);
+    return;
+  }
+
   //___________________________________________________________________________
   bool
   JsRootUpdater::isUpdating()
@@ -68,27 +126,140 @@ namespace analyzer
     return;
   }
 
+  //___________________________________________________________________________
+  void
+  JsRootUpdater::release()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_is_released = true;
+    }
+    m_cond.notify_all();
+    return;
+  }
+
+  //___________________________________________________________________________
+  void
+  JsRootUpdater::request()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_is_synced)
+      m_is_requested.store(true, std::memory_order_release);
+    return;
+  }
+
+  //___________________________________________________________________________
+  // The registered histograms are reset from an HTTP command, the filled
+  // ones follow at the next snapshot.
+  void
+  JsRootUpdater::requestReset()
+  {
+    m_is_reset = true;
+    return;
+  }
+
   //___________________________________________________________________________
   int
   JsRootUpdater::run()
   {
+    typedef std::chrono::steady_clock Clock;
+    const bool is_buffered = !m_fill.empty();
+    Clock::time_point next = Clock::now();
     while(true){
-      TThread::Lock();
-      gSystem->ProcessEvents();
-      TThread::UnLock();
-      gSystem->Sleep(200);
+      {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cond.wait_for(lock, std::chrono::duration<double>(m_tick),
+			[this]{ return m_is_end; });
+	if (m_is_end)
+	  break;
+      }
+      // the event loop is parked while the objects are read. When it
+      // does not come to sync() (idle, between runs, waiting for data)
+      // nothing is filled, and the requests are still answered.
+      const bool is_parked = !is_buffered && acquire(m_interval);
+
+      debug::StageTimer timer(debug::kPublish);
+      const Clock::time_point now = Clock::now();
+      const bool is_due = (now >= next);
+
+      if (is_buffered) {
+	if (is_due) {
+	  request();
+	  next = now + std::chrono::duration_cast<Clock::duration>
+	    (std::chrono::duration<double>(m_interval));
+	}
+	if (swap()) {
+	  Main::getInstance().mergeHistograms();
+	  for (const auto& task : m_task)
+	    task();
+	}
+      } else if (is_parked && is_due) {
+	Main::getInstance().mergeHistograms();
+	for (const auto& task : m_task)
+	  task();
+	next = now + std::chrono::duration_cast<Clock::duration>
+	  (std::chrono::duration<double>(m_interval));
+      }
+
+      if (m_server)
+	m_server->ProcessRequests();
+
+      if (is_parked)
+	release();
       // std::cout << "#D JsRootUpdater is running" << std::endl;
     }
     std::cout << "#D JsRootUpdater exited loop" << std::endl;
     return 0;
   }
 
+  //___________________________________________________________________________
+  // Redirects the fills of hist to private copies, the registered objects
+  // become the published ones. Called in process_begin().
+  void
+  JsRootUpdater::setHistBuffer(std::vector<TH1*>& hist)
+  {
+    const std::size_t n = hist.size();
+    m_front = hist;
+    m_back.assign(n, 0);
+    m_fill.assign(n, 0);
+    for (std::size_t i=0; i<n; ++i) {
+      if (!hist[i])
+	continue;
+      m_back[i] = dynamic_cast<TH1*>(hist[i]->Clone());
+      m_back[i]->SetDirectory(0);
+      m_fill[i] = dynamic_cast<TH1*>(hist[i]->Clone());
+      m_fill[i]->SetDirectory(0);
+      hist[i] = m_fill[i];
+    }
+    return;
+  }
+
+  //___________________________________________________________________________
+  void
+  JsRootUpdater::setInterval(double interval)
+  {
+    m_interval = (interval>m_tick) ? interval : m_tick;
+    return;
+  }
+
+  //___________________________________________________________________________
+  void
+  JsRootUpdater::setServer(THttpServer* server)
+  {
+    m_server = server;
+    return;
+  }
+
   //___________________________________________________________________________
   void
   JsRootUpdater::start()
   {
     TThread::Lock();
     if (!m_thread) {
+      // requests are processed by this thread instead of the timer
+      // in gSystem->ProcessEvents()
+      if (m_server)
+	m_server->SetTimer(0, kTRUE);
       m_thread = new TThread("JsRootUpdaterThread",
 			     &thread_function,
 			     reinterpret_cast<void*>(0U));
@@ -98,6 +269,56 @@ namespace analyzer
     return;
   }
 
+  //___________________________________________________________________________
+  void
+  JsRootUpdater::stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_is_end = true;
+    }
+    m_cond.notify_all();
+    return;
+  }
+
+  //___________________________________________________________________________
+  // Copies the last snapshot into the published histograms, only in the
+  // publisher thread.
+  bool
+  JsRootUpdater::swap()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_is_synced)
+      return false;
+    copy_hist(m_back, m_front);
+    m_is_synced = false;
+    return true;
+  }
+
+  //___________________________________________________________________________
+  // Called by the event loop between two events.
+  void
+  JsRootUpdater::sync()
+  {
+    if (!m_is_requested.load(std::memory_order_acquire))
+      return;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_is_requested.load(std::memory_order_relaxed))
+      return;
+    m_is_requested.store(false, std::memory_order_relaxed);
+    debug::StageTimer timer(debug::kSnapshot);
+    if (m_is_reset.exchange(false)) {
+      for (auto h : m_fill)
+	if (h) h->Reset();
+    }
+    copy_hist(m_fill, m_back);
+    m_is_synced = true;
+    m_cond.notify_all();
+    if (m_fill.empty())
+      m_cond.wait(lock, [this]{ return m_is_released || m_is_end; });
+    return;
+  }
+
   //___________________________________________________________________________
   void
   JsRootUpdater::unlock()
@@ -4,8 +4,10 @@
 
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <iterator>
+#include <cstdlib>
 #include <ctime>
 #include <sys/time.h>
 
@@ -16,6 +18,9 @@
 #include <std_ostream.hh>
 #include <UnpackerManager.hh>
 
+#include "DebugStageTimer.hh"
+#include "EventPipeline.hh"
+#include "JsRootUpdater.hh"
 #include "user_analyzer.hh"
 //#include "DebugCounter.hh"
 
@@ -34,6 +39,15 @@ namespace analyzer
       Main::getInstance().run();
       return;
     }
+
+    //_________________________________________________________________________
+    inline void
+    next_event(UnpackerManager& g_unpacker)
+    {
+      debug::StageTimer timer(debug::kUnpack);
+      ++g_unpacker;
+      return;
+    }
   }
 //_____________________________________________________________________________
 Main&
@@ -46,12 +60,23 @@ Main::getInstance()
 //_____________________________________________________________________________
 Main::Main()
   : m_state(k_idle),
+    m_state_mutex(),
+    m_state_cond(),
     m_argv(),
     m_thread(0),
     m_count(0),
     m_is_overwrite(false),
     m_is_batch(false),
-    m_is_jsroot(false)
+    m_is_jsroot(false),
+    m_n_worker(1),
+    m_queue_policy(EventPipeline::kBlock),
+    m_n_sample(1),
+    m_cpu_budget(-1.),
+    m_latency_budget(-1.),
+    m_selector(0),
+    m_processor(0),
+    m_hist(0),
+    m_pipeline(0)
 {
 }
 
@@ -85,6 +110,20 @@ Main::getCounter() const
   return m_count;
 }
 
+//_____________________________________________________________________________
+int
+Main::getNWorker() const
+{
+  return m_n_worker;
+}
+
+//_____________________________________________________________________________
+Main::e_state
+Main::getState() const
+{
+  return static_cast<e_state>(m_state.load());
+}
+
 //_____________________________________________________________________________
 // void
 // Main::initialize(int argc,
@@ -114,7 +153,33 @@ Main::initialize(const std::vector<std::string>& argV)
 //   std::copy(argV.begin(), argV.end(),
 // 	    std::ostream_iterator<std::string>(std::cout, " " ));
 //   std::cout << std::endl;
-  m_argv = argV;
+  m_argv.clear();
+  static const std::string worker_opt("--worker=");
+  static const std::string jsroot_opt("--jsroot-interval=");
+  static const std::string drop_opt("--drop-oldest");
+  static const std::string sample_opt("--sample=");
+  static const std::string cpu_opt("--cpu-budget=");
+  static const std::string latency_opt("--latency-budget=");
+  for (const auto& v : argV) {
+    if (v.find(worker_opt)==0)
+      setNWorker(std::atoi(v.substr(worker_opt.size()).c_str()));
+    else if (v==drop_opt)
+      setQueuePolicy(EventPipeline::kDropOldest);
+    else if (v==sample_opt+"auto")
+      setQueuePolicy(EventPipeline::kAdaptive);
+    else if (v.find(sample_opt)==0)
+      setQueuePolicy(EventPipeline::kSample,
+		     std::atoi(v.substr(sample_opt.size()).c_str()));
+    else if (v.find(cpu_opt)==0)
+      setSamplingBudget(std::atof(v.substr(cpu_opt.size()).c_str()), -1.);
+    else if (v.find(latency_opt)==0)
+      setSamplingBudget(-1., std::atof(v.substr(latency_opt.size()).c_str()));
+    else if (v.find(jsroot_opt)==0)
+      JsRootUpdater::getInstance()
+	.setInterval(std::atof(v.substr(jsroot_opt.size()).c_str()));
+    else
+      m_argv.push_back(v);
+  }
   m_count = 0;
   int ret = process_begin(m_argv);
   if (ret != 0) {
@@ -130,6 +195,18 @@ Main::initialize(const std::vector<std::string>& argV)
       break;
     }
   }
+  if (m_processor) {
+    std::cout << "#D Main::initialize() " << m_n_worker
+	      << " event workers" << std::endl;
+    m_pipeline = new EventPipeline(m_n_worker, m_processor, *m_hist);
+    m_pipeline->setPolicy(static_cast<EventPipeline::EPolicy>(m_queue_policy),
+			  m_n_sample);
+    m_pipeline->setBudget(m_cpu_budget, m_latency_budget);
+    m_pipeline->setSelector(m_selector);
+  } else if (m_n_worker>1) {
+    std::cout << "#W Main::initialize() no event processor is registered,"
+	      << " --worker is ignored" << std::endl;
+  }
   return;
 }
 
@@ -192,11 +269,38 @@ Main::get_dtime()
   return ((double)(tv.tv_sec)+(double)(tv.tv_usec)*0.001*0.001);
 }
 
+//_____________________________________________________________________________
+void
+Main::mergeHistograms()
+{
+  if (m_pipeline)
+    m_pipeline->merge();
+  return;
+}
+
+//_____________________________________________________________________________
+int
+Main::processEvent()
+{
+  int ret = 0;
+  if (m_pipeline) {
+    ret = m_pipeline->push();
+  } else {
+    debug::StageTimer timer(debug::kEvent);
+    ret = process_event();
+  }
+  // hand a snapshot to the JSROOT publisher if it asks for one
+  JsRootUpdater::getInstance().sync();
+  return ret;
+}
+
 //_____________________________________________________________________________
 int
 Main::run()
 {
   UnpackerManager& g_unpacker = GUnpacker::get_instance();
+  if (m_pipeline)
+    m_pipeline->start();
 //   if (g_unpacker.is_online())
   if (!m_is_batch)
     {
@@ -207,7 +311,7 @@ Main::run()
 	  //	  d3_last = 0;
 	  //	  double d4 = 0;
 	  //	  int nevt=0;
-	  for (;!g_unpacker.eof();++g_unpacker, ++m_count)
+	  for (;!g_unpacker.eof();next_event(g_unpacker), ++m_count)
 	    {
 	      //	      double d0_last = get_dtime();
 	      //	      if(nevt!=0)
@@ -219,20 +323,13 @@ Main::run()
 		break;
 
 	      if (isIdle())
-		{
-		  for(;;)
-		    {
-		      if (!isIdle())
-			break;
-		      continue;
-		    }
-		}
+		waitWhile(k_idle);
 
 	      if (isRunning())
 		{
 		  // TThread::Lock();
 		  //debug::ObjectCounter::Check();
-		  int ret = process_event();
+		  int ret = processEvent();
 		  if( ret!=0 ){
 		    std::cout << "#D1 analyzer::process_event() return " << ret << std::endl;
 		    break;
@@ -269,9 +366,9 @@ Main::run()
   else
     {
       g_unpacker.initialize();
-      for ( ; !g_unpacker.eof(); ++g_unpacker ){
+      for ( ; !g_unpacker.eof(); next_event(g_unpacker) ){
 	//debug::ObjectCounter::Check();
-	int ret = process_event();
+	int ret = processEvent();
 	if( ret!=0 ){
 	  std::cout << "#D2 analyzer::process_event() return " << ret << std::endl;
 	  break;
@@ -279,7 +376,12 @@ Main::run()
       }
       std::cout << "#D2 Main::run() exit loop"  << std::endl;
     }
+  if (m_pipeline)
+    m_pipeline->finish();
   process_end();
+#ifdef ProfileStage
+  debug::StageProfile::print("at process_end()");
+#endif
 
   std::cout << "#D Main::run() after process_end()"  << std::endl;
   return 0;
@@ -293,6 +395,26 @@ Main::setBatchMode(bool flag)
   return;
 }
 
+//_____________________________________________________________________________
+void
+Main::setEventProcessor(event_processor processor,
+			std::vector<TH1*>& hist)
+{
+  m_processor = processor;
+  m_hist      = &hist;
+  return;
+}
+
+//_____________________________________________________________________________
+// Events the sampling of the event pipeline must keep, see
+// event_selector. Called in process_begin().
+void
+Main::setEventSelector(event_selector selector)
+{
+  m_selector = selector;
+  return;
+}
+
 //_____________________________________________________________________________
 void
 Main::setForceOverwrite(bool flag)
@@ -301,6 +423,54 @@ Main::setForceOverwrite(bool flag)
   return;
 }
 
+//_____________________________________________________________________________
+void
+Main::setNWorker(int n)
+{
+  m_n_worker = (n>1) ? n : 1;
+  return;
+}
+
+//_____________________________________________________________________________
+// What the event pipeline does when the workers can't keep up, see
+// EventPipeline::EPolicy. Called before or in process_begin().
+void
+Main::setQueuePolicy(int policy, int n_sample)
+{
+  if (policy<0 || policy>=EventPipeline::kNPolicy) {
+    std::cout << "#W Main::setQueuePolicy() unknown policy : "
+	      << policy << std::endl;
+    return;
+  }
+  m_queue_policy = policy;
+  m_n_sample     = (n_sample>1) ? n_sample : 1;
+  return;
+}
+
+//_____________________________________________________________________________
+// Budget of the kAdaptive policy: fraction of the worker time and seconds
+// an event may wait, negative values keep the defaults of
+// SamplingController.
+void
+Main::setSamplingBudget(double cpu, double latency)
+{
+  if (cpu>0.)     m_cpu_budget     = cpu;
+  if (latency>0.) m_latency_budget = latency;
+  return;
+}
+
+//_____________________________________________________________________________
+void
+Main::setState(e_state state)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_state_mutex);
+    m_state = state;
+  }
+  m_state_cond.notify_all();
+  return;
+}
+
 //_____________________________________________________________________________
 void
 Main::start()
@@ -313,7 +483,7 @@ Main::start()
       m_thread->Run();
     }
 
-  m_state = k_running;
+  setState(k_running);
 
   return;
 }
@@ -335,6 +505,9 @@ Main::stat()
 	      << optstat << std::endl;
   gStyle->SetOptStat( optstat );
 
+  if (m_pipeline)
+    m_pipeline->printStatistics();
+
   // UnpackerManager& g_unpacker = GUnpacker::get_instance();
   // std::cout << "#D " << g_unpacker.get_counter()
   // 	    << " events unpacked" << std::endl;
@@ -349,7 +522,7 @@ Main::stat()
 void
 Main::stop()
 {
-  m_state = k_zombie;
+  setState(k_zombie);
   return;
 }
 
@@ -357,8 +530,24 @@ Main::stop()
 void
 Main::suspend()
 {
-  m_state = k_idle;
+  setState(k_idle);
   return;
 }
 
+//_____________________________________________________________________________
+// Blocks the caller while the state stays as given, at most timeout
+// seconds if timeout is not negative, and returns the state on return.
+Main::e_state
+Main::waitWhile(e_state state, double timeout) const
+{
+  std::unique_lock<std::mutex> lock(m_state_mutex);
+  auto changed = [this, state]{ return m_state.load()!=state; };
+  if (timeout<0)
+    m_state_cond.wait(lock, changed);
+  else
+    m_state_cond.wait_for(lock, std::chrono::duration<double>(timeout),
+			  changed);
+  return static_cast<e_state>(m_state.load());
+}
+
 }
@@ -0,0 +1,81 @@
+// -*- C++ -*-
+
+#include "SamplingController.hh"
+
+#include <algorithm>
+
+namespace analyzer
+{
+  namespace
+  {
+    // seconds between two updates of the fraction
+    const double k_period       = 0.5;
+    const double k_min_fraction = 1.e-3;
+    // weight of the new estimate, damps the oscillation between a full
+    // and an empty queue
+    const double k_smoothing    = 0.5;
+  }
+
+//_____________________________________________________________________________
+SamplingController::SamplingController()
+  : m_cpu(0.8),
+    m_latency(1.),
+    m_fraction(1.),
+    m_credit(0.),
+    m_cost(0.),
+    m_time(Clock::now()),
+    m_n_read(0),
+    m_n_processed(0),
+    m_busy(0.)
+{
+}
+
+//_____________________________________________________________________________
+SamplingController::~SamplingController()
+{
+}
+
+//_____________________________________________________________________________
+void
+SamplingController::setBudget(double cpu, double latency)
+{
+  if (cpu>0.)     m_cpu     = std::min(cpu, 1.);
+  if (latency>0.) m_latency = latency;
+  return;
+}
+
+//_____________________________________________________________________________
+// Returns true if the fraction was updated.
+bool
+SamplingController::update(long long n_read, long long n_processed,
+			   double busy, int depth, int n_worker)
+{
+  const Clock::time_point now = Clock::now();
+  const double dt = std::chrono::duration<double>(now-m_time).count();
+  if (dt<k_period)
+    return false;
+
+  const long long d_read      = n_read-m_n_read;
+  const long long d_processed = n_processed-m_n_processed;
+  if (d_processed>0)
+    m_cost = (busy-m_busy)/d_processed;
+  m_time        = now;
+  m_n_read      = n_read;
+  m_n_processed = n_processed;
+  m_busy        = busy;
+  if (m_cost<=0. || d_read<=0 || n_worker<=0)
+    return false;
+
+  // events per second the workers may take
+  const double capacity = m_cpu*n_worker/m_cost;
+  double target = capacity/(d_read/dt);
+  // what is already queued is late, drain it first
+  const double wait = depth*m_cost/n_worker;
+  if (wait>m_latency)
+    target *= m_latency/wait;
+  target = std::max(k_min_fraction, std::min(1., target));
+  m_fraction += k_smoothing*(target-m_fraction);
+  return true;
+}
+
+}
@@ -26,6 +26,7 @@
 #include "Main.hh"
 #include "lexical_cast.hh"
 #include "Controller.hh"
+#include "DebugStageTimer.hh"
 
 ClassImp(hddaq::gui::Updater)
 
@@ -318,36 +319,32 @@ Updater::run()
   Main& g_main = Main::getInstance();
   for (;;)
     {
-      if (g_main.isZombie())
+      const Main::e_state main_state = g_main.getState();
+      if (main_state==Main::k_zombie)
 	{
 // 	  std::cout << "#D Updater detects end of main" << std::endl;
 	  m_state = k_zombie;
 	  break;
 	}
-      if (g_main.isIdle())
+      if (main_state==Main::k_idle)
 	{
 // 	  std::cout << "#D Updater detects idling of Main" << std::endl;
 	  m_state = k_idle;
-	  ::usleep(1);
+	  g_main.waitWhile(Main::k_idle);
+	  continue;
 	}
 
-      if (g_main.isRunning())
-	{
 // 	  std::cout << "#D Updater detects running of Main" << std::endl;
-	  m_state = k_running;
-	}
+      m_state = k_running;
 
-      if (isRunning())
-	{
 // 	  if (loop%100==0)
 // 	    std::cout << "#D Updater::run() loop = " << loop << std::endl;
 // 	  ++loop;
 
-	  if (wait()<0)
-	    continue;
+      if (wait()<0)
+	continue;
 
-	  update();
-	}
+      update();
     }
   std::cout << "#D Updater exited loop" << std::endl;
   return 0;
@@ -438,6 +435,10 @@ Updater::update()
 {
   if(this->isUpdating()){return;}
   this->setUpdating(true);
+  debug::StageTimer timer(debug::kUpdate);
+
+  // fold the worker histograms into the drawn ones
+  Main::getInstance().mergeHistograms();
 
   TColor* c = gROOT->GetColor(kRed);
   Controller& g_controller = Controller::getInstance();
@@ -491,9 +492,14 @@ Updater::wait()
 // 		<< " seconds" << std::endl;
       if (m_refresh_interval>=0)
 	{
-	  ::usleep(static_cast<unsigned int>
-		   (m_refresh_interval * 1.0e6));
-	  ret = 0;
+	  // woken up at once by Suspend/Stop, then the loop in run()
+	  // follows the new state without a last update
+	  if (Main::getInstance().waitWhile(Main::k_running,
+					    m_refresh_interval)
+	      ==Main::k_running)
+	    ret = 0;
+	  else
+	    ret = -1;
 	  break;
 	}
       }
@@ -506,7 +512,11 @@ Updater::wait()
 	  if (0==(Main::getInstance().getCounter() & n_events))
 	    ret = 0;
 	  else
-	    ret = -1;
+	    {
+	      // polls the event counter without holding a core
+	      Main::getInstance().waitWhile(Main::k_running, 1.0e-3);
+	      ret = -1;
+	    }
 	  break;
 	}
       }
@@ -520,7 +530,7 @@ Updater::wait()
       }
     default:
       {
-	::sleep(1);
+	Main::getInstance().waitWhile(Main::k_running, 1.);
 	ret = -1;
 	break;
       }
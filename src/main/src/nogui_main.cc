@@ -26,13 +26,16 @@ int main(int argc, char* argv[])
   Sigwait& g_sigwait = Sigwait::getInstance();
   g_sigwait.run();
 
-//  if (g_main.isJsRoot()) {
-//    JsRootUpdater& g_jsroot = JsRootUpdater::getInstance();
-//    g_jsroot.start();
-//  }
+  JsRootUpdater& g_jsroot = JsRootUpdater::getInstance();
+  if (g_main.isJsRoot())
+    g_jsroot.start();
 
   g_main.setBatchMode(true);
   g_main.run();
+  if (g_main.isJsRoot()) {
+    g_jsroot.stop();
+    g_jsroot.join();
+  }
   closeTFile();
   g_sigwait.kill();
   return 0;